@@ -5,6 +5,9 @@
 /// \author Nicolas Asanov
 /// \date December 1, 2025
 ///
+/// The OpenViBE side of the comparison is measured on the real box by the openvibe-onnx-benchmark
+/// developer tool, which replays a scenario headless and reports the same latency summary.
+///
 /// Compile with:
 /// g++ -std=c++17 -O3 standalone_onnx_benchmark.cpp -o standalone_onnx_benchmark \
 ///     -I/path/to/onnxruntime/include \
@@ -27,7 +30,8 @@ class StandaloneOnnxClassifier
 {
 public:
   StandaloneOnnxClassifier(const std::string &modelPath)
-      : m_onnxEnv(ORT_LOGGING_LEVEL_WARNING, "StandaloneClassifier")
+      : m_onnxEnv(ORT_LOGGING_LEVEL_WARNING, "StandaloneClassifier"),
+        m_memoryInfo(Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault))
   {
 
     // Configure session options
@@ -45,6 +49,11 @@ public:
                        .GetTensorTypeAndShapeInfo()
                        .GetShape();
 
+    // Input/output names are queried once, as the OpenViBE box does
+    Ort::AllocatorWithDefaultOptions allocator;
+    m_inputName = m_onnxSession->GetInputNameAllocated(0, allocator).get();
+    m_outputName = m_onnxSession->GetOutputNameAllocated(0, allocator).get();
+
     // Get output shape to determine number of classes
     m_numClasses = m_onnxSession->GetOutputTypeInfo(0)
                        .GetTensorTypeAndShapeInfo()
@@ -63,24 +72,15 @@ public:
 
   int classify(const std::vector<float> &inputBuffer)
   {
-    Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(
-        OrtAllocatorType::OrtArenaAllocator,
-        OrtMemType::OrtMemTypeDefault);
-
     Ort::Value inputTensor = Ort::Value::CreateTensor<float>(
-        memoryInfo,
+        m_memoryInfo,
         const_cast<float *>(inputBuffer.data()),
         inputBuffer.size(),
         m_inputShape.data(),
         m_inputShape.size());
 
-    // Get input/output names
-    Ort::AllocatorWithDefaultOptions allocator;
-    auto inputName = m_onnxSession->GetInputNameAllocated(0, allocator);
-    auto outputName = m_onnxSession->GetOutputNameAllocated(0, allocator);
-
-    const char *inputNames[] = {inputName.get()};
-    const char *outputNames[] = {outputName.get()};
+    const char *inputNames[] = {m_inputName.c_str()};
+    const char *outputNames[] = {m_outputName.c_str()};
 
     // Run inference
     auto outputTensors = m_onnxSession->Run(
@@ -124,6 +124,9 @@ private:
   Ort::Env m_onnxEnv;
   std::unique_ptr<Ort::Session> m_onnxSession;
   Ort::SessionOptions m_sessionOptions;
+  Ort::MemoryInfo m_memoryInfo;
+  std::string m_inputName;
+  std::string m_outputName;
   std::vector<int64_t> m_inputShape;
   size_t m_numClasses;
 };
@@ -0,0 +1,266 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file main.cpp
+/// \brief Headless benchmark of the ONNX Classifier box.
+///
+/// Plays a scenario (typically a CSV or .ov reader feeding an ONNX Classifier box) in fast forward,
+/// without any GUI, and reports the throughput and the per chunk latency percentiles measured by the
+/// box itself. The classification runs through the real box, so the comparison with a standalone
+/// ONNX Runtime program measures the framework overhead rather than two implementations.
+///
+///-------------------------------------------------------------------------------------------------
+
+#include <openvibe/ov_all.h>
+#include <toolkit/ovtk_all.h>
+#include <system/ovCTime.h>
+
+#include "ovpCLatencyHistogram.hpp"
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Same identifier as Box_OnnxClassifier in the classification plugin
+const OpenViBE::CIdentifier ONNX_CLASSIFIER_ID(0x855634c3, 0xa7ed9f52);
+const char* LATENCY_CSV_SETTING = "Latency CSV File";
+
+constexpr size_t PHASE_COUNT          = 6;
+const char* PHASE_NAMES[PHASE_COUNT]  = { "Decode", "Convert", "Run", "Argmax", "Encode", "Total" };
+const double PERCENTILES[]            = { 50.0, 95.0, 99.0, 100.0 };
+const char* PERCENTILE_NAMES[]        = { "p50", "p95", "p99", "max" };
+
+using latency_histograms_t = std::array<OpenViBE::Plugins::Classification::CLatencyHistogram, PHASE_COUNT>;
+
+typedef struct SConfiguration
+{
+	std::string scenarioFile;
+	size_t nTrial = 1;
+	std::vector<std::pair<std::string, std::string>> settings;	// Applied to every ONNX Classifier box, by setting name
+	std::vector<std::pair<std::string, std::string>> tokens;	// Scenario configuration tokens, e.g. the file to replay
+} configuration_t;
+
+void printUsage(const char* program)
+{
+	std::cout << "Usage: " << program << " --scenario <file> [--trials <n>] [--set <setting>=<value>]... [--define <token>=<value>]...\n\n"
+			<< "  --scenario  Scenario with at least one ONNX Classifier box, played in fast forward\n"
+			<< "  --trials    Number of times the scenario is played [default=1]\n"
+			<< "  --set       Overrides a setting of every ONNX Classifier box, e.g. --set \"Batch Pending Chunks=true\"\n"
+			<< "  --define    Scenario configuration token, e.g. --define \"<token>=data.csv\" to replay another file with a scenario reading ${<token>}\n";
+}
+
+bool splitPair(const std::string& arg, std::pair<std::string, std::string>& pair)
+{
+	const size_t pos = arg.find('=');
+	if (pos == std::string::npos || pos == 0) { return false; }
+	pair = { arg.substr(0, pos), arg.substr(pos + 1) };
+	return true;
+}
+
+bool parseArguments(const int argc, char** argv, configuration_t& config)
+{
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		if (arg == "-h" || arg == "--help") { return false; }
+		if (i + 1 >= argc) {
+			std::cerr << "ERROR: Missing value for option " << arg << std::endl;
+			return false;
+		}
+
+		const std::string value = argv[++i];
+		std::pair<std::string, std::string> pair;
+		if (arg == "--scenario") { config.scenarioFile = value; }
+		else if (arg == "--trials") { config.nTrial = std::stoul(value); }
+		else if (arg == "--set" && splitPair(value, pair)) { config.settings.push_back(pair); }
+		else if (arg == "--define" && splitPair(value, pair)) { config.tokens.push_back(pair); }
+		else {
+			std::cerr << "ERROR: Invalid option " << arg << " " << value << std::endl;
+			return false;
+		}
+	}
+	return !config.scenarioFile.empty() && config.nTrial > 0;
+}
+
+/// <summary> Points every ONNX Classifier box of the scenario to its own latency file and applies the setting overrides. </summary>
+std::vector<std::string> setupOnnxBoxes(OpenViBE::Kernel::IScenario& scenario, const configuration_t& config, const size_t trial)
+{
+	std::vector<std::string> latencyFiles;
+
+	OpenViBE::CIdentifier* boxIDs = nullptr;
+	size_t nBox                   = 0;
+	scenario.getBoxIdentifierList(&boxIDs, &nBox);
+	for (size_t i = 0; i < nBox; ++i) {
+		OpenViBE::Kernel::IBox* box = scenario.getBoxDetails(boxIDs[i]);
+		if (box->getAlgorithmClassIdentifier() != ONNX_CLASSIFIER_ID) { continue; }
+
+		const std::string latencyFile = (std::filesystem::temp_directory_path()
+										 / ("onnx-benchmark-" + std::to_string(trial) + "-" + std::to_string(latencyFiles.size()) + ".csv")).string();
+		for (size_t j = 0; j < box->getSettingCount(); ++j) {
+			OpenViBE::CString name;
+			box->getSettingName(j, name);
+			if (name == OpenViBE::CString(LATENCY_CSV_SETTING)) { box->setSettingValue(j, latencyFile.c_str()); }
+			for (const auto& setting : config.settings) { if (name == OpenViBE::CString(setting.first.c_str())) { box->setSettingValue(j, setting.second.c_str()); } }
+		}
+		latencyFiles.push_back(latencyFile);
+	}
+	scenario.releaseIdentifierList(boxIDs);
+
+	return latencyFiles;
+}
+
+/// <summary> Adds the chunks of a latency file written by the box to the histograms, returns the number of chunks. </summary>
+size_t readLatencyFile(const std::string& file, latency_histograms_t& histograms)
+{
+	std::ifstream stream(file);
+	std::string line;
+	std::getline(stream, line);	// Header
+
+	size_t nChunk = 0;
+	while (std::getline(stream, line)) {
+		std::stringstream ss(line);
+		std::string value;
+		std::getline(ss, value, ',');	// End time of the chunk
+		for (auto& histogram : histograms) {
+			if (!std::getline(ss, value, ',')) { break; }
+			histogram.record(std::stod(value));
+		}
+		nChunk++;
+	}
+	return nChunk;
+}
+
+/// <summary> Plays the scenario once in fast forward, as fast as possible. </summary>
+bool playScenario(OpenViBE::Kernel::IKernelContext& ctx, const OpenViBE::CIdentifier& scenarioID, const configuration_t& config, double& duration)
+{
+	auto& playerManager = ctx.getPlayerManager();
+	OpenViBE::CIdentifier playerID;
+	if (!playerManager.createPlayer(playerID)) {
+		std::cerr << "ERROR: Impossible to create player" << std::endl;
+		return false;
+	}
+	OpenViBE::Kernel::IPlayer& player = playerManager.getPlayer(playerID);
+
+	OpenViBE::CNameValuePairList tokens;
+	for (const auto& token : config.tokens) { tokens.setValue(token.first, token.second); }
+
+	bool res = player.setScenario(scenarioID, &tokens) && player.initialize() == OpenViBE::Kernel::EPlayerReturnCodes::Success;
+	if (res) {
+		player.setFastForwardMaximumFactor(0);
+		player.forward();
+
+		const auto startTime  = std::chrono::steady_clock::now();
+		uint64_t lastLoopTime = System::Time::zgetTime();
+		while (res && player.getStatus() != OpenViBE::Kernel::EPlayerStatus::Stop) {
+			const uint64_t currentTime = System::Time::zgetTime();
+			res                        = player.loop(currentTime - lastLoopTime);
+			lastLoopTime               = currentTime;
+		}
+		duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	}
+	else { std::cerr << "ERROR: Impossible to initialize player" << std::endl; }
+
+	player.uninitialize();
+	playerManager.releasePlayer(playerID);
+	return res;
+}
+
+void printReport(const latency_histograms_t& histograms, const std::vector<double>& throughputs, const size_t nTrial)
+{
+	double meanThroughput = 0.0;
+	for (const double throughput : throughputs) { meanThroughput += throughput; }
+	meanThroughput /= double(throughputs.size());
+
+	const auto& total = histograms[PHASE_COUNT - 1];
+	std::cout << "\n=== ONNX Box Benchmark Summary (" << nTrial << " Trials) ===\n"
+			<< "Total buffers processed: " << total.count() << "\n"
+			<< "Throughput: " << meanThroughput << " buffers/s\n"
+			<< "Average latency per buffer: " << total.mean() << " ms\n";
+	for (size_t i = 0; i < PHASE_COUNT; ++i) {
+		std::cout << PHASE_NAMES[i] << " (ms): mean " << histograms[i].mean();
+		for (size_t j = 0; j < 4; ++j) { std::cout << ", " << PERCENTILE_NAMES[j] << " " << histograms[i].percentile(PERCENTILES[j]); }
+		std::cout << "\n";
+	}
+	std::cout << "================================================" << std::endl;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+	configuration_t config;
+	if (!parseArguments(argc, argv, config)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	OpenViBE::CKernelLoader loader;
+	OpenViBE::CString error;
+	if (!loader.load(OpenViBE::Directories::getLib("kernel"), &error)) {
+		std::cerr << "ERROR: Impossible to load kernel (" << error << ")" << std::endl;
+		return 1;
+	}
+	loader.initialize();
+
+	OpenViBE::Kernel::IKernelDesc* kernelDesc = nullptr;
+	loader.getKernelDesc(kernelDesc);
+	OpenViBE::Kernel::IKernelContext* ctx = kernelDesc ? kernelDesc->createKernel("onnx-benchmark", OpenViBE::Directories::getDataDir() + "/kernel/openvibe.conf")
+											: nullptr;
+	if (!ctx || !ctx->initialize()) {
+		std::cerr << "ERROR: Impossible to create kernel" << std::endl;
+		if (ctx) { kernelDesc->releaseKernel(ctx); }
+		loader.uninitialize();
+		loader.unload();
+		return 1;
+	}
+	OpenViBE::Toolkit::initialize(*ctx);
+	ctx->getPluginManager().addPluginsFromFiles(ctx->getConfigurationManager().expand("${Kernel_Plugins}"));
+
+	latency_histograms_t histograms;
+	std::vector<double> throughputs;
+	int res = 0;
+	for (size_t trial = 0; trial < config.nTrial && res == 0; ++trial) {
+		// The scenario is imported again for each trial, so that each one starts from the saved state
+		auto& scenarioManager = ctx->getScenarioManager();
+		OpenViBE::CIdentifier scenarioID;
+		if (!scenarioManager.importScenarioFromFile(scenarioID, config.scenarioFile.c_str(), OVP_GD_ClassId_Algorithm_XMLScenarioImporter)) {
+			std::cerr << "ERROR: Impossible to import scenario " << config.scenarioFile << std::endl;
+			res = 1;
+			break;
+		}
+
+		const std::vector<std::string> latencyFiles = setupOnnxBoxes(scenarioManager.getScenario(scenarioID), config, trial);
+		if (latencyFiles.empty()) {
+			std::cerr << "ERROR: No ONNX Classifier box in scenario " << config.scenarioFile << std::endl;
+			res = 1;
+		}
+
+		double duration = 0.0;
+		if (res == 0 && playScenario(*ctx, scenarioID, config, duration)) {
+			size_t nChunk = 0;
+			for (const auto& file : latencyFiles) {
+				nChunk += readLatencyFile(file, histograms);
+				std::filesystem::remove(file);
+			}
+			throughputs.push_back(duration > 0.0 ? double(nChunk) / duration : 0.0);
+			std::cout << "Trial " << (trial + 1) << "/" << config.nTrial << ": " << nChunk << " buffers in " << duration << " s" << std::endl;
+		}
+		else { res = 1; }
+
+		scenarioManager.releaseScenario(scenarioID);
+	}
+
+	if (res == 0) { printReport(histograms, throughputs, config.nTrial); }
+
+	OpenViBE::Toolkit::uninitialize(*ctx);
+	kernelDesc->releaseKernel(ctx);
+	loader.uninitialize();
+	loader.unload();
+
+	return res;
+}
@@ -12,6 +12,7 @@
 
 #include <string>
 #include <functional>
+#include <algorithm>
 #include <cctype>
 #include <cmath> // std::isnan, std::isfinite
 #include <condition_variable>
@@ -438,11 +439,7 @@ bool CAcquisitionServer::loop()
 				m_kernelCtx.getLogManager() << Kernel::LogLevel_Debug << "Creating buffer for connection " << uint64_t(it->first) << "\n";
 
 				// Signal buffer
-				for (size_t j = 0; j < m_nChannel; ++j) {
-					for (size_t i = 0; i < m_nSamplePerSentBlock; ++i) {
-						ip_matrix->getBuffer()[j * m_nSamplePerSentBlock + i] = double(m_PendingBuffers[int(i + info.nSampleToSkip)][j]);
-					}
-				}
+				m_PendingBuffers.copyBlock(size_t(info.nSampleToSkip), m_nSamplePerSentBlock, ip_matrix->getBuffer());
 
 				// Boundaries of the part of the buffer to be sent to this connection
 				const uint64_t connBufferTimeOffset = CTime(m_sampling, info.nSampleToSkip).time();
@@ -503,7 +500,7 @@ bool CAcquisitionServer::loop()
 		m_PendingStimSet.removeRange(0, endTime);
 
 		// Clears pending signal
-		m_PendingBuffers.erase(m_PendingBuffers.begin(), m_PendingBuffers.begin() + m_nSamplePerSentBlock);
+		m_PendingBuffers.popFront(m_nSamplePerSentBlock);
 	}
 
 	return true;
@@ -686,7 +683,8 @@ bool CAcquisitionServer::start()
 
 	m_kernelCtx.getLogManager() << Kernel::LogLevel_Info << "Starting the acquisition...\n";
 
-	m_PendingBuffers.clear();
+	// Room for a second of signal or four blocks, the buffer only grows if the driver delivers more before they are sent
+	m_PendingBuffers.initialize(m_nChannel, std::max(m_sampling, 4 * m_nSamplePerSentBlock));
 	m_PendingStimSet.clear();
 
 	m_nSample     = 0;
@@ -805,60 +803,67 @@ void CAcquisitionServer::setSamples(const float* samples)
 void CAcquisitionServer::setSamples(const float* samples, const size_t count)
 {
 	if (m_isStarted) {
-		for (size_t i = 0; i < count; ++i) {
-			if (!m_replacementInProgress) {
-				// otherwise NaN are propagating
-				m_overSamplingSwapBuffers = m_SwapBuffers;
-			}
-			for (size_t k = 0; k < m_overSamplingFactor; ++k) {
-				const float alpha = float(k + 1) / m_overSamplingFactor;
-
-				bool hadNaN = false;
-
-				for (size_t j = 0; j < m_nChannel; ++j) {
-					const size_t channel = m_selectedChannels[j];
-
-					if (std::isnan(samples[channel * count + i]) || !std::isfinite(samples[channel * count + i])) { // NaN or infinite values
-						hadNaN = true;
-
-						switch (m_eNaNReplacementPolicy) {
-							case ENaNReplacementPolicy::Disabled: m_SwapBuffers[j] = std::numeric_limits<float>::quiet_NaN();
-								break;
-							case ENaNReplacementPolicy::Zero: m_SwapBuffers[j] = 0;
-								break;
-							case ENaNReplacementPolicy::LastCorrectValue:
-								// we simply don't update the value
-								break;
-							default: break;
+		// Without oversampling nor invalid values, the samples of each channel are copied at once
+		if (m_overSamplingFactor == 1 && !m_replacementInProgress && count > 0 && areSamplesFinite(samples, count)) {
+			m_PendingBuffers.push(samples, count, m_selectedChannels);
+			for (size_t j = 0; j < m_nChannel; ++j) { m_SwapBuffers[j] = samples[m_selectedChannels[j] * count + count - 1]; }
+		}
+		else {
+			for (size_t i = 0; i < count; ++i) {
+				if (!m_replacementInProgress) {
+					// otherwise NaN are propagating
+					m_overSamplingSwapBuffers = m_SwapBuffers;
+				}
+				for (size_t k = 0; k < m_overSamplingFactor; ++k) {
+					const float alpha = float(k + 1) / m_overSamplingFactor;
+
+					bool hadNaN = false;
+
+					for (size_t j = 0; j < m_nChannel; ++j) {
+						const size_t channel = m_selectedChannels[j];
+
+						if (std::isnan(samples[channel * count + i]) || !std::isfinite(samples[channel * count + i])) { // NaN or infinite values
+							hadNaN = true;
+
+							switch (m_eNaNReplacementPolicy) {
+								case ENaNReplacementPolicy::Disabled: m_SwapBuffers[j] = std::numeric_limits<float>::quiet_NaN();
+									break;
+								case ENaNReplacementPolicy::Zero: m_SwapBuffers[j] = 0;
+									break;
+								case ENaNReplacementPolicy::LastCorrectValue:
+									// we simply don't update the value
+									break;
+								default: break;
+							}
 						}
+						else { m_SwapBuffers[j] = alpha * samples[channel * count + i] + (1 - alpha) * m_overSamplingSwapBuffers[j]; }
 					}
-					else { m_SwapBuffers[j] = alpha * samples[channel * count + i] + (1 - alpha) * m_overSamplingSwapBuffers[j]; }
-				}
 
-				const uint64_t currentIdx = m_nSample + i * m_overSamplingFactor + k;		// j is not included here as all channels have the equal sample time
+					const uint64_t currentIdx = m_nSample + i * m_overSamplingFactor + k;		// j is not included here as all channels have the equal sample time
 
-				if (hadNaN) {
-					// When a NaN is encountered at time t1 on any channel, OVTK_StimulationId_Artifact stimulus is sent. When a first good sample is encountered 
-					// after the last bad sample t2, OVTK_StimulationId_NoArtifact stimulus is sent, i.e. specifying a range of bad data : [t1,t2]. The stimuli are global 
-					// and not specific to channels.
+					if (hadNaN) {
+						// When a NaN is encountered at time t1 on any channel, OVTK_StimulationId_Artifact stimulus is sent. When a first good sample is encountered 
+						// after the last bad sample t2, OVTK_StimulationId_NoArtifact stimulus is sent, i.e. specifying a range of bad data : [t1,t2]. The stimuli are global 
+						// and not specific to channels.
 
-					if (!m_replacementInProgress) {
-						const uint64_t incorrectBlockStarts = CTime(m_sampling, currentIdx).time();
-						m_PendingStimSet.push_back(OVTK_StimulationId_Artifact, incorrectBlockStarts, 0);
-						m_replacementInProgress = true;
+						if (!m_replacementInProgress) {
+							const uint64_t incorrectBlockStarts = CTime(m_sampling, currentIdx).time();
+							m_PendingStimSet.push_back(OVTK_StimulationId_Artifact, incorrectBlockStarts, 0);
+							m_replacementInProgress = true;
+						}
 					}
-				}
-				else {
-					if (m_replacementInProgress) {
-						// @note -1 is used here because the incorrect-correct range is inclusive, [a,b]. So when sample is good at b+1, we set the end point at b.
-						const uint64_t incorrectBlockStops = CTime(m_sampling, currentIdx - 1).time();
+					else {
+						if (m_replacementInProgress) {
+							// @note -1 is used here because the incorrect-correct range is inclusive, [a,b]. So when sample is good at b+1, we set the end point at b.
+							const uint64_t incorrectBlockStops = CTime(m_sampling, currentIdx - 1).time();
 
-						m_PendingStimSet.push_back(OVTK_StimulationId_NoArtifact, incorrectBlockStops, 0);
-						m_replacementInProgress = false;
+							m_PendingStimSet.push_back(OVTK_StimulationId_NoArtifact, incorrectBlockStops, 0);
+							m_replacementInProgress = false;
+						}
 					}
-				}
 
-				m_PendingBuffers.push_back(m_SwapBuffers);
+					m_PendingBuffers.push(m_SwapBuffers.data());
+				}
 			}
 		}
 
@@ -873,6 +878,15 @@ void CAcquisitionServer::setSamples(const float* samples, const size_t count)
 	else { m_kernelCtx.getLogManager() << Kernel::LogLevel_Warning << "The acquisition is not started\n"; }
 }
 
+bool CAcquisitionServer::areSamplesFinite(const float* samples, const size_t count) const
+{
+	for (const size_t channel : m_selectedChannels) {
+		const float* values = samples + channel * count;
+		if (!std::all_of(values, values + count, [](const float value) { return std::isfinite(value); })) { return false; }
+	}
+	return true;
+}
+
 void CAcquisitionServer::setStimulationSet(const CStimulationSet& stimSet)
 {
 	if (m_isStarted) {
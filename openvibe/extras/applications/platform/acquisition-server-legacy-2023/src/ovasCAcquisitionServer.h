@@ -4,6 +4,7 @@
 #include "ovasIDriver.h"
 #include "ovasIHeader.h"
 #include "ovasCDriftCorrection.h"
+#include "ovasCSampleBuffer.h"
 
 #include <socket/IConnectionServer.h>
 
@@ -107,7 +108,7 @@ public:
 	std::mutex m_ProtectionMutex;
 	std::mutex m_ExecutionMutex;
 
-	std::deque<std::vector<float>> m_PendingBuffers;
+	CSampleBuffer m_PendingBuffers;
 	std::vector<float> m_SwapBuffers;
 
 	size_t m_nSample   = 0;
@@ -121,6 +122,9 @@ public:
 protected:
 	static bool requestClientThreadQuit(CConnectionClientHandlerThread* th);
 
+	// Checks that the selected channels of samples from the driver have no NaN nor infinite value
+	bool areSamplesFinite(const float* samples, size_t count) const;
+
 	//---------- Variables ----------
 	std::mutex m_oPendingConnectionProtectionMutex;
 	std::mutex m_oPendingConnectionExecutionMutex;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ovas_base.h"
+#include "ovasCSampleBuffer.h"
 
 #include <string>
 #include <vector>
@@ -49,7 +50,7 @@ public:
 	// \param pendingBuffers [in/out] : The sample buffer to be corrected
 	// \param pendingStimSet [in/out] : The stimulation set to be realigned
 	// \param paddingBuffer[in] : The sample to repeatedly add if correction > 0
-	bool correctDrift(int64_t correction, size_t& totalSamples, std::deque<std::vector<float>>& pendingBuffers,
+	bool correctDrift(int64_t correction, size_t& totalSamples, CSampleBuffer& pendingBuffers,
 					  CStimulationSet& pendingStimSet, const std::vector<float>& paddingBuffer);
 
 	// Status functions
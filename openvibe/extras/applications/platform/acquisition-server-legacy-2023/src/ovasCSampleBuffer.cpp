@@ -0,0 +1,91 @@
+#include "ovasCSampleBuffer.h"
+
+#include <algorithm>
+
+namespace OpenViBE {
+namespace AcquisitionServer {
+
+void CSampleBuffer::initialize(const size_t nChannel, const size_t capacity)
+{
+	m_nChannel = nChannel;
+	m_capacity = std::max<size_t>(capacity, 1);
+	m_buffer.assign(m_nChannel * m_capacity, 0);
+	this->clear();
+}
+
+void CSampleBuffer::push(const float* sample, const size_t count)
+{
+	this->reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		const size_t p = position(m_size + i);
+		for (size_t j = 0; j < m_nChannel; ++j) { m_buffer[j * m_capacity + p] = sample[j]; }
+	}
+	m_size += count;
+}
+
+void CSampleBuffer::push(const float* samples, const size_t count, const std::vector<size_t>& channels)
+{
+	this->reserve(count);
+
+	// The samples go to at most two contiguous ranges of each channel, before and after the end of the buffer
+	const size_t p     = position(m_size);
+	const size_t first = std::min(count, m_capacity - p);
+	for (size_t j = 0; j < m_nChannel; ++j) {
+		const float* src = samples + channels[j] * count;
+		float* dst       = m_buffer.data() + j * m_capacity;
+		std::copy(src, src + first, dst + p);
+		std::copy(src + first, src + count, dst);
+	}
+	m_size += count;
+}
+
+void CSampleBuffer::popFront(size_t count)
+{
+	count   = std::min(count, m_size);
+	m_start = position(count);
+	m_size -= count;
+	if (m_size == 0) { m_start = 0; }
+}
+
+void CSampleBuffer::popBack(const size_t count) { m_size -= std::min(count, m_size); }
+
+void CSampleBuffer::copyBlock(const size_t first, const size_t count, double* block) const
+{
+	const size_t p      = position(first);
+	const size_t nFirst = std::min(count, m_capacity - p);
+	for (size_t j = 0; j < m_nChannel; ++j) {
+		const float* src = m_buffer.data() + j * m_capacity;
+		double* dst      = block + j * count;
+		std::copy(src + p, src + p + nFirst, dst);
+		std::copy(src, src + (count - nFirst), dst + nFirst);
+	}
+}
+
+void CSampleBuffer::copySample(const size_t sample, float* values) const
+{
+	const size_t p = position(sample);
+	for (size_t j = 0; j < m_nChannel; ++j) { values[j] = m_buffer[j * m_capacity + p]; }
+}
+
+void CSampleBuffer::reserve(const size_t count)
+{
+	if (m_size + count <= m_capacity) { return; }
+
+	// Moves the pending samples to the start of a larger buffer
+	const size_t capacity = std::max(m_size + count, 2 * m_capacity);
+	std::vector<float> buffer(m_nChannel * capacity);
+	const size_t nFirst = std::min(m_size, m_capacity - m_start);
+	for (size_t j = 0; j < m_nChannel; ++j) {
+		const float* src = m_buffer.data() + j * m_capacity;
+		float* dst       = buffer.data() + j * capacity;
+		std::copy(src + m_start, src + m_start + nFirst, dst);
+		std::copy(src, src + (m_size - nFirst), dst + nFirst);
+	}
+
+	m_buffer.swap(buffer);
+	m_capacity = capacity;
+	m_start    = 0;
+}
+
+}  // namespace AcquisitionServer
+}  // namespace OpenViBE
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace OpenViBE {
+namespace AcquisitionServer {
+/*
+ * \class CSampleBuffer
+ *
+ * \brief Samples pending in the acquisition server, stored channel by channel in a circular buffer.
+ *
+ * The buffer is allocated when the acquisition starts and only grows if the driver delivers more samples than it can hold
+ * before the server sends them, so appending and removing samples does not allocate memory.
+ * Samples are indexed from the oldest one still pending.
+ */
+class CSampleBuffer final
+{
+public:
+	// Allocates room for a number of samples and clears the buffer
+	void initialize(size_t nChannel, size_t capacity);
+	void clear() { m_start = m_size = 0; }
+
+	size_t getChannelCount() const { return m_nChannel; }
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+
+	// Value of a channel at a sample
+	float& at(const size_t sample, const size_t channel) { return m_buffer[channel * m_capacity + position(sample)]; }
+	const float& at(const size_t sample, const size_t channel) const { return m_buffer[channel * m_capacity + position(sample)]; }
+
+	// Appends a sample given as one value per channel, count times
+	void push(const float* sample, size_t count = 1);
+
+	// Appends count samples given channel by channel, the channel j of the buffer is read from samples[channels[j] * count]
+	void push(const float* samples, size_t count, const std::vector<size_t>& channels);
+
+	// Removes the oldest or the most recent samples
+	void popFront(size_t count);
+	void popBack(size_t count);
+
+	// Copies count samples from the sample first to a block stored channel by channel, i.e. block[j * count + i] is the channel j of sample first + i
+	void copyBlock(size_t first, size_t count, double* block) const;
+
+	// Copies a sample to one value per channel
+	void copySample(size_t sample, float* values) const;
+
+private:
+	size_t position(const size_t sample) const
+	{
+		const size_t i = m_start + sample;
+		return i < m_capacity ? i : i - m_capacity;
+	}
+
+	// Makes room for at least count more samples
+	void reserve(size_t count);
+
+	std::vector<float> m_buffer;	// m_capacity values per channel
+	size_t m_nChannel = 0;
+	size_t m_capacity = 0;
+	size_t m_start    = 0;			// Position of the oldest sample
+	size_t m_size     = 0;
+};
+}  // namespace AcquisitionServer
+}  // namespace OpenViBE
@@ -3,6 +3,7 @@
 #include "ovas_base.h"
 
 #include "../ovasCSettingsHelper.h"
+#include "../ovasCSampleBuffer.h"
 
 #include "boost/variant.hpp"
 #include <deque>
@@ -41,11 +42,11 @@ public:
 	  * It gets a reference to the current signal buffer and the stimulation set with its start and end dates.
 	  *
 	  * Note that the given input buffer may have more samples than what should be processed 
-	  * per iteration. All operations on vPendingBuffer done in the hook should only consider
+	  * per iteration. All operations on pendingBuffer done in the hook should only consider
 	  * the first sampleCountSentPerBlock samples. The later samples should be left as-is
 	  * and will be provided on the next call.
 	  */
-	virtual void loopHook(std::deque<std::vector<float>>& /*pendingBuffer*/, CStimulationSet& /*stimulationSet*/, const uint64_t /*start*/,
+	virtual void loopHook(CSampleBuffer& /*pendingBuffer*/, CStimulationSet& /*stimulationSet*/, const uint64_t /*start*/,
 						  const uint64_t /*end*/, const uint64_t /*sampleTime*/) {}
 
 	/// Hook called at the end of the acceptNewConnection() function of AcquisitionServer
@@ -12,6 +12,8 @@
 
 #include <string>
 #include <functional>
+#include <algorithm>
+#include <memory>
 #include <cctype>
 #include <cmath> // std::isnan, std::isfinite
 #include <condition_variable>
@@ -115,22 +117,20 @@ public:
 				continue;
 			}
 
-			CMemoryBuffer* buffer = m_ClientPendingBuffer.front();
+			const std::shared_ptr<const CMemoryBuffer> buffer = std::move(m_ClientPendingBuffer.front());
 			m_ClientPendingBuffer.pop_front();
 
-			// Don't go into blocking send while holding the lock; ok to unlock as buffer ptr+mem is now owned by this thread
+			// Don't go into blocking send while holding the lock; ok to unlock as the buffer is kept alive by this thread's reference
 			oLock.unlock();
 
 			const uint64_t size = buffer->getSize();
 			m_Connection.sendBufferBlocking(&size, sizeof(size));
 			m_Connection.sendBufferBlocking(buffer->getDirectPointer(), buffer->getSize());
-			delete buffer;
 		}
 
 		oLock.lock();
 
 		// We're done, clean any possible pending buffers
-		for (auto it = m_ClientPendingBuffer.begin(); it != m_ClientPendingBuffer.end(); ++it) { delete *it; }
 		m_ClientPendingBuffer.clear();
 
 		oLock.unlock();
@@ -138,14 +138,12 @@ public:
 		// The thread will exit here and can be joined
 	}
 
-	void scheduleBuffer(const CMemoryBuffer& buffer)
+	// The buffer may be shared with other clients, it must not be modified once scheduled
+	void scheduleBuffer(std::shared_ptr<const CMemoryBuffer> buffer)
 	{
 		{
 			std::lock_guard<std::mutex> oLock(m_ClientThreadMutex);
-			if (!m_PleaseQuit) {
-				CMemoryBuffer* tmp = new CMemoryBuffer(buffer);
-				m_ClientPendingBuffer.push_back(tmp);
-			}
+			if (!m_PleaseQuit) { m_ClientPendingBuffer.push_back(std::move(buffer)); }
 		}
 
 		// No big harm notifying in any case, though if in 'quit' state, the quit request has already notified
@@ -155,7 +153,7 @@ public:
 	CAcquisitionServer& m_AcquisitionServer;
 	Socket::IConnection& m_Connection;
 
-	std::deque<CMemoryBuffer*> m_ClientPendingBuffer;
+	std::deque<std::shared_ptr<const CMemoryBuffer>> m_ClientPendingBuffer;
 
 	// Here we use a condition variable to avoid sleeping
 	std::mutex m_ClientThreadMutex;
@@ -318,7 +316,7 @@ bool CAcquisitionServer::loop()
 				op_buffer->setSize(0, true);
 				m_encoder->process(OVP_GD_Algorithm_MasterAcquisitionEncoder_InputTriggerId_EncodeHeader);
 
-				info.connectionClientHandlerThread->scheduleBuffer(*op_buffer);
+				info.connectionClientHandlerThread->scheduleBuffer(std::make_shared<const CMemoryBuffer>(*op_buffer));
 			}
 			else {
 				// When a new connection is found and the
@@ -429,65 +427,30 @@ bool CAcquisitionServer::loop()
 			(*itp)->loopHook(m_PendingBuffers, m_PendingStimSet, startTime, endTime, lastTime);
 		}
 
-		// Handle connections
+		// Handle connections; the clients which need the same part of the signal, stimulations and channel units share a single encoded buffer
+		m_encodedBlocks.clear();
 		for (auto it = m_connections.begin(); it != m_connections.end(); ++it) {
 			// Socket::IConnection* connection=it->first;
 			connection_info_t& info = it->second;
 
 			if (info.nSampleToSkip < m_nSamplePerSentBlock) {
-				m_kernelCtx.getLogManager() << Kernel::LogLevel_Debug << "Creating buffer for connection " << uint64_t(it->first) << "\n";
-
-				// Signal buffer
-				for (size_t j = 0; j < m_nChannel; ++j) {
-					for (size_t i = 0; i < m_nSamplePerSentBlock; ++i) {
-						ip_matrix->getBuffer()[j * m_nSamplePerSentBlock + i] = double(m_PendingBuffers[int(i + info.nSampleToSkip)][j]);
-					}
-				}
-
-				// Boundaries of the part of the buffer to be sent to this connection
-				const uint64_t connBufferTimeOffset = CTime(m_sampling, info.nSampleToSkip).time();
-				const uint64_t connBlockStartTime   = startTime + connBufferTimeOffset;
-				const uint64_t connBlockEndTime     = endTime + connBufferTimeOffset;
-
-				//m_kernelCtx.getLogManager() << Kernel::LogLevel_Info << "start: " << (start) << "end: " << (end) << "\n";
-
-				// Stimulation buffer
-				CStimulationSet& stimSet = *ip_stimSet;
-				stimSet.clear();
-
-				// Take the stimuli range valid for the buffer and adjust wrt connection time (stamp at connection = stamp at time 0 for the client)
-				for (size_t k = 0; k < m_PendingStimSet.size(); ++k) {
-					const uint64_t date = m_PendingStimSet.getDate(k); // this date is wrt the whole acquisition time in the server
-					if (date >= connBlockStartTime && date <= connBlockEndTime) {
-						// The new date is wrt the specific connection time of the client (i.e. the chunk times on Designer side)
-						const uint64_t newDate = ((date > info.stimulationTimeOffset) ? (date - info.stimulationTimeOffset) : 0);
-
-						/*
-						std::cout << std::setprecision(10) << CTime(date).toSeconds() << " to " << CTime(newDate).toSeconds()
-								<< " for [" << CTime(startTime).toSeconds() << "," << CTime(endTime).toSeconds()  << "]\n";
-						*/
-
-						stimSet.push_back(m_PendingStimSet.getId(k), newDate, m_PendingStimSet.getDuration(k));
-					}
-				}
-
 				// Send a chunk of channel units? Note that we'll always send the units header.
-				if (!info.isChannelUnitsSent) {
-					// If default values in channel units, don't bother sending unit data chunk
-					ip_encodeChannelUnitData = m_headerCopy->isChannelUnitSet();
-					// std::cout << "Set " <<  ip_channelUnits->getBufferElementCount()  << "\n";
-				}
-
-				op_buffer->setSize(0, true);
-				m_encoder->process(OVP_GD_Algorithm_MasterAcquisitionEncoder_InputTriggerId_EncodeBuffer);
-
-				if (!info.isChannelUnitsSent) {
-					// Do not send again
-					info.isChannelUnitsSent  = true;
-					ip_encodeChannelUnitData = false;
-				}
-
-				info.connectionClientHandlerThread->scheduleBuffer(*op_buffer);
+				// If default values in channel units, don't bother sending unit data chunk
+				const bool withChannelUnits = !info.isChannelUnitsSent && m_headerCopy->isChannelUnitSet();
+
+				// The stimulation time offset of the connection only matters if the block has stimulations
+				const uint64_t connBufferTimeOffset  = CTime(m_sampling, info.nSampleToSkip).time();
+				const bool hasStimulations           = hasPendingStimulations(startTime + connBufferTimeOffset, endTime + connBufferTimeOffset);
+				const uint64_t stimulationTimeOffset = hasStimulations ? info.stimulationTimeOffset : 0;
+
+				const auto buffer = m_encodedBlocks.get(info.nSampleToSkip, stimulationTimeOffset, withChannelUnits, [&]()
+				{
+					m_kernelCtx.getLogManager() << Kernel::LogLevel_Debug << "Creating buffer for connection " << uint64_t(it->first) << "\n";
+					return encodeBlock(info, startTime, endTime, withChannelUnits);
+				});
+
+				info.isChannelUnitsSent = true;
+				info.connectionClientHandlerThread->scheduleBuffer(buffer);
 			}
 			else {
 				// Here sample count to skip >= block size, so we effective drop this chunk from the viewpoint of this connection.
@@ -497,18 +460,61 @@ bool CAcquisitionServer::loop()
 				info.nSampleToSkip -= m_nSamplePerSentBlock;
 			}
 		}
+		m_encodedBlocks.clear();
 
 		// Clears pending stimulations; Can start from zero as we know we'll never send anything in the future thats
 		// before current BufferEndTime.
 		m_PendingStimSet.removeRange(0, endTime);
 
 		// Clears pending signal
-		m_PendingBuffers.erase(m_PendingBuffers.begin(), m_PendingBuffers.begin() + m_nSamplePerSentBlock);
+		m_PendingBuffers.popFront(m_nSamplePerSentBlock);
 	}
 
 	return true;
 }
 
+bool CAcquisitionServer::hasPendingStimulations(const uint64_t start, const uint64_t end) const
+{
+	for (size_t k = 0; k < m_PendingStimSet.size(); ++k) {
+		const uint64_t date = m_PendingStimSet.getDate(k);
+		if (date >= start && date <= end) { return true; }
+	}
+	return false;
+}
+
+std::shared_ptr<const CMemoryBuffer> CAcquisitionServer::encodeBlock(const connection_info_t& info, const uint64_t startTime, const uint64_t endTime,
+																	const bool withChannelUnits)
+{
+	// Signal buffer
+	m_PendingBuffers.copyBlock(size_t(info.nSampleToSkip), m_nSamplePerSentBlock, ip_matrix->getBuffer());
+
+	// Boundaries of the part of the buffer to be sent to this connection
+	const uint64_t connBufferTimeOffset = CTime(m_sampling, info.nSampleToSkip).time();
+	const uint64_t connBlockStartTime   = startTime + connBufferTimeOffset;
+	const uint64_t connBlockEndTime     = endTime + connBufferTimeOffset;
+
+	// Stimulation buffer
+	CStimulationSet& stimSet = *ip_stimSet;
+	stimSet.clear();
+
+	// Take the stimuli range valid for the buffer and adjust wrt connection time (stamp at connection = stamp at time 0 for the client)
+	for (size_t k = 0; k < m_PendingStimSet.size(); ++k) {
+		const uint64_t date = m_PendingStimSet.getDate(k); // this date is wrt the whole acquisition time in the server
+		if (date >= connBlockStartTime && date <= connBlockEndTime) {
+			// The new date is wrt the specific connection time of the client (i.e. the chunk times on Designer side)
+			const uint64_t newDate = ((date > info.stimulationTimeOffset) ? (date - info.stimulationTimeOffset) : 0);
+			stimSet.push_back(m_PendingStimSet.getId(k), newDate, m_PendingStimSet.getDuration(k));
+		}
+	}
+
+	ip_encodeChannelUnitData = withChannelUnits;
+	op_buffer->setSize(0, true);
+	m_encoder->process(OVP_GD_Algorithm_MasterAcquisitionEncoder_InputTriggerId_EncodeBuffer);
+	ip_encodeChannelUnitData = false;
+
+	return std::make_shared<const CMemoryBuffer>(*op_buffer);
+}
+
 //___________________________________________________________________//
 //                                                                   //
 
@@ -686,7 +692,8 @@ bool CAcquisitionServer::start()
 
 	m_kernelCtx.getLogManager() << Kernel::LogLevel_Info << "Starting the acquisition...\n";
 
-	m_PendingBuffers.clear();
+	// Room for a second of signal or four blocks, the buffer only grows if the driver delivers more before they are sent
+	m_PendingBuffers.initialize(m_nChannel, std::max(m_sampling, 4 * m_nSamplePerSentBlock));
 	m_PendingStimSet.clear();
 
 	m_nSample     = 0;
@@ -805,60 +812,67 @@ void CAcquisitionServer::setSamples(const float* samples)
 void CAcquisitionServer::setSamples(const float* samples, const size_t count)
 {
 	if (m_isStarted) {
-		for (size_t i = 0; i < count; ++i) {
-			if (!m_replacementInProgress) {
-				// otherwise NaN are propagating
-				m_overSamplingSwapBuffers = m_SwapBuffers;
-			}
-			for (size_t k = 0; k < m_overSamplingFactor; ++k) {
-				const float alpha = float(k + 1) / m_overSamplingFactor;
-
-				bool hadNaN = false;
-
-				for (size_t j = 0; j < m_nChannel; ++j) {
-					const size_t channel = m_selectedChannels[j];
-
-					if (std::isnan(samples[channel * count + i]) || !std::isfinite(samples[channel * count + i])) { // NaN or infinite values
-						hadNaN = true;
-
-						switch (m_eNaNReplacementPolicy) {
-							case ENaNReplacementPolicy::Disabled: m_SwapBuffers[j] = std::numeric_limits<float>::quiet_NaN();
-								break;
-							case ENaNReplacementPolicy::Zero: m_SwapBuffers[j] = 0;
-								break;
-							case ENaNReplacementPolicy::LastCorrectValue:
-								// we simply don't update the value
-								break;
-							default: break;
+		// Without oversampling nor invalid values, the samples of each channel are copied at once
+		if (m_overSamplingFactor == 1 && !m_replacementInProgress && count > 0 && areSamplesFinite(samples, count)) {
+			m_PendingBuffers.push(samples, count, m_selectedChannels);
+			for (size_t j = 0; j < m_nChannel; ++j) { m_SwapBuffers[j] = samples[m_selectedChannels[j] * count + count - 1]; }
+		}
+		else {
+			for (size_t i = 0; i < count; ++i) {
+				if (!m_replacementInProgress) {
+					// otherwise NaN are propagating
+					m_overSamplingSwapBuffers = m_SwapBuffers;
+				}
+				for (size_t k = 0; k < m_overSamplingFactor; ++k) {
+					const float alpha = float(k + 1) / m_overSamplingFactor;
+
+					bool hadNaN = false;
+
+					for (size_t j = 0; j < m_nChannel; ++j) {
+						const size_t channel = m_selectedChannels[j];
+
+						if (std::isnan(samples[channel * count + i]) || !std::isfinite(samples[channel * count + i])) { // NaN or infinite values
+							hadNaN = true;
+
+							switch (m_eNaNReplacementPolicy) {
+								case ENaNReplacementPolicy::Disabled: m_SwapBuffers[j] = std::numeric_limits<float>::quiet_NaN();
+									break;
+								case ENaNReplacementPolicy::Zero: m_SwapBuffers[j] = 0;
+									break;
+								case ENaNReplacementPolicy::LastCorrectValue:
+									// we simply don't update the value
+									break;
+								default: break;
+							}
 						}
+						else { m_SwapBuffers[j] = alpha * samples[channel * count + i] + (1 - alpha) * m_overSamplingSwapBuffers[j]; }
 					}
-					else { m_SwapBuffers[j] = alpha * samples[channel * count + i] + (1 - alpha) * m_overSamplingSwapBuffers[j]; }
-				}
 
-				const uint64_t currentIdx = m_nSample + i * m_overSamplingFactor + k;		// j is not included here as all channels have the equal sample time
+					const uint64_t currentIdx = m_nSample + i * m_overSamplingFactor + k;		// j is not included here as all channels have the equal sample time
 
-				if (hadNaN) {
-					// When a NaN is encountered at time t1 on any channel, OVTK_StimulationId_Artifact stimulus is sent. When a first good sample is encountered 
-					// after the last bad sample t2, OVTK_StimulationId_NoArtifact stimulus is sent, i.e. specifying a range of bad data : [t1,t2]. The stimuli are global 
-					// and not specific to channels.
+					if (hadNaN) {
+						// When a NaN is encountered at time t1 on any channel, OVTK_StimulationId_Artifact stimulus is sent. When a first good sample is encountered 
+						// after the last bad sample t2, OVTK_StimulationId_NoArtifact stimulus is sent, i.e. specifying a range of bad data : [t1,t2]. The stimuli are global 
+						// and not specific to channels.
 
-					if (!m_replacementInProgress) {
-						const uint64_t incorrectBlockStarts = CTime(m_sampling, currentIdx).time();
-						m_PendingStimSet.push_back(OVTK_StimulationId_Artifact, incorrectBlockStarts, 0);
-						m_replacementInProgress = true;
+						if (!m_replacementInProgress) {
+							const uint64_t incorrectBlockStarts = CTime(m_sampling, currentIdx).time();
+							m_PendingStimSet.push_back(OVTK_StimulationId_Artifact, incorrectBlockStarts, 0);
+							m_replacementInProgress = true;
+						}
 					}
-				}
-				else {
-					if (m_replacementInProgress) {
-						// @note -1 is used here because the incorrect-correct range is inclusive, [a,b]. So when sample is good at b+1, we set the end point at b.
-						const uint64_t incorrectBlockStops = CTime(m_sampling, currentIdx - 1).time();
+					else {
+						if (m_replacementInProgress) {
+							// @note -1 is used here because the incorrect-correct range is inclusive, [a,b]. So when sample is good at b+1, we set the end point at b.
+							const uint64_t incorrectBlockStops = CTime(m_sampling, currentIdx - 1).time();
 
-						m_PendingStimSet.push_back(OVTK_StimulationId_NoArtifact, incorrectBlockStops, 0);
-						m_replacementInProgress = false;
+							m_PendingStimSet.push_back(OVTK_StimulationId_NoArtifact, incorrectBlockStops, 0);
+							m_replacementInProgress = false;
+						}
 					}
-				}
 
-				m_PendingBuffers.push_back(m_SwapBuffers);
+					m_PendingBuffers.push(m_SwapBuffers.data());
+				}
 			}
 		}
 
@@ -873,6 +887,15 @@ void CAcquisitionServer::setSamples(const float* samples, const size_t count)
 	else { m_kernelCtx.getLogManager() << Kernel::LogLevel_Warning << "The acquisition is not started\n"; }
 }
 
+bool CAcquisitionServer::areSamplesFinite(const float* samples, const size_t count) const
+{
+	for (const size_t channel : m_selectedChannels) {
+		const float* values = samples + channel * count;
+		if (!std::all_of(values, values + count, [](const float value) { return std::isfinite(value); })) { return false; }
+	}
+	return true;
+}
+
 void CAcquisitionServer::setStimulationSet(const CStimulationSet& stimSet)
 {
 	if (m_isStarted) {
@@ -4,9 +4,12 @@
 #include "ovasIDriver.h"
 #include "ovasIHeader.h"
 #include "ovasCDriftCorrection.h"
+#include "ovasCEncodedBlocks.h"
+#include "ovasCSampleBuffer.h"
 
 #include <socket/IConnectionServer.h>
 
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -111,7 +114,7 @@ public:
     std::mutex m_ProtectionMutex;
     std::mutex m_ExecutionMutex;
 
-    std::deque<std::vector<float>> m_PendingBuffers;
+    CSampleBuffer m_PendingBuffers;
     std::vector<float> m_SwapBuffers;
 
     size_t m_nSample   = 0;
@@ -125,6 +128,15 @@ public:
 protected:
     static bool requestClientThreadQuit(CConnectionClientHandlerThread* th);
 
+    // Checks that the selected channels of samples from the driver have no NaN nor infinite value
+    bool areSamplesFinite(const float* samples, size_t count) const;
+
+    // Checks if a pending stimulation is dated within [start, end]
+    bool hasPendingStimulations(uint64_t start, uint64_t end) const;
+
+    // Encodes the pending block as seen by a connection, i.e. shifted by its samples to skip and with stimulations dated from its start
+    std::shared_ptr<const CMemoryBuffer> encodeBlock(const connection_info_t& info, uint64_t startTime, uint64_t endTime, bool withChannelUnits);
+
     //---------- Variables ----------
     std::mutex m_oPendingConnectionProtectionMutex;
     std::mutex m_oPendingConnectionExecutionMutex;
@@ -152,6 +164,7 @@ protected:
 
     std::list<std::pair<Socket::IConnection*, connection_info_t>> m_connections;
     std::list<std::pair<Socket::IConnection*, connection_info_t>> m_pendingConnections;
+    CEncodedBlocks m_encodedBlocks;
     std::vector<float> m_overSamplingSwapBuffers;
     std::vector<double> m_impedances;
     std::vector<size_t> m_selectedChannels;
@@ -262,7 +262,7 @@ bool CDriftCorrection::estimateDrift(const uint64_t newSamples)
 }
 
 
-bool CDriftCorrection::correctDrift(const int64_t correction, size_t& totalSamples, std::deque<std::vector<float>>& pendingBuffers,
+bool CDriftCorrection::correctDrift(const int64_t correction, size_t& totalSamples, CSampleBuffer& pendingBuffers,
 									CStimulationSet& pendingStimSet, const std::vector<float>& paddingBuffer)
 {
 	if (!m_isStarted) {
@@ -289,7 +289,7 @@ bool CDriftCorrection::correctDrift(const int64_t correction, size_t& totalSampl
 	m_kernelCtx.getLogManager() << Kernel::LogLevel_Trace << "At time " << elapsedTimeSec << "s : Correcting drift by " << correction << " samples\n";
 
 	if (correction > 0) {
-		for (int64_t i = 0; i < correction; ++i) { pendingBuffers.push_back(paddingBuffer); }
+		pendingBuffers.push(paddingBuffer.data(), size_t(correction));
 
 		const uint64_t timeOfIncorrect     = CTime(m_correctedSampleCount - 1).time() / uint64_t(m_sampling);
 		const uint64_t durationOfIncorrect = CTime(m_sampling, correction).time();
@@ -306,7 +306,7 @@ bool CDriftCorrection::correctDrift(const int64_t correction, size_t& totalSampl
 	else if (correction < 0) {
 		const size_t samplesToRemove = std::min<size_t>(size_t(-correction), pendingBuffers.size());
 
-		pendingBuffers.erase(pendingBuffers.begin() + pendingBuffers.size() - int(samplesToRemove), pendingBuffers.begin() + pendingBuffers.size());
+		pendingBuffers.popBack(samplesToRemove);
 
 		const size_t lastSampleDate = CTime(m_correctedSampleCount - samplesToRemove).time() / size_t(m_sampling);
 		for (size_t i = 0; i < pendingStimSet.size(); ++i) { if (pendingStimSet.getDate(i) > lastSampleDate) { pendingStimSet.setDate(i, lastSampleDate); } }
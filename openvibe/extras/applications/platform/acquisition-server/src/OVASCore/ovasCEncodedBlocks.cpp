@@ -0,0 +1,23 @@
+#include "ovasCEncodedBlocks.h"
+
+#include <algorithm>
+
+namespace OpenViBE {
+namespace AcquisitionServer {
+
+std::shared_ptr<const CMemoryBuffer> CEncodedBlocks::get(const uint64_t nSampleToSkip, const uint64_t stimulationTimeOffset, const bool withChannelUnits,
+														 const encoder_t& encode)
+{
+	// Few distinct views per block, a linear search is enough
+	const auto block = std::find_if(m_blocks.begin(), m_blocks.end(), [&](const encoded_block_t& b)
+	{
+		return b.nSampleToSkip == nSampleToSkip && b.stimulationTimeOffset == stimulationTimeOffset && b.withChannelUnits == withChannelUnits;
+	});
+	if (block != m_blocks.end()) { return block->buffer; }
+
+	m_blocks.push_back({ nSampleToSkip, stimulationTimeOffset, withChannelUnits, encode() });
+	return m_blocks.back().buffer;
+}
+
+}  // namespace AcquisitionServer
+}  // namespace OpenViBE
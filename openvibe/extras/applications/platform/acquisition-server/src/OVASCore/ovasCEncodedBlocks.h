@@ -0,0 +1,43 @@
+#pragma once
+
+#include <openvibe/ov_all.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace OpenViBE {
+namespace AcquisitionServer {
+/*
+ * \class CEncodedBlocks
+ *
+ * \brief Buffers encoded for the block being sent, shared by the connections.
+ *
+ * Connections which skip the same number of samples, date their stimulations with the same offset and request the channel units alike
+ * receive the same buffer, so the block is encoded once per distinct view of it rather than once per connection.
+ */
+class CEncodedBlocks final
+{
+public:
+	typedef std::function<std::shared_ptr<const CMemoryBuffer>()> encoder_t;
+
+	// Forgets the buffers of the previous block
+	void clear() { m_blocks.clear(); }
+	size_t size() const { return m_blocks.size(); }
+
+	// Buffer of the block as seen by a connection, encoded on the first request of this view
+	std::shared_ptr<const CMemoryBuffer> get(uint64_t nSampleToSkip, uint64_t stimulationTimeOffset, bool withChannelUnits, const encoder_t& encode);
+
+private:
+	typedef struct
+	{
+		uint64_t nSampleToSkip;
+		uint64_t stimulationTimeOffset;
+		bool withChannelUnits;
+		std::shared_ptr<const CMemoryBuffer> buffer;
+	} encoded_block_t;
+
+	std::vector<encoded_block_t> m_blocks;
+};
+}  // namespace AcquisitionServer
+}  // namespace OpenViBE
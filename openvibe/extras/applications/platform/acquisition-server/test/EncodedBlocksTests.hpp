@@ -0,0 +1,110 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file EncodedBlocksTests.hpp
+/// \brief Tests for the sharing of the encoded blocks between the connections of the acquisition server.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "ovasCEncodedBlocks.h"
+
+#include <memory>
+#include <string>
+
+//---------------------------------------------------------------------------------------------------
+class EncodedBlocks_Tests : public testing::Test
+{
+protected:
+	using CEncodedBlocks = OpenViBE::AcquisitionServer::CEncodedBlocks;
+
+	// Buffer of a connection, its content tells how the block was encoded
+	std::shared_ptr<const OpenViBE::CMemoryBuffer> get(const uint64_t nSampleToSkip, const uint64_t stimulationTimeOffset, const bool withChannelUnits)
+	{
+		return m_blocks.get(nSampleToSkip, stimulationTimeOffset, withChannelUnits, [&]()
+		{
+			m_nEncoded++;
+			const std::string content = std::to_string(nSampleToSkip) + "/" + std::to_string(stimulationTimeOffset) + "/" + (withChannelUnits ? "u" : "");
+			auto buffer = std::make_shared<OpenViBE::CMemoryBuffer>();
+			buffer->append(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+			return std::shared_ptr<const OpenViBE::CMemoryBuffer>(buffer);
+		});
+	}
+
+	static std::string content(const std::shared_ptr<const OpenViBE::CMemoryBuffer>& buffer)
+	{
+		return std::string(reinterpret_cast<const char*>(buffer->getDirectPointer()), buffer->getSize());
+	}
+
+	CEncodedBlocks m_blocks;
+	size_t m_nEncoded = 0;
+};
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(EncodedBlocks_Tests, sameViewIsEncodedOnce)
+{
+	const auto first  = get(0, 0, false);
+	const auto second = get(0, 0, false);
+	const auto third  = get(0, 0, false);
+	EXPECT_EQ(1, m_nEncoded);
+	EXPECT_EQ(first, second) << "Connections with the same view don't share their buffer.";
+	EXPECT_EQ(first, third);
+	EXPECT_EQ("0/0/", content(first));
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(EncodedBlocks_Tests, differentViewsAreEncodedApart)
+{
+	const auto reference = get(0, 0, false);
+	const auto shifted   = get(3, 0, false);
+	const auto offset    = get(0, 100, false);
+	const auto units     = get(0, 0, true);
+
+	EXPECT_EQ(4, m_nEncoded);
+	EXPECT_EQ(4, m_blocks.size());
+	EXPECT_EQ("0/0/", content(reference));
+	EXPECT_EQ("3/0/", content(shifted)) << "Connections with different sample shifts share a buffer.";
+	EXPECT_EQ("0/100/", content(offset)) << "Connections with different stimulation offsets share a buffer.";
+	EXPECT_EQ("0/0/u", content(units)) << "Connections with different channel units requests share a buffer.";
+
+	// Later connections reuse the views already encoded
+	EXPECT_EQ(shifted, get(3, 0, false));
+	EXPECT_EQ(units, get(0, 0, true));
+	EXPECT_EQ(4, m_nEncoded);
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(EncodedBlocks_Tests, clearForNextBlock)
+{
+	const auto previous = get(0, 0, false);
+	m_blocks.clear();
+	EXPECT_EQ(0, m_blocks.size());
+
+	// The next block is encoded again, the buffer scheduled for the previous one is still valid
+	const auto next = get(0, 0, false);
+	EXPECT_EQ(2, m_nEncoded);
+	EXPECT_NE(previous, next);
+	EXPECT_EQ("0/0/", content(previous));
+}
+//---------------------------------------------------------------------------------------------------
@@ -0,0 +1,171 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file SampleBufferTests.hpp
+/// \brief Tests for the circular buffer of the samples pending in the acquisition server.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "ovasCSampleBuffer.h"
+
+#include <vector>
+
+//---------------------------------------------------------------------------------------------------
+class SampleBuffer_Tests : public testing::Test
+{
+protected:
+	using CSampleBuffer = OpenViBE::AcquisitionServer::CSampleBuffer;
+
+	// Value of the channel of the n-th sample pushed
+	static float value(const size_t n, const size_t channel) { return float(n * 10 + channel); }
+
+	// Pushes count samples one by one, numbered from first
+	void pushSamples(const size_t first, const size_t count)
+	{
+		std::vector<float> sample(m_nChannel);
+		for (size_t i = first; i < first + count; ++i)
+		{
+			for (size_t j = 0; j < m_nChannel; ++j) { sample[j] = value(i, j); }
+			m_buffer.push(sample.data());
+		}
+	}
+
+	// Checks that the buffer holds the samples numbered from first, in order
+	void expectSamples(const size_t first, const size_t count) const
+	{
+		ASSERT_EQ(count, m_buffer.size());
+		for (size_t i = 0; i < count; ++i)
+		{
+			for (size_t j = 0; j < m_nChannel; ++j) { EXPECT_EQ(value(first + i, j), m_buffer.at(i, j)) << "Sample " << i << ", channel " << j; }
+		}
+	}
+
+	const size_t m_nChannel = 3;
+	CSampleBuffer m_buffer;
+};
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(SampleBuffer_Tests, wraparound)
+{
+	m_buffer.initialize(m_nChannel, 8);
+	EXPECT_TRUE(m_buffer.empty());
+
+	// The samples go around the end of the buffer several times, at most 8 are pending so it never grows
+	size_t first = 0, next = 0;
+	for (size_t step = 0; step < 10; ++step)
+	{
+		pushSamples(next, 5);
+		next += 5;
+		expectSamples(first, next - first);
+		m_buffer.popFront(next - first - 3);
+		first = next - 3;
+	}
+	expectSamples(first, 3);
+
+	// A block copied across the end of the buffer is stored channel by channel
+	std::vector<double> block(m_nChannel * 3);
+	m_buffer.copyBlock(0, 3, block.data());
+	for (size_t j = 0; j < m_nChannel; ++j)
+	{
+		for (size_t i = 0; i < 3; ++i) { EXPECT_EQ(value(first + i, j), block[j * 3 + i]); }
+	}
+
+	std::vector<float> sample(m_nChannel);
+	m_buffer.copySample(2, sample.data());
+	for (size_t j = 0; j < m_nChannel; ++j) { EXPECT_EQ(value(first + 2, j), sample[j]); }
+
+	m_buffer.popFront(100);
+	EXPECT_TRUE(m_buffer.empty());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(SampleBuffer_Tests, growth)
+{
+	// The oldest pending sample is close to the end of the buffer when it has to grow
+	m_buffer.initialize(m_nChannel, 4);
+	pushSamples(0, 3);
+	m_buffer.popFront(2);
+	pushSamples(3, 20);
+	expectSamples(2, 21);
+
+	// Channel by channel push with a channel selection, wrapping around the grown buffer
+	m_buffer.popFront(19);
+	const size_t count = 30;
+	const std::vector<size_t> channels = { 2, 0, 1 };
+	std::vector<float> samples(m_nChannel * count);
+	for (size_t j = 0; j < m_nChannel; ++j)
+	{
+		for (size_t i = 0; i < count; ++i) { samples[j * count + i] = value(100 + i, j); }
+	}
+	m_buffer.push(samples.data(), count, channels);
+
+	ASSERT_EQ(2 + count, m_buffer.size());
+	for (size_t i = 0; i < count; ++i)
+	{
+		for (size_t j = 0; j < m_nChannel; ++j) { EXPECT_EQ(value(100 + i, channels[j]), m_buffer.at(2 + i, j)); }
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(SampleBuffer_Tests, popBack)
+{
+	m_buffer.initialize(m_nChannel, 8);
+	pushSamples(0, 6);
+	m_buffer.popFront(4);
+	pushSamples(6, 5);
+
+	// The most recent samples are removed, across the end of the buffer
+	m_buffer.popBack(4);
+	expectSamples(4, 3);
+	pushSamples(7, 2);
+	expectSamples(4, 5);
+
+	m_buffer.popBack(10);
+	EXPECT_TRUE(m_buffer.empty());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(SampleBuffer_Tests, driftPadding)
+{
+	// The drift correction pads the pending samples with a sample repeated, which may exceed the room left
+	m_buffer.initialize(m_nChannel, 8);
+	pushSamples(0, 6);
+	m_buffer.popFront(5);
+	const std::vector<float> padding = { -1, -2, -3 };
+	m_buffer.push(padding.data(), 12);
+
+	ASSERT_EQ(13, m_buffer.size());
+	for (size_t j = 0; j < m_nChannel; ++j) { EXPECT_EQ(value(5, j), m_buffer.at(0, j)); }
+	for (size_t i = 1; i < 13; ++i)
+	{
+		for (size_t j = 0; j < m_nChannel; ++j) { EXPECT_EQ(padding[j], m_buffer.at(i, j)) << "Padding sample " << i; }
+	}
+
+	m_buffer.clear();
+	EXPECT_TRUE(m_buffer.empty());
+	EXPECT_EQ(m_nChannel, m_buffer.getChannelCount());
+}
+//---------------------------------------------------------------------------------------------------
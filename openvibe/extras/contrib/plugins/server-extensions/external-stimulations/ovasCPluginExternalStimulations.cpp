@@ -49,7 +49,7 @@ bool CPluginExternalStimulations::startHook(const std::vector<CString>& /*select
 	return true;
 }
 
-void CPluginExternalStimulations::loopHook(std::deque<std::vector<float>>& /* vPendingBuffer */, CStimulationSet& stimulationSet, const uint64_t start, const uint64_t end, const uint64_t /* sampleTime */)
+void CPluginExternalStimulations::loopHook(CSampleBuffer& /* pendingBuffer */, CStimulationSet& stimulationSet, const uint64_t start, const uint64_t end, const uint64_t /* sampleTime */)
 {
 	if (m_IsExternalStimulationsEnabled)
 	{
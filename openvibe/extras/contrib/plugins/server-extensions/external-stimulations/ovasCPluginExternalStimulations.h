@@ -32,7 +32,7 @@ public:
 
 	bool startHook(const std::vector<CString>& selectedChannelNames, const size_t sampling, const size_t nChannel, const size_t nSamplePerSentBlock) override;
 	void stopHook() override;
-	void loopHook(std::deque<std::vector<float>>& vPendingBuffer, CStimulationSet& stimulationSet, const uint64_t start, const uint64_t end,
+	void loopHook(CSampleBuffer& pendingBuffer, CStimulationSet& stimulationSet, const uint64_t start, const uint64_t end,
 				  const uint64_t sampleTime) override;
 	void acceptNewConnectionHook() override { m_ExternalStimulations.clear(); }
 
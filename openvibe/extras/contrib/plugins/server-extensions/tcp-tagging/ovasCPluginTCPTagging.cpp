@@ -49,7 +49,7 @@ bool CPluginTCPTagging::startHook(const std::vector<CString>& /*vSelectedChannel
 void CPluginTCPTagging::stopHook() { m_scopedTagStream.reset(); }
 
 // n.b. With this version of tcp tagging, all the timestamps are in fixed point
-void CPluginTCPTagging::loopHook(std::deque<std::vector<float>>& /*vPendingBuffer*/,
+void CPluginTCPTagging::loopHook(CSampleBuffer& /*pendingBuffer*/,
 								 CStimulationSet& stimulationSet, uint64_t /*start*/, uint64_t /*end*/, const uint64_t sampleTime)
 {
 	const uint64_t clockTime = System::Time::zgetTimeRaw(false);
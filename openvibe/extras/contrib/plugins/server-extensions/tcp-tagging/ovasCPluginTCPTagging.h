@@ -38,7 +38,7 @@ public:
 	void stopHook() override;
 
 	// Overrides virtual method loopHook inherited from class IAcquisitionServerPlugin.
-	void loopHook(std::deque<std::vector<float>>& vPendingBuffer, CStimulationSet& stimulationSet, const uint64_t start, const uint64_t end,
+	void loopHook(CSampleBuffer& pendingBuffer, CStimulationSet& stimulationSet, const uint64_t start, const uint64_t end,
 				  const uint64_t sampleTime) override;
 
 private:
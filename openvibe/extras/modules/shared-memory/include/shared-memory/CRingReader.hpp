@@ -0,0 +1,99 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CRingReader.hpp
+/// \brief Reader of the rings of a shared memory segment, for the processes consuming the SharedMemoryWriter box output.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Ring.hpp"
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <string>
+#include <vector>
+
+namespace OpenViBE {
+namespace SharedMemory {
+/// <summary> Reads the chunks written to a shared memory segment by another process, see <see cref="Ring.hpp"/> for the layout. </summary>
+/// <remarks>
+/// Each reader keeps its own cursor per stream, the index of the next chunk to read, and never blocks the writer.
+/// A reader which falls more than a ring behind the writer is told so and its cursor skips the chunks it lost.
+/// A typical loop starts with the cursor at <see cref="getWriteCount"/> to receive only new chunks, and polls the streams.
+/// </remarks>
+class CRingReader final
+{
+public:
+	enum class EStatus
+	{
+		Ok,			// A chunk was read and the cursor moved to the next one
+		NoData,		// The cursor is at the last chunk written, or the stream does not have the type read
+		Overrun		// The writer overwrote the chunk at the cursor, which moved to the oldest chunk still available
+	};
+
+	/// <summary> A chunk read from a stream. </summary>
+	template <typename T>
+	struct SChunk
+	{
+		uint64_t startTime = 0;
+		uint64_t endTime   = 0;
+		std::vector<T> values;	// Kept by the caller from one read to the next to avoid allocations
+	};
+
+	CRingReader() = default;
+	CRingReader(const CRingReader&) = delete;
+	CRingReader& operator=(const CRingReader&) = delete;
+
+	/// <summary> Opens a segment. </summary>
+	/// <returns> <c>false</c> if the segment does not exist, is not ready yet or does not have this layout. </returns>
+	bool open(const std::string& name);
+	void close();
+
+	bool isOpen() const { return m_header != nullptr; }
+
+	/// <summary> Tells if the writer closed the segment, the chunks written before can still be read. </summary>
+	bool isClosed() const { return m_header && m_header->state.load(std::memory_order_acquire) == uint32_t(ERingState::Closed); }
+
+	size_t getStreamCount() const { return m_header ? m_header->nStream : 0; }
+	const SStreamHeader& getStream(const size_t stream) const { return m_streams[stream]; }
+
+	/// <summary> Gets the index of a stream from its name, or the stream count if there is none. </summary>
+	size_t findStream(const std::string& name) const;
+
+	/// <summary> Gets the number of chunks written to a stream so far. </summary>
+	uint64_t getWriteCount(const size_t stream) const { return m_streams[stream].writeCount.load(std::memory_order_acquire); }
+
+	/// <summary> Reads the chunk at the cursor of a matrix stream, its values are stored row by row. </summary>
+	EStatus readMatrix(size_t stream, uint64_t& cursor, SChunk<double>& chunk) const;
+
+	/// <summary> Reads the chunk at the cursor of a stimulation stream, large stimulation sets take several chunks with the same dates. </summary>
+	EStatus readStimulations(size_t stream, uint64_t& cursor, SChunk<SStimulation>& chunk) const;
+
+private:
+	template <typename T>
+	EStatus read(size_t stream, EStreamType type, uint64_t& cursor, SChunk<T>& chunk) const;
+
+	boost::interprocess::mapped_region m_region;
+	const SSegmentHeader* m_header = nullptr;
+	const SStreamHeader* m_streams = nullptr;
+};
+}  // namespace SharedMemory
+}  // namespace OpenViBE
@@ -0,0 +1,92 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CRingWriter.hpp
+/// \brief Writer of the rings of a shared memory segment.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Ring.hpp"
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <string>
+#include <vector>
+
+namespace OpenViBE {
+namespace SharedMemory {
+/// <summary> Creates a shared memory segment and writes chunks to its rings, see <see cref="Ring.hpp"/> for the layout. </summary>
+/// <remarks> Only one writer can use a segment, writing never blocks and never allocates memory. </remarks>
+class CRingWriter final
+{
+public:
+	/// <summary> Description of a stream given to <see cref="create"/>. </summary>
+	struct SStream
+	{
+		std::string name;
+		uint64_t typeID = 0;
+		EStreamType type = EStreamType::Matrix;
+		size_t nRow = 0;	// Dimensions of the matrices
+		size_t nCol = 0;
+		size_t nSlot = 0;	// Number of slots, 0 to size the ring to about RING_DEFAULT_SIZE bytes
+	};
+
+	/// <summary> Default size of the ring of a stream, within the slot count bounds. </summary>
+	static constexpr size_t RING_DEFAULT_SIZE = 16 << 20;
+	static constexpr size_t RING_MIN_SLOT     = 16;
+	static constexpr size_t RING_MAX_SLOT     = 1024;
+
+	CRingWriter() = default;
+	CRingWriter(const CRingWriter&) = delete;
+	CRingWriter& operator=(const CRingWriter&) = delete;
+	~CRingWriter() { close(); }
+
+	/// <summary> Replaces any segment of the same name by a new one holding a ring per stream. </summary>
+	/// <returns> <c>false</c> if the segment could not be created, in which case <see cref="getLastError"/> describes why. </returns>
+	bool create(const std::string& name, const std::vector<SStream>& streams);
+
+	/// <summary> Marks the segment as closed for the readers and removes it, the readers which opened it can still read what was written. </summary>
+	void close();
+
+	bool isOpen() const { return m_header != nullptr; }
+	const std::string& getLastError() const { return m_lastError; }
+
+	/// <summary> Writes a matrix to the next slot of a stream, overwriting the oldest chunk when the ring is full. </summary>
+	/// <returns> <c>false</c> if the matrix does not have the dimensions given at creation. </returns>
+	bool writeMatrix(size_t stream, uint64_t startTime, uint64_t endTime, const double* values, size_t size);
+
+	/// <summary> Writes stimulations to the next slots of a stream, using as many as needed to hold them all. </summary>
+	void writeStimulations(size_t stream, uint64_t startTime, uint64_t endTime, const SStimulation* stimulations, size_t size);
+
+private:
+	// Starts and ends the write of the next chunk of a stream, returns the payload of its slot
+	uint8_t* beginSlot(SStreamHeader& stream, uint64_t startTime, uint64_t endTime, uint64_t size);
+	void endSlot(SStreamHeader& stream);
+
+	std::string m_name;
+	std::string m_lastError;
+	boost::interprocess::mapped_region m_region;
+	SSegmentHeader* m_header = nullptr;
+	SStreamHeader* m_streams = nullptr;
+	SSlotHeader* m_slot      = nullptr;	// Slot being written
+};
+}  // namespace SharedMemory
+}  // namespace OpenViBE
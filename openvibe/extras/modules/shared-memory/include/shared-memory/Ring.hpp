@@ -0,0 +1,102 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file Ring.hpp
+/// \brief Layout of the shared memory segment written by the SharedMemoryWriter box.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace OpenViBE {
+namespace SharedMemory {
+/// <summary> Layout of a segment. </summary>
+/// <remarks>
+/// A segment starts with a <see cref="SSegmentHeader"/>, followed by one <see cref="SStreamHeader"/> per input of the box,
+/// then by the slots of each stream. A stream is a ring of fixed size slots written by a single process and read by any number
+/// of processes without lock: the n-th chunk of a stream (from 0) is written in the slot n modulo the slot count,
+/// whose sequence is odd while it is written and <c>2 * (n + 1)</c> once it is complete.
+/// A reader copies a slot then checks that its sequence did not change, otherwise the writer has overrun it.
+/// All the values are in the byte order of the machine.
+/// </remarks>
+
+constexpr uint32_t RING_MAGIC   = 0x5253564F;	// "OVSR" in little endian
+constexpr uint32_t RING_VERSION = 1;
+constexpr size_t RING_ALIGNMENT = 64;			// Headers and slots start on their own cache line
+constexpr size_t RING_NAME_SIZE = 32;
+
+/// <summary> Maximum number of stimulations in a slot, larger stimulation sets are split in consecutive slots with the same dates. </summary>
+constexpr size_t RING_MAX_STIMULATION = 32;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The ring needs lock free 64 bits atomics to be shared between processes");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "The ring needs lock free 32 bits atomics to be shared between processes");
+
+enum class ERingState : uint32_t { Building = 0, Ready = 1, Closed = 2 };
+
+enum class EStreamType : uint32_t { Matrix = 0, Stimulations = 1 };
+
+struct alignas(RING_ALIGNMENT) SSegmentHeader
+{
+	std::atomic<uint32_t> state;	// ERingState, the rest of the segment can be read once it is Ready
+	uint32_t magic;
+	uint32_t version;
+	uint32_t nStream;
+	uint64_t size;					// Total size of the segment in bytes
+};
+
+struct alignas(RING_ALIGNMENT) SStreamHeader
+{
+	char name[RING_NAME_SIZE];		// "Matrix<input index>" or "Stimuli<input index>", null terminated
+	uint64_t typeID;				// OpenViBE identifier of the input type
+	uint32_t type;					// EStreamType
+	uint32_t nSlot;
+	uint64_t slotSize;				// Size of a slot in bytes, header included
+	uint64_t offset;				// Offset of the first slot from the start of the segment
+	uint32_t nRow;					// Size of the first dimension of the matrices, 0 for stimulations
+	uint32_t nCol;					// Product of the sizes of the other dimensions of the matrices, 0 for stimulations
+	alignas(RING_ALIGNMENT) std::atomic<uint64_t> writeCount;	// Number of complete chunks written to the stream
+};
+
+struct alignas(RING_ALIGNMENT) SSlotHeader
+{
+	std::atomic<uint64_t> sequence;
+	uint64_t startTime;				// Dates of the chunk, in OpenViBE fixed point time
+	uint64_t endTime;
+	uint64_t size;					// Number of values of a matrix or of stimulations, the payload follows the header
+};
+
+/// <summary> A stimulation in the payload of a slot. </summary>
+struct SStimulation
+{
+	uint64_t id;
+	uint64_t date;
+	uint64_t duration;
+};
+
+/// <summary> Size of a slot holding a payload, rounded up to keep the following slot aligned. </summary>
+constexpr size_t slotSize(const size_t payloadSize)
+{
+	return (sizeof(SSlotHeader) + payloadSize + RING_ALIGNMENT - 1) / RING_ALIGNMENT * RING_ALIGNMENT;
+}
+}  // namespace SharedMemory
+}  // namespace OpenViBE
@@ -0,0 +1,132 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CRingReader.cpp
+/// \brief Reader of the rings of a shared memory segment, for the processes consuming the SharedMemoryWriter box output.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#include "CRingReader.hpp"
+
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace OpenViBE {
+namespace SharedMemory {
+
+//---------------------------------------------------------------------------------------------------
+bool CRingReader::open(const std::string& name)
+{
+	close();
+
+	try {
+		const boost::interprocess::shared_memory_object shm(boost::interprocess::open_only, name.c_str(), boost::interprocess::read_only);
+		boost::interprocess::mapped_region(shm, boost::interprocess::read_only).swap(m_region);
+	}
+	catch (const boost::interprocess::interprocess_exception&) { return false; }
+
+	const uint8_t* base  = static_cast<const uint8_t*>(m_region.get_address());
+	const size_t size    = m_region.get_size();
+	const auto* header   = reinterpret_cast<const SSegmentHeader*>(base);
+	const auto* streams  = reinterpret_cast<const SStreamHeader*>(base + sizeof(SSegmentHeader));
+	bool valid           = size >= sizeof(SSegmentHeader) && header->state.load(std::memory_order_acquire) != uint32_t(ERingState::Building)
+						   && header->magic == RING_MAGIC && header->version == RING_VERSION && header->size <= size
+						   && sizeof(SSegmentHeader) + header->nStream * sizeof(SStreamHeader) <= size;
+	for (size_t i = 0; valid && i < header->nStream; ++i) {
+		const SStreamHeader& s = streams[i];
+		valid                  = s.nSlot != 0 && s.slotSize >= sizeof(SSlotHeader) && s.offset + s.nSlot * s.slotSize <= size;
+	}
+	if (!valid) {
+		close();
+		return false;
+	}
+
+	m_header  = header;
+	m_streams = streams;
+	return true;
+}
+
+//---------------------------------------------------------------------------------------------------
+void CRingReader::close()
+{
+	boost::interprocess::mapped_region().swap(m_region);
+	m_header  = nullptr;
+	m_streams = nullptr;
+}
+
+//---------------------------------------------------------------------------------------------------
+size_t CRingReader::findStream(const std::string& name) const
+{
+	for (size_t i = 0; i < getStreamCount(); ++i) { if (std::strncmp(m_streams[i].name, name.c_str(), RING_NAME_SIZE) == 0) { return i; } }
+	return getStreamCount();
+}
+
+//---------------------------------------------------------------------------------------------------
+CRingReader::EStatus CRingReader::readMatrix(const size_t stream, uint64_t& cursor, SChunk<double>& chunk) const
+{
+	return read(stream, EStreamType::Matrix, cursor, chunk);
+}
+
+//---------------------------------------------------------------------------------------------------
+CRingReader::EStatus CRingReader::readStimulations(const size_t stream, uint64_t& cursor, SChunk<SStimulation>& chunk) const
+{
+	return read(stream, EStreamType::Stimulations, cursor, chunk);
+}
+
+//---------------------------------------------------------------------------------------------------
+template <typename T>
+CRingReader::EStatus CRingReader::read(const size_t stream, const EStreamType type, uint64_t& cursor, SChunk<T>& chunk) const
+{
+	const SStreamHeader& s = m_streams[stream];
+	if (s.type != uint32_t(type)) { return EStatus::NoData; }
+
+	// Skips to the oldest chunk still in the ring, always moving forward
+	const auto overrun = [&]()
+	{
+		const uint64_t nWritten = s.writeCount.load(std::memory_order_acquire);
+		cursor                  = std::max(cursor + 1, nWritten > s.nSlot ? nWritten - s.nSlot : 0);
+		return EStatus::Overrun;
+	};
+
+	const uint64_t nWritten = s.writeCount.load(std::memory_order_acquire);
+	if (cursor >= nWritten) { return EStatus::NoData; }
+	if (nWritten - cursor > s.nSlot) { return overrun(); }
+
+	const uint8_t* slot      = static_cast<const uint8_t*>(m_region.get_address()) + s.offset + (cursor % s.nSlot) * s.slotSize;
+	const auto* header       = reinterpret_cast<const SSlotHeader*>(slot);
+	const uint64_t sequence  = header->sequence.load(std::memory_order_acquire);
+	if (sequence != 2 * (cursor + 1)) { return overrun(); }
+
+	// The copy is only valid if the writer did not start to overwrite the slot meanwhile
+	const size_t capacity = (s.slotSize - sizeof(SSlotHeader)) / sizeof(T);
+	chunk.startTime       = header->startTime;
+	chunk.endTime         = header->endTime;
+	chunk.values.resize(std::min<size_t>(header->size, capacity));
+	std::memcpy(chunk.values.data(), slot + sizeof(SSlotHeader), chunk.values.size() * sizeof(T));
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (header->sequence.load(std::memory_order_relaxed) != sequence) { return overrun(); }
+
+	cursor++;
+	return EStatus::Ok;
+}
+
+}  // namespace SharedMemory
+}  // namespace OpenViBE
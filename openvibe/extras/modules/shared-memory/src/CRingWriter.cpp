@@ -0,0 +1,169 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CRingWriter.cpp
+/// \brief Writer of the rings of a shared memory segment.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#include "CRingWriter.hpp"
+
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace OpenViBE {
+namespace SharedMemory {
+
+//---------------------------------------------------------------------------------------------------
+bool CRingWriter::create(const std::string& name, const std::vector<SStream>& streams)
+{
+	close();
+
+	// Places the slots of the streams one after the other, after the headers
+	std::vector<SStreamHeader> headers(streams.size());
+	uint64_t size = sizeof(SSegmentHeader) + streams.size() * sizeof(SStreamHeader);
+	for (size_t i = 0; i < streams.size(); ++i) {
+		const SStream& s = streams[i];
+		SStreamHeader& h = headers[i];
+		if (s.name.size() >= RING_NAME_SIZE) {
+			m_lastError = "Stream name [" + s.name + "] is too long";
+			return false;
+		}
+		std::strncpy(h.name, s.name.c_str(), RING_NAME_SIZE);
+		h.typeID = s.typeID;
+		h.type   = uint32_t(s.type);
+		if (s.type == EStreamType::Matrix) {
+			h.nRow     = uint32_t(s.nRow);
+			h.nCol     = uint32_t(s.nCol);
+			h.slotSize = slotSize(s.nRow * s.nCol * sizeof(double));
+		}
+		else { h.slotSize = slotSize(RING_MAX_STIMULATION * sizeof(SStimulation)); }
+		h.nSlot  = uint32_t(s.nSlot != 0 ? s.nSlot : std::clamp<size_t>(RING_DEFAULT_SIZE / h.slotSize, RING_MIN_SLOT, RING_MAX_SLOT));
+		h.offset = size;
+		size += h.nSlot * h.slotSize;
+	}
+
+	try {
+		boost::interprocess::shared_memory_object::remove(name.c_str());
+		boost::interprocess::shared_memory_object shm(boost::interprocess::create_only, name.c_str(), boost::interprocess::read_write);
+		shm.truncate(boost::interprocess::offset_t(size));
+		boost::interprocess::mapped_region(shm, boost::interprocess::read_write).swap(m_region);
+	}
+	catch (const boost::interprocess::interprocess_exception& e) {
+		m_lastError = e.what();
+		boost::interprocess::shared_memory_object::remove(name.c_str());
+		return false;
+	}
+
+	// The readers wait for the state to be ready before reading anything else
+	uint8_t* base = static_cast<uint8_t*>(m_region.get_address());
+	m_header      = new(base) SSegmentHeader();
+	m_streams     = reinterpret_cast<SStreamHeader*>(base + sizeof(SSegmentHeader));
+	for (size_t i = 0; i < streams.size(); ++i) {
+		const SStreamHeader& h = headers[i];
+		SStreamHeader* stream  = new(m_streams + i) SStreamHeader();
+		std::memcpy(stream->name, h.name, RING_NAME_SIZE);
+		stream->typeID   = h.typeID;
+		stream->type     = h.type;
+		stream->nSlot    = h.nSlot;
+		stream->slotSize = h.slotSize;
+		stream->offset   = h.offset;
+		stream->nRow     = h.nRow;
+		stream->nCol     = h.nCol;
+		stream->writeCount.store(0, std::memory_order_relaxed);
+		for (size_t j = 0; j < h.nSlot; ++j) { new(base + h.offset + j * h.slotSize) SSlotHeader(); }
+	}
+	m_header->magic   = RING_MAGIC;
+	m_header->version = RING_VERSION;
+	m_header->nStream = uint32_t(streams.size());
+	m_header->size    = size;
+	m_header->state.store(uint32_t(ERingState::Ready), std::memory_order_release);
+
+	m_name = name;
+	return true;
+}
+
+//---------------------------------------------------------------------------------------------------
+void CRingWriter::close()
+{
+	if (!m_header) { return; }
+	m_header->state.store(uint32_t(ERingState::Closed), std::memory_order_release);
+	boost::interprocess::mapped_region().swap(m_region);
+	boost::interprocess::shared_memory_object::remove(m_name.c_str());
+	m_header  = nullptr;
+	m_streams = nullptr;
+	m_slot    = nullptr;
+}
+
+//---------------------------------------------------------------------------------------------------
+bool CRingWriter::writeMatrix(const size_t stream, const uint64_t startTime, const uint64_t endTime, const double* values, const size_t size)
+{
+	SStreamHeader& s = m_streams[stream];
+	if (s.type != uint32_t(EStreamType::Matrix) || size != size_t(s.nRow) * s.nCol) { return false; }
+
+	uint8_t* payload = beginSlot(s, startTime, endTime, size);
+	std::memcpy(payload, values, size * sizeof(double));
+	endSlot(s);
+	return true;
+}
+
+//---------------------------------------------------------------------------------------------------
+void CRingWriter::writeStimulations(const size_t stream, const uint64_t startTime, const uint64_t endTime, const SStimulation* stimulations,
+									const size_t size)
+{
+	SStreamHeader& s = m_streams[stream];
+	if (s.type != uint32_t(EStreamType::Stimulations)) { return; }
+
+	for (size_t i = 0; i < size; i += RING_MAX_STIMULATION) {
+		const size_t n   = std::min(size - i, RING_MAX_STIMULATION);
+		uint8_t* payload = beginSlot(s, startTime, endTime, n);
+		std::memcpy(payload, stimulations + i, n * sizeof(SStimulation));
+		endSlot(s);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------
+uint8_t* CRingWriter::beginSlot(SStreamHeader& stream, const uint64_t startTime, const uint64_t endTime, const uint64_t size)
+{
+	const uint64_t n = stream.writeCount.load(std::memory_order_relaxed);
+	uint8_t* slot    = reinterpret_cast<uint8_t*>(m_header) + stream.offset + (n % stream.nSlot) * stream.slotSize;
+	m_slot           = reinterpret_cast<SSlotHeader*>(slot);
+
+	// The odd sequence must be visible before any change of the slot content
+	m_slot->sequence.store(2 * n + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	m_slot->startTime = startTime;
+	m_slot->endTime   = endTime;
+	m_slot->size      = size;
+	return slot + sizeof(SSlotHeader);
+}
+
+//---------------------------------------------------------------------------------------------------
+void CRingWriter::endSlot(SStreamHeader& stream)
+{
+	const uint64_t n = stream.writeCount.load(std::memory_order_relaxed);
+	m_slot->sequence.store(2 * (n + 1), std::memory_order_release);
+	stream.writeCount.store(n + 1, std::memory_order_release);
+}
+
+}  // namespace SharedMemory
+}  // namespace OpenViBE
@@ -0,0 +1,205 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file RingTests.hpp
+/// \brief Tests for the writer and the reader of the rings of a shared memory segment.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "shared-memory/CRingReader.hpp"
+#include "shared-memory/CRingWriter.hpp"
+
+#include <string>
+#include <vector>
+
+//---------------------------------------------------------------------------------------------------
+class Ring_Tests : public testing::Test
+{
+protected:
+	using CRingReader = OpenViBE::SharedMemory::CRingReader;
+	using CRingWriter = OpenViBE::SharedMemory::CRingWriter;
+
+	// A matrix stream of 2 x 3 values and a stimulation stream, both with few slots to be overrun quickly
+	void SetUp() override
+	{
+		CRingWriter::SStream matrix;
+		matrix.name   = "Matrix0";
+		matrix.typeID = 1;
+		matrix.type   = OpenViBE::SharedMemory::EStreamType::Matrix;
+		matrix.nRow   = m_nRow;
+		matrix.nCol   = m_nCol;
+		matrix.nSlot  = m_nSlot;
+
+		CRingWriter::SStream stimulations;
+		stimulations.name   = "Stimuli1";
+		stimulations.typeID = 2;
+		stimulations.type   = OpenViBE::SharedMemory::EStreamType::Stimulations;
+		stimulations.nSlot  = m_nSlot;
+
+		ASSERT_TRUE(m_writer.create(m_name, { matrix, stimulations })) << m_writer.getLastError();
+		ASSERT_TRUE(m_reader.open(m_name));
+		ASSERT_EQ(2, m_reader.getStreamCount());
+		m_matrix       = m_reader.findStream("Matrix0");
+		m_stimulations = m_reader.findStream("Stimuli1");
+		ASSERT_EQ(0, m_matrix);
+		ASSERT_EQ(1, m_stimulations);
+	}
+
+	void TearDown() override
+	{
+		m_reader.close();
+		m_writer.close();
+	}
+
+	// The values of the n-th matrix written
+	std::vector<double> makeMatrix(const size_t n) const
+	{
+		std::vector<double> values(m_nRow * m_nCol);
+		for (size_t i = 0; i < values.size(); ++i) { values[i] = double(n * 100 + i); }
+		return values;
+	}
+
+	const std::string m_name = "openvibe-test-module-shared-memory";
+	const size_t m_nRow      = 2;
+	const size_t m_nCol      = 3;
+	const size_t m_nSlot     = 4;
+	CRingWriter m_writer;
+	CRingReader m_reader;
+	size_t m_matrix       = 0;
+	size_t m_stimulations = 0;
+};
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Ring_Tests, roundTrip)
+{
+	uint64_t cursor = m_reader.getWriteCount(m_matrix);
+	CRingReader::SChunk<double> chunk;
+	EXPECT_EQ(CRingReader::EStatus::NoData, m_reader.readMatrix(m_matrix, cursor, chunk));
+
+	for (size_t i = 0; i < 3; ++i) {
+		const std::vector<double> values = makeMatrix(i);
+		ASSERT_TRUE(m_writer.writeMatrix(m_matrix, i, i + 1, values.data(), values.size()));
+	}
+	EXPECT_EQ(3, m_reader.getWriteCount(m_matrix));
+
+	for (size_t i = 0; i < 3; ++i) {
+		ASSERT_EQ(CRingReader::EStatus::Ok, m_reader.readMatrix(m_matrix, cursor, chunk)) << "Chunk " << i << " can't be read.";
+		EXPECT_EQ(i, chunk.startTime);
+		EXPECT_EQ(i + 1, chunk.endTime);
+		EXPECT_EQ(makeMatrix(i), chunk.values) << "Chunk " << i << " isn't read as written.";
+	}
+	EXPECT_EQ(3, cursor);
+	EXPECT_EQ(CRingReader::EStatus::NoData, m_reader.readMatrix(m_matrix, cursor, chunk));
+
+	// Reading a stream with the wrong type gives nothing
+	CRingReader::SChunk<OpenViBE::SharedMemory::SStimulation> stimulations;
+	cursor = 0;
+	EXPECT_EQ(CRingReader::EStatus::NoData, m_reader.readStimulations(m_matrix, cursor, stimulations));
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Ring_Tests, overrun)
+{
+	// The writer wraps around the ring twice while the reader waits at the first chunk
+	uint64_t cursor = 0;
+	for (size_t i = 0; i < 2 * m_nSlot + 1; ++i) {
+		const std::vector<double> values = makeMatrix(i);
+		ASSERT_TRUE(m_writer.writeMatrix(m_matrix, i, i + 1, values.data(), values.size()));
+	}
+
+	CRingReader::SChunk<double> chunk;
+	EXPECT_EQ(CRingReader::EStatus::Overrun, m_reader.readMatrix(m_matrix, cursor, chunk));
+	const uint64_t oldest = 2 * m_nSlot + 1 - m_nSlot;
+	EXPECT_EQ(oldest, cursor) << "Overrun reader doesn't jump to the oldest chunk still in the ring.";
+
+	for (uint64_t i = oldest; i < 2 * m_nSlot + 1; ++i) {
+		ASSERT_EQ(CRingReader::EStatus::Ok, m_reader.readMatrix(m_matrix, cursor, chunk));
+		EXPECT_EQ(i, chunk.startTime);
+		EXPECT_EQ(makeMatrix(size_t(i)), chunk.values);
+	}
+	EXPECT_EQ(CRingReader::EStatus::NoData, m_reader.readMatrix(m_matrix, cursor, chunk));
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Ring_Tests, stimulationSplit)
+{
+	// A set larger than a slot takes consecutive slots with the same dates
+	const size_t size = OpenViBE::SharedMemory::RING_MAX_STIMULATION * 2 + 5;
+	std::vector<OpenViBE::SharedMemory::SStimulation> written(size);
+	for (size_t i = 0; i < size; ++i) { written[i] = { 0x8100 + i, i, 0 }; }
+
+	uint64_t cursor = m_reader.getWriteCount(m_stimulations);
+	m_writer.writeStimulations(m_stimulations, 10, 20, written.data(), written.size());
+	EXPECT_EQ(3, m_reader.getWriteCount(m_stimulations));
+
+	std::vector<OpenViBE::SharedMemory::SStimulation> read;
+	CRingReader::SChunk<OpenViBE::SharedMemory::SStimulation> chunk;
+	while (m_reader.readStimulations(m_stimulations, cursor, chunk) == CRingReader::EStatus::Ok) {
+		EXPECT_EQ(10, chunk.startTime);
+		EXPECT_EQ(20, chunk.endTime);
+		EXPECT_LE(chunk.values.size(), OpenViBE::SharedMemory::RING_MAX_STIMULATION);
+		read.insert(read.end(), chunk.values.begin(), chunk.values.end());
+	}
+
+	ASSERT_EQ(size, read.size()) << "Stimulations are lost when split between slots.";
+	for (size_t i = 0; i < size; ++i) {
+		EXPECT_EQ(written[i].id, read[i].id);
+		EXPECT_EQ(written[i].date, read[i].date);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Ring_Tests, wrongMatrixSize)
+{
+	const std::vector<double> values(m_nRow * m_nCol + 1, 1.0);
+	EXPECT_FALSE(m_writer.writeMatrix(m_matrix, 0, 1, values.data(), values.size())) << "Matrix larger than the stream is written.";
+	EXPECT_FALSE(m_writer.writeMatrix(m_matrix, 0, 1, values.data(), m_nRow)) << "Matrix smaller than the stream is written.";
+	EXPECT_FALSE(m_writer.writeMatrix(m_stimulations, 0, 1, values.data(), m_nRow * m_nCol)) << "Matrix is written to a stimulation stream.";
+	EXPECT_EQ(0, m_reader.getWriteCount(m_matrix));
+	EXPECT_EQ(0, m_reader.getWriteCount(m_stimulations));
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Ring_Tests, closed)
+{
+	const std::vector<double> values = makeMatrix(0);
+	ASSERT_TRUE(m_writer.writeMatrix(m_matrix, 0, 1, values.data(), values.size()));
+	EXPECT_FALSE(m_reader.isClosed());
+
+	// The chunks written before the writer closed the segment can still be read
+	m_writer.close();
+	EXPECT_TRUE(m_reader.isClosed());
+	uint64_t cursor = 0;
+	CRingReader::SChunk<double> chunk;
+	ASSERT_EQ(CRingReader::EStatus::Ok, m_reader.readMatrix(m_matrix, cursor, chunk));
+	EXPECT_EQ(values, chunk.values);
+
+	// The segment is removed, it can not be opened anymore
+	CRingReader other;
+	EXPECT_FALSE(other.open(m_name));
+}
+//---------------------------------------------------------------------------------------------------
@@ -0,0 +1,102 @@
+#include "ovpCAcquisitionReceiver.h"
+
+#include <algorithm>
+
+namespace OpenViBE {
+namespace Plugins {
+namespace Acquisition {
+
+namespace {
+// Time the thread waits for data or for a free slot before checking whether it should stop, in ms
+constexpr size_t POLLING_PERIOD = 100;
+}  // namespace
+
+void CAcquisitionReceiver::start(Socket::IConnection& connection)
+{
+	stop();
+	m_connection = &connection;
+	m_stop       = false;
+	m_error      = EError::None;
+	m_thread     = std::thread(&CAcquisitionReceiver::run, this);
+}
+
+void CAcquisitionReceiver::stop()
+{
+	if (!m_thread.joinable()) { return; }
+	m_stop = true;
+	m_thread.join();
+	m_connection = nullptr;
+}
+
+CMemoryBuffer* CAcquisitionReceiver::front()
+{
+	const size_t head = m_head.load(std::memory_order_relaxed);
+	const size_t tail = m_tail.load(std::memory_order_acquire);
+	if (head == tail) { return nullptr; }
+
+	slot_t& slot    = m_slots[head % m_slots.size()];
+	m_maxQueueSize  = std::max(m_maxQueueSize, tail - head);
+	m_maxQueueDelay = std::max(m_maxQueueDelay, std::chrono::duration<double>(std::chrono::steady_clock::now() - slot.time).count());
+	return &slot.buffer;
+}
+
+void CAcquisitionReceiver::pop()
+{
+	m_nReceived++;
+	m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void CAcquisitionReceiver::run()
+{
+	while (!m_stop) {
+		// Waits for the box to release a slot
+		const size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) == m_slots.size()) {
+			m_nFullQueue.fetch_add(1, std::memory_order_relaxed);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		slot_t& slot  = m_slots[tail % m_slots.size()];
+		uint64_t size = 0;
+		if (!receive(&size, sizeof(size))) {
+			if (!m_stop) { m_error.store(EError::Size, std::memory_order_release); }
+			return;
+		}
+		if (!slot.buffer.setSize(size_t(size), true)) {
+			m_failedSize = size_t(size);
+			m_error.store(EError::Allocation, std::memory_order_release);
+			return;
+		}
+		if (!receive(slot.buffer.getDirectPointer(), size_t(size))) {
+			m_failedSize = size_t(size);
+			if (!m_stop) { m_error.store(EError::Content, std::memory_order_release); }
+			return;
+		}
+
+		slot.time = std::chrono::steady_clock::now();
+		m_tail.store(tail + 1, std::memory_order_release);
+	}
+}
+
+bool CAcquisitionReceiver::receive(void* buffer, const size_t size)
+{
+	uint8_t* data = static_cast<uint8_t*>(buffer);
+	size_t left   = size;
+	while (left != 0) {
+		if (m_stop) { return false; }
+		if (!m_connection->isReadyToReceive(POLLING_PERIOD)) {
+			if (!m_connection->isConnected()) { return false; }
+			continue;
+		}
+		const size_t n = m_connection->receiveBuffer(data, left);
+		if (n == 0) { return false; }
+		data += n;
+		left -= n;
+	}
+	return true;
+}
+
+}  // namespace Acquisition
+}  // namespace Plugins
+}  // namespace OpenViBE
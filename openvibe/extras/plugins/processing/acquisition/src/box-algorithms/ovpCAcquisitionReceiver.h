@@ -0,0 +1,86 @@
+#pragma once
+
+#include <openvibe/ov_all.h>
+
+#include <socket/IConnection.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace OpenViBE {
+namespace Plugins {
+namespace Acquisition {
+/// <summary> Receives the buffers sent by the acquisition server on a background thread. </summary>
+/// <remarks>
+/// Each buffer is sent as its size followed by its content. Complete buffers are queued in a ring of slots
+/// shared with the box without lock, the receiving thread only being the writer and the box the reader.
+/// The slots keep their memory from one buffer to the next. When all of them are waiting for the box,
+/// the thread stops reading the connection until one is released.
+/// </remarks>
+class CAcquisitionReceiver final
+{
+public:
+	enum class EError { None, Size, Allocation, Content };
+
+	/// <param name="nSlot"> Number of buffers which can wait for the box. </param>
+	explicit CAcquisitionReceiver(size_t nSlot = 256) : m_slots(nSlot) { }
+	~CAcquisitionReceiver() { stop(); }
+
+	/// <summary> Starts receiving from a connection, which must not be used by the caller until <see cref="stop"/> is called. </summary>
+	void start(Socket::IConnection& connection);
+
+	/// <summary> Stops receiving, the buffers already received are kept. </summary>
+	void stop();
+
+	/// <summary> Gets the oldest received buffer, or <c>nullptr</c> if none is waiting. It is valid until <see cref="pop"/> is called. </summary>
+	CMemoryBuffer* front();
+
+	/// <summary> Releases the buffer returned by <see cref="front"/>. </summary>
+	void pop();
+
+	/// <summary> Gets the number of received buffers waiting for the box. </summary>
+	size_t size() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_relaxed); }
+
+	/// <summary> Gets the reason why receiving stopped, after the last received buffer. </summary>
+	EError getError() const { return m_error.load(std::memory_order_acquire); }
+
+	/// <summary> Gets the size of the buffer that could not be received, with the <c>Allocation</c> and <c>Content</c> errors. </summary>
+	size_t getFailedSize() const { return m_failedSize; }
+
+	// Statistics, only to be read by the box
+	size_t getReceivedCount() const { return m_nReceived; }
+	size_t getMaxQueueSize() const { return m_maxQueueSize; }
+	double getMaxQueueDelay() const { return m_maxQueueDelay; }
+	size_t getFullQueueCount() const { return m_nFullQueue.load(std::memory_order_relaxed); }
+
+private:
+	typedef struct SSlot
+	{
+		CMemoryBuffer buffer;
+		std::chrono::steady_clock::time_point time;		// When the buffer was completely received
+	} slot_t;
+
+	void run();
+	bool receive(void* buffer, size_t size);
+
+	Socket::IConnection* m_connection = nullptr;
+	std::thread m_thread;
+	std::atomic<bool> m_stop { false };
+	std::atomic<EError> m_error { EError::None };
+	size_t m_failedSize = 0;
+
+	// Slots from head to tail (modulo their count) hold the buffers waiting for the box, the thread fills the slot at tail
+	std::vector<slot_t> m_slots;
+	std::atomic<size_t> m_head { 0 };
+	std::atomic<size_t> m_tail { 0 };
+
+	size_t m_nReceived     = 0;
+	size_t m_maxQueueSize  = 0;
+	double m_maxQueueDelay = 0;	// In seconds
+	std::atomic<size_t> m_nFullQueue { 0 };
+};
+}  // namespace Acquisition
+}  // namespace Plugins
+}  // namespace OpenViBE
@@ -38,6 +38,11 @@ bool CBoxAlgorithmAcquisitionClient::uninitialize()
 {
 	if (m_connectionClient)
 	{
+		m_receiver.stop();
+		this->getLogManager() << Kernel::LogLevel_Trace << "Received " << m_receiver.getReceivedCount() << " buffers, at most "
+				<< m_receiver.getMaxQueueSize() << " waiting at once and for up to " << m_receiver.getMaxQueueDelay() * 1000.0
+				<< " ms; reception paused " << m_receiver.getFullQueueCount() << " times as all slots were waiting\n";
+
 		m_connectionClient->close();
 		m_connectionClient->release();
 		m_connectionClient = nullptr;
@@ -87,9 +92,13 @@ bool CBoxAlgorithmAcquisitionClient::processClock(Kernel::CMessageClock& /*msg*/
 					". Make sure the server is running and in Play state.\n";
 			return false;
 		}
+
+		// From now on the connection is only read by the receiver thread
+		m_receiver.start(*m_connectionClient);
 	}
 
-	if (m_connectionClient && m_connectionClient->isReadyToReceive() /* && getPlayerContext().getCurrentTime()>m_lastChunkEndTime */)
+	// Buffers are received in the background, the box only decodes the complete ones
+	if (m_receiver.size() != 0 || m_receiver.getError() != CAcquisitionReceiver::EError::None)
 	{
 		getBoxAlgorithmContext()->markAlgorithmAsReadyToProcess();
 	}
@@ -99,7 +108,7 @@ bool CBoxAlgorithmAcquisitionClient::processClock(Kernel::CMessageClock& /*msg*/
 
 bool CBoxAlgorithmAcquisitionClient::process()
 {
-	if (!m_connectionClient || !m_connectionClient->isConnected()) { return false; }
+	if (!m_connectionClient) { return false; }
 
 	Kernel::IBoxIO& boxContext = this->getDynamicBoxContext();
 
@@ -109,27 +118,12 @@ bool CBoxAlgorithmAcquisitionClient::process()
 	op_channelLocalisationBuffer = boxContext.getOutputChunk(3);
 	op_channelUnitsBuffer        = boxContext.getOutputChunk(4);
 
-	while (m_connectionClient->isReadyToReceive())
+	while (CMemoryBuffer* buffer = m_receiver.front())
 	{
-		size_t size = 0;
-		if (!m_connectionClient->receiveBufferBlocking(&size, sizeof(size)))
-		{
-			getLogManager() << Kernel::LogLevel_Error << "Could not receive memory buffer size from the server. Is the server on 'Play'?\n";
-			return false;
-		}
-		if (!ip_acquisitionBuffer->setSize(size, true))
-		{
-			getLogManager() << Kernel::LogLevel_Error << "Could not re allocate memory buffer with size " << size << "\n";
-			return false;
-		}
-		if (!m_connectionClient->receiveBufferBlocking(ip_acquisitionBuffer->getDirectPointer(), size))
-		{
-			getLogManager() << Kernel::LogLevel_Error << "Could not receive memory buffer content of size " << size << "\n";
-			return false;
-		}
-
+		// The buffer is decoded in place, its slot is released once done
+		ip_acquisitionBuffer = buffer;
 		m_decoder->process();
-
+		m_receiver.pop();
 
 		if (m_decoder->isOutputTriggerActive(OVP_GD_Algorithm_AcquisitionDecoder_OutputTriggerId_ReceivedHeader)
 			|| m_decoder->isOutputTriggerActive(OVP_GD_Algorithm_AcquisitionDecoder_OutputTriggerId_ReceivedBuffer)
@@ -148,10 +142,25 @@ bool CBoxAlgorithmAcquisitionClient::process()
 			// @todo ?
 			// const double latency=CTime(m_lastChunkEndTime).toSeconds() - CTime(this->getPlayerContext().getCurrentTime()).toSeconds();
 			const double latency = double(int64_t(m_lastEndTime - this->getPlayerContext().getCurrentTime()) / (1LL << 22)) / 1024.0;
-			this->getLogManager() << Kernel::LogLevel_Debug << "Acquisition inner latency : " << latency << "\n";
+			this->getLogManager() << Kernel::LogLevel_Debug << "Acquisition inner latency : " << latency << ", buffers waiting : " << m_receiver.size() << "\n";
 		}
 	}
 
+	// Reception errors are reported once the buffers received before are processed
+	switch (m_receiver.getError())
+	{
+		case CAcquisitionReceiver::EError::Size:
+			getLogManager() << Kernel::LogLevel_Error << "Could not receive memory buffer size from the server. Is the server on 'Play'?\n";
+			return false;
+		case CAcquisitionReceiver::EError::Allocation:
+			getLogManager() << Kernel::LogLevel_Error << "Could not re allocate memory buffer with size " << m_receiver.getFailedSize() << "\n";
+			return false;
+		case CAcquisitionReceiver::EError::Content:
+			getLogManager() << Kernel::LogLevel_Error << "Could not receive memory buffer content of size " << m_receiver.getFailedSize() << "\n";
+			return false;
+		case CAcquisitionReceiver::EError::None: break;
+	}
+
 	return true;
 }
 }  // namespace Acquisition
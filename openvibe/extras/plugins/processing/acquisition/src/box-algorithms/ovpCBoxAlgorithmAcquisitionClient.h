@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../ovp_defines.h"
+#include "ovpCAcquisitionReceiver.h"
 #include <openvibe/ov_all.h>
 #include <toolkit/ovtk_all.h>
 
@@ -34,6 +35,7 @@ protected:
 	Kernel::TParameterHandler<CMemoryBuffer*> op_channelUnitsBuffer;
 
 	Socket::IConnectionClient* m_connectionClient = nullptr;
+	CAcquisitionReceiver m_receiver;
 
 	uint64_t m_lastStartTime = 0;
 	uint64_t m_lastEndTime   = 0;
@@ -0,0 +1,200 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file AcquisitionReceiverTests.hpp
+/// \brief Tests for the reception of the buffers of the acquisition server by the Acquisition client box, over a loopback connection.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "ovpCAcquisitionReceiver.h"
+
+#include <socket/IConnectionClient.h>
+#include <socket/IConnectionServer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+//---------------------------------------------------------------------------------------------------
+class AcquisitionReceiver_Tests : public testing::Test
+{
+protected:
+	using CAcquisitionReceiver = OpenViBE::Plugins::Acquisition::CAcquisitionReceiver;
+	using EError = CAcquisitionReceiver::EError;
+
+	// The server side of the connection is read by the receiver, the test sends on the client side as the acquisition server does
+	void SetUp() override
+	{
+		m_server = Socket::createConnectionServer();
+		m_client = Socket::createConnectionClient();
+		size_t port = 0;
+		ASSERT_TRUE(m_server->listen(0));
+		ASSERT_TRUE(m_server->getSocketPort(port));
+		ASSERT_TRUE(m_client->connect("localhost", port));
+		m_connection = m_server->accept();
+		ASSERT_NE(nullptr, m_connection);
+	}
+
+	void TearDown() override
+	{
+		m_receiver.stop();
+		if (m_connection) { m_connection->release(); }
+		m_client->release();
+		m_server->release();
+	}
+
+	// Content of the n-th buffer, their sizes vary so that some are split by the connection
+	static std::vector<uint8_t> content(const size_t n)
+	{
+		std::vector<uint8_t> buffer(1 + (n * 7919) % 100000);
+		for (size_t i = 0; i < buffer.size(); ++i) { buffer[i] = uint8_t(n + i); }
+		return buffer;
+	}
+
+	void send(const std::vector<uint8_t>& buffer) const
+	{
+		const uint64_t size = buffer.size();
+		ASSERT_TRUE(m_client->sendBufferBlocking(&size, sizeof(size)));
+		ASSERT_TRUE(m_client->sendBufferBlocking(buffer.data(), buffer.size()));
+	}
+
+	// Waits for a condition set by the receiving thread, for at most 5 s
+	static bool waitFor(const std::function<bool()>& condition)
+	{
+		const auto limit = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (!condition()) {
+			if (std::chrono::steady_clock::now() > limit) { return false; }
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return true;
+	}
+
+	// Checks that the next buffer received is the n-th one and releases it
+	void expectBuffer(const size_t n)
+	{
+		ASSERT_TRUE(waitFor([&]() { return m_receiver.size() != 0; })) << "Buffer " << n << " wasn't received.";
+		const OpenViBE::CMemoryBuffer* buffer = m_receiver.front();
+		ASSERT_NE(nullptr, buffer);
+		const std::vector<uint8_t> expected = content(n);
+		ASSERT_EQ(expected.size(), buffer->getSize()) << "Buffer " << n;
+		EXPECT_TRUE(std::equal(expected.begin(), expected.end(), buffer->getDirectPointer())) << "Buffer " << n;
+		m_receiver.pop();
+	}
+
+	Socket::IConnectionServer* m_server = nullptr;
+	Socket::IConnectionClient* m_client = nullptr;
+	Socket::IConnection* m_connection   = nullptr;
+	CAcquisitionReceiver m_receiver { 4 };
+};
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(AcquisitionReceiver_Tests, buffersInOrder)
+{
+	m_receiver.start(*m_connection);
+	std::thread sender([&]() { for (size_t i = 0; i < 50; ++i) { send(content(i)); } });
+
+	// The slots are reused many times while the box reads
+	for (size_t i = 0; i < 50; ++i) { expectBuffer(i); }
+	sender.join();
+
+	EXPECT_EQ(50, m_receiver.getReceivedCount());
+	EXPECT_LE(m_receiver.getMaxQueueSize(), 4);
+	EXPECT_EQ(nullptr, m_receiver.front());
+	EXPECT_EQ(EError::None, m_receiver.getError());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(AcquisitionReceiver_Tests, fullRing)
+{
+	m_receiver.start(*m_connection);
+	std::thread sender([&]() { for (size_t i = 0; i < 10; ++i) { send(content(i)); } });
+
+	// The box doesn't read, the thread stops reading the connection once every slot is used
+	ASSERT_TRUE(waitFor([&]() { return m_receiver.getFullQueueCount() != 0; })) << "Receiving thread doesn't wait for a free slot.";
+	EXPECT_EQ(4, m_receiver.size());
+
+	// No buffer is lost or overwritten while the ring was full
+	for (size_t i = 0; i < 10; ++i) { expectBuffer(i); }
+	sender.join();
+	EXPECT_EQ(4, m_receiver.getMaxQueueSize());
+	EXPECT_EQ(EError::None, m_receiver.getError());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(AcquisitionReceiver_Tests, disconnection)
+{
+	m_receiver.start(*m_connection);
+	send(content(1));
+	send(content(2));
+	m_client->close();
+
+	// The buffers received before the disconnection are still given to the box
+	ASSERT_TRUE(waitFor([&]() { return m_receiver.getError() != EError::None; }));
+	EXPECT_EQ(EError::Size, m_receiver.getError());
+	expectBuffer(1);
+	expectBuffer(2);
+	EXPECT_EQ(0, m_receiver.size());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(AcquisitionReceiver_Tests, truncatedBuffer)
+{
+	m_receiver.start(*m_connection);
+	send(content(1));
+
+	// Only a part of the announced content is sent before the disconnection
+	const std::vector<uint8_t> buffer = content(2);
+	const uint64_t size = buffer.size();
+	ASSERT_TRUE(m_client->sendBufferBlocking(&size, sizeof(size)));
+	ASSERT_TRUE(m_client->sendBufferBlocking(buffer.data(), buffer.size() / 2));
+	m_client->close();
+
+	ASSERT_TRUE(waitFor([&]() { return m_receiver.getError() != EError::None; }));
+	EXPECT_EQ(EError::Content, m_receiver.getError());
+	EXPECT_EQ(buffer.size(), m_receiver.getFailedSize());
+	expectBuffer(1);
+	EXPECT_EQ(nullptr, m_receiver.front()) << "Truncated buffer is given to the box.";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(AcquisitionReceiver_Tests, stopKeepsBuffers)
+{
+	m_receiver.start(*m_connection);
+	send(content(1));
+	ASSERT_TRUE(waitFor([&]() { return m_receiver.size() != 0; }));
+
+	// Stopping while the thread waits for data isn't an error, the connection is still usable
+	m_receiver.stop();
+	EXPECT_EQ(EError::None, m_receiver.getError());
+	send(content(2));
+	m_receiver.start(*m_connection);
+	expectBuffer(1);
+	expectBuffer(2);
+}
+//---------------------------------------------------------------------------------------------------
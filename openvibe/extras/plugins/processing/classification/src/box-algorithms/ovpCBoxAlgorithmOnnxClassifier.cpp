@@ -10,20 +10,164 @@
 
 #include "./ovpCBoxAlgorithmOnnxClassifier.hpp"
 
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <numeric>
+
 namespace OpenViBE
 {
 	namespace Plugins
 	{
 		namespace Classification
 		{
+			namespace
+			{
+				/// <summary> Gets the ONNX Runtime environment shared by every ONNX box and box listener of the process. </summary>
+				/// <param name="globalThreadPools"> Whether the environment should own global thread pools, set to whether it does on return. </param>
+				/// <param name="intraOpThreads"> Requested size of the global intra-op thread pool, set to the actual size on return. </param>
+				/// <param name="interOpThreads"> Requested size of the global inter-op thread pool, set to the actual size on return. </param>
+				/// <remarks>
+				/// ONNX Runtime keeps a single environment per process, so the first holder decides whether it has global thread pools and their size.
+				/// The pools are only created for a box sharing them, listeners and boxes with their own threads get a plain environment.
+				/// It is released with the last holder.
+				/// </remarks>
+				std::shared_ptr<Ort::Env> acquireSharedEnv(bool &globalThreadPools, int &intraOpThreads, int &interOpThreads)
+				{
+					static std::mutex mutex;
+					static std::weak_ptr<Ort::Env> sharedEnv;
+					static bool sharedGlobalThreadPools = false;
+					static int sharedIntraOpThreads = 0;
+					static int sharedInterOpThreads = 0;
+
+					std::lock_guard<std::mutex> lock(mutex);
+					std::shared_ptr<Ort::Env> env = sharedEnv.lock();
+					if (!env)
+					{
+						if (globalThreadPools)
+						{
+							Ort::ThreadingOptions threadingOptions;
+							threadingOptions.SetGlobalIntraOpNumThreads(intraOpThreads);
+							threadingOptions.SetGlobalInterOpNumThreads(interOpThreads);
+							env = std::make_shared<Ort::Env>(threadingOptions, ORT_LOGGING_LEVEL_WARNING, "ONNXClassifier");
+						}
+						else
+						{
+							env = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "ONNXClassifier");
+						}
+						sharedEnv = env;
+						sharedGlobalThreadPools = globalThreadPools;
+						sharedIntraOpThreads = intraOpThreads;
+						sharedInterOpThreads = interOpThreads;
+					}
+					globalThreadPools = sharedGlobalThreadPools;
+					intraOpThreads = sharedIntraOpThreads;
+					interOpThreads = sharedInterOpThreads;
+					return env;
+				}
+
+				/// <summary> Checks that a serialized optimized model exists and is not older than the model it was built from. </summary>
+				bool isOptimizedModelFresh(const std::string &optimizedPath, const std::string &modelPath)
+				{
+					std::error_code error;
+					const auto optimizedTime = std::filesystem::last_write_time(optimizedPath, error);
+					if (error)
+					{
+						return false;
+					}
+					const auto modelTime = std::filesystem::last_write_time(modelPath, error);
+					return !error && optimizedTime >= modelTime;
+				}
+
+				const char *LATENCY_PHASE_NAMES[LATENCY_PHASE_COUNT] = {"Decode", "Convert", "Run", "Argmax", "Encode", "Total"};
+				const double LATENCY_PERCENTILES[]                  = {50.0, 95.0, 99.0, 100.0};
+				const char *LATENCY_PERCENTILE_NAMES[]              = {"p50", "p95", "p99", "max"};
+				constexpr size_t LATENCY_PERCENTILE_COUNT           = 4;
+
+				double millisecondsSince(const std::chrono::high_resolution_clock::time_point &start)
+				{
+					return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+				}
+
+				// Box outputs before the raw model outputs: classification and latency percentiles
+				constexpr size_t SCORE_OUTPUT_OFFSET = 2;
+
+				bool isStreamableTensor(const Ort::TypeInfo &typeInfo)
+				{
+					if (typeInfo.GetONNXType() != ONNX_TYPE_TENSOR)
+					{
+						return false;
+					}
+					const ONNXTensorElementDataType type = typeInfo.GetTensorTypeAndShapeInfo().GetElementType();
+					return type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT || type == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE
+						   || type == ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64;
+				}
+
+				template <typename T>
+				void copyRow(const Ort::Value &tensor, const size_t offset, std::vector<double> &values)
+				{
+					const T *data = tensor.GetTensorData<T>() + offset;
+					std::transform(data, data + values.size(), values.begin(), [](const T value) { return double(value); });
+				}
+
+				/// <summary> Copies one batch row of an output tensor, the batch dimension is dropped from the row dimensions. </summary>
+				void copyTensorRow(const Ort::Value &tensor, const size_t row, std::vector<double> &values, std::vector<size_t> &dims)
+				{
+					const auto info = tensor.GetTensorTypeAndShapeInfo();
+					const std::vector<int64_t> shape = info.GetShape();
+					if (shape.size() > 1)
+					{
+						dims.assign(shape.begin() + 1, shape.end());
+					}
+					else
+					{
+						dims.assign(1, 1); // One value per batch row
+					}
+					values.resize(std::accumulate(dims.begin(), dims.end(), size_t(1), std::multiplies<size_t>()));
+
+					const size_t offset = row * values.size();
+					switch (info.GetElementType())
+					{
+						case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT: copyRow<float>(tensor, offset, values);
+							break;
+						case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE: copyRow<double>(tensor, offset, values);
+							break;
+						default: copyRow<int64_t>(tensor, offset, values);
+							break;
+					}
+				}
+			} // namespace
+
 			///-------------------------------------------------------------------------------------------------
 			bool CBoxAlgorithmOnnxClassifier::initialize()
 			{
-				// Initialize output encoder
+				// Initialize output encoders, the latency output is absent from scenarios made before it was added
 				m_stimEncoder.initialize(*this, 0);
 
-				// Initialize input decoders
 				const Kernel::IBox &boxCtx = this->getStaticBoxContext();
+				m_latencyOutput = boxCtx.getOutputCount() > 1;
+				if (m_latencyOutput)
+				{
+					m_latencyEncoder.initialize(*this, 1);
+
+					// One row per phase, one column per percentile
+					CMatrix *matrix = m_latencyEncoder.getInputMatrix();
+					matrix->resize(LATENCY_PHASE_COUNT, LATENCY_PERCENTILE_COUNT);
+					for (size_t i = 0; i < LATENCY_PHASE_COUNT; ++i)
+					{
+						matrix->setDimensionLabel(0, i, LATENCY_PHASE_NAMES[i]);
+					}
+					for (size_t i = 0; i < LATENCY_PERCENTILE_COUNT; ++i)
+					{
+						matrix->setDimensionLabel(1, i, LATENCY_PERCENTILE_NAMES[i]);
+					}
+				}
+
+				// Every output after the latency one streams a raw model output
+				m_scoreOutputCount = boxCtx.getOutputCount() > SCORE_OUTPUT_OFFSET ? boxCtx.getOutputCount() - SCORE_OUTPUT_OFFSET : 0;
+
+				// Initialize input decoders
 				CIdentifier typeID;
 				for (size_t i = 0; i < boxCtx.getInputCount(); ++i)
 				{
@@ -36,6 +180,48 @@ namespace OpenViBE
 
 				// Initialize Onnx Runtime session
 				const CString modelPath = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 0);
+				m_useIoBinding = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 1);
+				m_batchChunks = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 2);
+				m_useSharedThreadPool = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 3);
+				m_intraOpThreads = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 4);
+				m_interOpThreads = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 5);
+				const uint64_t optimizationLevel = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 6);
+				const uint64_t executionMode = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 7);
+				const CString optimizedModelPath = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 8);
+				m_asyncInference = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 9);
+				const int64_t maxInFlight = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 10);
+				const uint64_t queueFullPolicy = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 11);
+				const CString latencyCsvPath = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 12);
+				m_optimizationLevel = GraphOptimizationLevel(optimizationLevel);
+				m_executionMode = ExecutionMode(executionMode);
+				m_optimizedModelPath = optimizedModelPath.toASCIIString();
+
+				if (m_intraOpThreads < 1 || m_interOpThreads < 1)
+				{
+					this->getLogManager() << Kernel::LogLevel_Error << "Thread counts must be at least 1.\n";
+					return false;
+				}
+				if (m_asyncInference && maxInFlight < 1)
+				{
+					this->getLogManager() << Kernel::LogLevel_Error << "Max in-flight chunks must be at least 1.\n";
+					return false;
+				}
+
+				if (latencyCsvPath.length() != 0)
+				{
+					m_latencyCsv.open(latencyCsvPath.toASCIIString(), std::ios::out | std::ios::trunc);
+					if (!m_latencyCsv.is_open())
+					{
+						this->getLogManager() << Kernel::LogLevel_Error << "Could not open latency file [" << latencyCsvPath << "].\n";
+						return false;
+					}
+					m_latencyCsv << "End Time (s)";
+					for (const char *name : LATENCY_PHASE_NAMES)
+					{
+						m_latencyCsv << "," << name << " (ms)";
+					}
+					m_latencyCsv << "\n";
+				}
 
 				try
 				{
@@ -48,6 +234,57 @@ namespace OpenViBE
 					return false;
 				}
 
+				// Only float and double tensors can be fed from (or compared as) OpenViBE matrices
+				for (size_t i = 0; i < m_numInputs; ++i)
+				{
+					if (m_inputTypes[i] != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT && m_inputTypes[i] != ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+					{
+						this->getLogManager() << Kernel::LogLevel_Error
+																	<< "Input " << i << " must be a tensor(float) or tensor(double).\n";
+						return false;
+					}
+				}
+				if (m_outputType != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT && m_outputType != ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+				{
+					this->getLogManager() << Kernel::LogLevel_Error
+																<< "Output must be a tensor(float) or tensor(double).\n";
+					return false;
+				}
+				for (size_t i = 0; i < m_scoreOutputCount; ++i)
+				{
+					if (!isStreamableTensor(m_onnxSession->GetOutputTypeInfo(i)))
+					{
+						this->getLogManager() << Kernel::LogLevel_Error << "Model output " << m_outputNames[i]
+																	<< " cannot be streamed, only tensor(float), tensor(double) and tensor(int64) can.\n";
+						return false;
+					}
+					m_scoreEncoders.push_back(new Toolkit::TStreamedMatrixEncoder<CBoxAlgorithmOnnxClassifier>());
+					m_scoreEncoders.back()->initialize(*this, SCORE_OUTPUT_OFFSET + i);
+				}
+				m_scoreHeaderDims.assign(m_scoreOutputCount, {});
+
+				// Stacking chunks requires every input and the output to have a dynamic batch dimension
+				if (m_batchChunks)
+				{
+					bool isBatchDynamic = !m_outputShape.empty() && m_outputShape[0] <= 0;
+					for (const auto &shape : m_inputShapes)
+					{
+						isBatchDynamic = isBatchDynamic && !shape.empty() && shape[0] <= 0;
+					}
+					if (!isBatchDynamic)
+					{
+						this->getLogManager() << Kernel::LogLevel_Warning
+																	<< "Model batch dimension is fixed, pending chunks will be processed one at a time.\n";
+						m_batchChunks = false;
+					}
+				}
+
+				m_queue.start(size_t(std::max<int64_t>(maxInFlight, 1)), EOnnxQueueFullPolicy(queueFullPolicy));
+				if (m_asyncInference)
+				{
+					m_worker = std::thread(&CBoxAlgorithmOnnxClassifier::inferenceWorker, this);
+				}
+
 				this->getLogManager() << Kernel::LogLevel_Info
 															<< "ONNX model loaded successfully. Classes: " << m_numClasses << "\n";
 
@@ -57,24 +294,65 @@ namespace OpenViBE
 			///-------------------------------------------------------------------------------------------------
 			bool CBoxAlgorithmOnnxClassifier::uninitialize()
 			{
+				// Chunks still queued are abandoned, only the one being classified is waited for
+				if (m_worker.joinable())
+				{
+					m_queue.stop();
+					m_worker.join();
+				}
+				if (m_queue.droppedCount() > 0)
+				{
+					this->getLogManager() << Kernel::LogLevel_Warning
+																<< m_queue.droppedCount() << " chunks were dropped because the inference queue was full.\n";
+				}
+
 				// Print latency profiling summary
-				if (m_bufferCount > 0)
+				const CLatencyHistogram &totalLatency = m_latencyHistograms[size_t(ELatencyPhase::Total)];
+				if (totalLatency.count() > 0)
 				{
-					double avgLatency = m_totalProcessingTime / m_bufferCount;
 					this->getLogManager() << Kernel::LogLevel_Info
 																<< "=== ONNX Classifier Latency Profiling Summary ===\n"
-																<< "Total buffers processed: " << m_bufferCount << "\n"
-																<< "Total processing time: " << m_totalProcessingTime << " ms\n"
-																<< "Average latency per buffer: " << avgLatency << " ms\n"
-																<< "================================================\n";
+																<< "Total buffers processed: " << totalLatency.count() << "\n"
+																<< "Total processing time: " << totalLatency.mean() * double(totalLatency.count()) << " ms\n"
+																<< "Average latency per buffer: " << totalLatency.mean() << " ms\n";
+					for (size_t i = 0; i < LATENCY_PHASE_COUNT; ++i)
+					{
+						const CLatencyHistogram &histogram = m_latencyHistograms[i];
+						this->getLogManager() << Kernel::LogLevel_Info << LATENCY_PHASE_NAMES[i] << " (ms): mean " << histogram.mean();
+						for (size_t j = 0; j < LATENCY_PERCENTILE_COUNT; ++j)
+						{
+							this->getLogManager() << ", " << LATENCY_PERCENTILE_NAMES[j] << " " << histogram.percentile(LATENCY_PERCENTILES[j]);
+						}
+						this->getLogManager() << "\n";
+					}
+					this->getLogManager() << Kernel::LogLevel_Info << "================================================\n";
 				}
 				else
 				{
 					this->getLogManager() << Kernel::LogLevel_Info
 																<< "No buffers processed - no latency data available.\n";
 				}
+				for (auto &histogram : m_latencyHistograms)
+				{
+					histogram.reset();
+				}
+				m_latencyCsv.close();
+				m_hasNewLatency = false;
 
 				m_stimEncoder.uninitialize();
+				if (m_latencyOutput)
+				{
+					m_latencyEncoder.uninitialize();
+				}
+				for (auto encoder : m_scoreEncoders)
+				{
+					encoder->uninitialize();
+					delete encoder;
+				}
+				m_scoreEncoders.clear();
+				m_scoreHeaderDims.clear();
+				m_scores.clear();
+				m_batchScores.clear();
 				for (auto decoder : m_decoders)
 				{
 					decoder->uninitialize();
@@ -82,13 +360,40 @@ namespace OpenViBE
 				}
 				m_decoders.clear();
 
+				// Bound tensors reference the session and our buffers, release them first
+				m_ioBinding.reset();
+				m_batchBinding.reset();
+				m_inputTensors.clear();
+				m_batchTensors.clear();
+				m_batchTensorShapes.clear();
+				m_batchTensorData.clear();
+				m_outputTensor = Ort::Value(nullptr);
+				m_boundBuffers.clear();
+				m_tensorShapes.clear();
+				m_outputBuffer.clear();
+
 				m_onnxSession.reset();
+				m_onnxEnv.reset();
 				m_inputShapes.clear();
+				m_inputTypes.clear();
+				m_outputShape.clear();
 				m_numClasses = 0;
 				m_numInputs = 0;
 
 				m_inputBuffers.clear();
 				m_inputNamePtrs.clear();
+				m_inputNames.clear();
+				m_outputNamePtrs.clear();
+				m_outputNames.clear();
+
+				m_batchInputs.clear();
+				m_batchConverted.clear();
+				m_batchShapes.clear();
+				m_batchEndTimes.clear();
+				m_batchTimes.clear();
+
+				m_results.clear();
+				m_readyResults.clear();
 
 				return true;
 			}
@@ -100,12 +405,29 @@ namespace OpenViBE
 				return true;
 			}
 
+			///-------------------------------------------------------------------------------------------------
+			bool CBoxAlgorithmOnnxClassifier::processClock(Kernel::CMessageClock & /*msg*/)
+			{
+				// Results of the worker are emitted on the next process()
+				std::lock_guard<std::mutex> lock(m_resultMutex);
+				if (!m_results.empty() || m_queue.hasError())
+				{
+					getBoxAlgorithmContext()->markAlgorithmAsReadyToProcess();
+				}
+				return true;
+			}
+
 			///-------------------------------------------------------------------------------------------------
 			bool CBoxAlgorithmOnnxClassifier::process()
 			{
 				Kernel::IBoxIO &boxCtx = this->getDynamicBoxContext();
 
-				std::vector<const CMatrix *> inputMatrices;
+				if (m_asyncInference && !emitAsyncResults())
+				{
+					return false;
+				}
+
+				std::vector<CMatrix *> inputMatrices;
 				inputMatrices.reserve(m_numInputs);
 
 				size_t chunkIdx = 0;
@@ -120,7 +442,13 @@ namespace OpenViBE
 					{
 						if (chunkIdx >= boxCtx.getInputChunkCount(i))
 						{
-							return true; // All possible chunks processed
+							// All possible chunks processed, classify what was stacked
+							if (!flushInference(false))
+							{
+								return false;
+							}
+							sendLatencyReport();
+							return true;
 						}
 					}
 
@@ -141,7 +469,7 @@ namespace OpenViBE
 							isHeaderReceived = true;
 
 							// Extract matrix metadata
-							const CMatrix *matrix = decoder->getOutputMatrix();
+							CMatrix *matrix = decoder->getOutputMatrix();
 
 							// Validate matrix dimensions match ONNX model input shape
 							const size_t inputDimCount = matrix->getDimensionCount();
@@ -174,10 +502,28 @@ namespace OpenViBE
 									return false;
 								}
 							}
+
+							// The worker reads the tensor shapes, it must be idle before they change
+							if (m_asyncInference && !flushInference(true))
+							{
+								return false;
+							}
+
+							// Shape is now fully known, create the tensor once for the whole stream
+							try
+							{
+								bindInputTensor(i, *matrix);
+							}
+							catch (const Ort::Exception &e)
+							{
+								this->getLogManager() << Kernel::LogLevel_Error
+																			<< "Failed to bind input " << i << ": " << e.what() << "\n";
+								return false;
+							}
 						}
 						else if (decoder->isBufferReceived())
 						{
-							const CMatrix *matrix = m_decoders[i]->getOutputMatrix();
+							CMatrix *matrix = m_decoders[i]->getOutputMatrix();
 							inputMatrices.push_back(matrix);
 
 							// Print buffer data (first 20 elements)
@@ -197,6 +543,13 @@ namespace OpenViBE
 						}
 						else if (decoder->isEndReceived())
 						{
+							// Labels of stacked or queued chunks must precede the stop stimulation
+							if (!flushInference(true))
+							{
+								return false;
+							}
+							sendLatencyReport();
+
 							// End of stream received. This happens only once when pressing "stop". Just pass it to the next boxes so they receive the message :
 							CStimulationSet *stimSet = m_stimEncoder.getInputStimulationSet();
 							stimSet->clear();
@@ -209,6 +562,19 @@ namespace OpenViBE
 							getLogManager() << Kernel::LogLevel_Info << "Stop Stimulation sent, ending stream.\n";
 							m_stimEncoder.encodeEnd();
 							boxCtx.markOutputAsReadyToSend(0, chunkStartTime, chunkEndTime);
+							if (m_latencyOutput)
+							{
+								m_latencyEncoder.encodeEnd();
+								boxCtx.markOutputAsReadyToSend(1, chunkStartTime, chunkEndTime);
+							}
+							for (size_t k = 0; k < m_scoreOutputCount; ++k)
+							{
+								if (!m_scoreHeaderDims[k].empty())
+								{
+									m_scoreEncoders[k]->encodeEnd();
+									boxCtx.markOutputAsReadyToSend(SCORE_OUTPUT_OFFSET + k, chunkStartTime, chunkEndTime);
+								}
+							}
 
 							return true;
 						}
@@ -217,18 +583,47 @@ namespace OpenViBE
 					}
 					chunkIdx++;
 
+					SPhaseTimes times;
+					times[ELatencyPhase::Decode] = millisecondsSince(startTime);
+
 					if (isHeaderReceived)
 					{
+						if (!flushInference(true))
+						{
+							return false;
+						}
+
 						// Encode stimulation header
 						m_stimEncoder.encodeHeader();
 						boxCtx.markOutputAsReadyToSend(0, chunkStartTime, chunkEndTime);
+						if (m_latencyOutput)
+						{
+							m_latencyEncoder.encodeHeader();
+							boxCtx.markOutputAsReadyToSend(1, chunkStartTime, chunkEndTime);
+						}
+						continue;
+					}
+
+					if (m_asyncInference)
+					{
+						if (!queueAsyncInference(inputMatrices, chunkEndTime, times[ELatencyPhase::Decode]))
+						{
+							return false;
+						}
+						continue;
+					}
+
+					if (m_batchChunks)
+					{
+						// Decoder matrices are overwritten by the next chunk, keep a copy until the batch is flushed
+						stageBatchRow(inputMatrices, chunkEndTime, times[ELatencyPhase::Decode]);
 						continue;
 					}
 
 					try
 					{
 						// Run ONNX model inference
-						int predictedClass = runOnnxInference(inputMatrices);
+						int predictedClass = runOnnxInference(inputMatrices, times);
 
 						// Prepare stimulation set
 						CStimulationSet *stimSet = m_stimEncoder.getInputStimulationSet();
@@ -249,17 +644,18 @@ namespace OpenViBE
 					}
 
 					// Encode and send the output buffer
+					const auto encodeStartTime = std::chrono::high_resolution_clock::now();
 					m_stimEncoder.encodeBuffer();
 					boxCtx.markOutputAsReadyToSend(0, chunkEndTime, chunkEndTime);
+					sendScores(m_scores, chunkEndTime);
+					times[ELatencyPhase::Encode] = millisecondsSince(encodeStartTime);
 
 					// End timing and update profiling stats
-					auto endTime = std::chrono::high_resolution_clock::now();
-					std::chrono::duration<double, std::milli> elapsed = endTime - startTime;
-					m_totalProcessingTime += elapsed.count();
-					m_bufferCount++;
+					times[ELatencyPhase::Total] = millisecondsSince(startTime);
+					recordLatency(times, chunkEndTime);
 
 					this->getLogManager() << Kernel::LogLevel_Debug
-																<< "Buffer processing latency: " << elapsed.count() << " ms\n";
+																<< "Buffer processing latency: " << times[ELatencyPhase::Total] << " ms\n";
 				}
 
 				return true;
@@ -372,137 +768,726 @@ namespace OpenViBE
 			void CBoxAlgorithmOnnxClassifier::initializeOnnxSession(const CString &modelPath)
 			{
 				// Configure session options
-				m_sessionOptions.SetIntraOpNumThreads(1);
-				m_sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_BASIC);
+				bool globalThreadPools = m_useSharedThreadPool;
+				int poolIntraOpThreads = m_intraOpThreads;
+				int poolInterOpThreads = m_interOpThreads;
+				m_onnxEnv = acquireSharedEnv(globalThreadPools, poolIntraOpThreads, poolInterOpThreads);
+				m_sessionOptions = Ort::SessionOptions();
+				if (m_useSharedThreadPool && !globalThreadPools)
+				{
+					this->getLogManager() << Kernel::LogLevel_Info
+																<< "ONNX Runtime environment was created without a shared thread pool, the session runs its own threads.\n";
+				}
+				if (m_useSharedThreadPool && globalThreadPools)
+				{
+					// Run on the process-wide pools, so several ONNX boxes do not oversubscribe the cores
+					m_sessionOptions.DisablePerSessionThreads();
+					if (poolIntraOpThreads != m_intraOpThreads || poolInterOpThreads != m_interOpThreads)
+					{
+						this->getLogManager() << Kernel::LogLevel_Info
+																	<< "Shared thread pool already runs " << poolIntraOpThreads << " intra-op and "
+																	<< poolInterOpThreads << " inter-op threads, requested counts are ignored.\n";
+					}
+				}
+				else
+				{
+					m_sessionOptions.SetIntraOpNumThreads(m_intraOpThreads);
+					m_sessionOptions.SetInterOpNumThreads(m_interOpThreads);
+				}
+				m_sessionOptions.SetExecutionMode(m_executionMode);
+
+				// A fresh serialized optimized model is loaded as is, otherwise it is (re)written while the session is created.
+				// The cache does not track the optimization level: delete it after changing that setting.
+				std::string modelFile = modelPath.toASCIIString();
+				if (m_optimizedModelPath.empty())
+				{
+					m_sessionOptions.SetGraphOptimizationLevel(m_optimizationLevel);
+				}
+				else if (isOptimizedModelFresh(m_optimizedModelPath, modelFile))
+				{
+					this->getLogManager() << Kernel::LogLevel_Info << "Loading optimized model from [" << m_optimizedModelPath << "].\n";
+					modelFile = m_optimizedModelPath;
+					m_sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_DISABLE_ALL);
+				}
+				else
+				{
+					m_sessionOptions.SetGraphOptimizationLevel(m_optimizationLevel);
+					m_sessionOptions.SetOptimizedModelFilePath(m_optimizedModelPath.c_str());
+				}
 
 				// Load the model
 				m_onnxSession = std::make_unique<Ort::Session>(
-						m_onnxEnv,
-						modelPath.toASCIIString(),
+						*m_onnxEnv,
+						modelFile.c_str(),
 						m_sessionOptions);
 
 				// Get input info
 				m_inputShapes.reserve(m_numInputs);
+				m_inputTypes.reserve(m_numInputs);
 				m_inputNames.reserve(m_numInputs);
 				m_inputNamePtrs.reserve(m_numInputs);
 				for (size_t i = 0; i < m_numInputs; ++i)
 				{
-					m_inputShapes.push_back(
-							m_onnxSession->GetInputTypeInfo(i)
-									.GetTensorTypeAndShapeInfo()
-									.GetShape());
+					const Ort::TypeInfo typeInfo = m_onnxSession->GetInputTypeInfo(i);
+					m_inputShapes.push_back(typeInfo.GetTensorTypeAndShapeInfo().GetShape());
+					m_inputTypes.push_back(typeInfo.GetTensorTypeAndShapeInfo().GetElementType());
 					m_inputNames.push_back(
 							CString(m_onnxSession->GetInputNameAllocated(i, Ort::AllocatorWithDefaultOptions()).get()));
 					m_inputNamePtrs.push_back(m_inputNames.back().toASCIIString());
 				}
 
-				// Get output name
-				m_outputName = CString(
-						m_onnxSession->GetOutputNameAllocated(0, Ort::AllocatorWithDefaultOptions()).get());
+				// Get output names, only the first output is classified
+				const size_t numOutputs = m_onnxSession->GetOutputCount();
+				m_outputNames.reserve(numOutputs);
+				m_outputNamePtrs.reserve(numOutputs);
+				for (size_t i = 0; i < numOutputs; ++i)
+				{
+					m_outputNames.push_back(CString(m_onnxSession->GetOutputNameAllocated(i, Ort::AllocatorWithDefaultOptions()).get()));
+					m_outputNamePtrs.push_back(m_outputNames.back().toASCIIString());
+				}
+				if (m_scoreOutputCount > numOutputs)
+				{
+					this->getLogManager() << Kernel::LogLevel_Warning << "Box has more score outputs than the model has outputs, extra ones stay empty.\n";
+					m_scoreOutputCount = numOutputs;
+				}
+				m_runOutputCount = std::max(m_scoreOutputCount, size_t(1));
 
 				// Get output shape to determine number of classes
-				m_numClasses = m_onnxSession->GetOutputTypeInfo(0)
-													 .GetTensorTypeAndShapeInfo()
-													 .GetShape()
-													 .back();
+				const Ort::TypeInfo outputTypeInfo = m_onnxSession->GetOutputTypeInfo(0);
+				m_outputShape = outputTypeInfo.GetTensorTypeAndShapeInfo().GetShape();
+				m_outputType = outputTypeInfo.GetTensorTypeAndShapeInfo().GetElementType();
+				m_numClasses = m_outputShape.back();
 
-				// Pre-allocate float buffers (will be resized as needed)
+				// Pre-allocate float buffers (sized when the stream header is received)
 				m_inputBuffers.resize(m_numInputs);
+				m_tensorShapes.resize(m_numInputs);
+				m_boundBuffers.assign(m_numInputs, nullptr);
+				m_batchInputs.resize(m_numInputs);
+				m_batchConverted.resize(m_numInputs);
+				m_inputTensors.clear();
+				for (size_t i = 0; i < m_numInputs; ++i)
+				{
+					m_inputTensors.emplace_back(nullptr);
+				}
+
+				m_batchTensors.clear();
+				for (size_t i = 0; i < m_numInputs; ++i)
+				{
+					m_batchTensors.emplace_back(nullptr);
+				}
+				m_batchTensorShapes.assign(m_numInputs, std::vector<int64_t>());
+				m_batchTensorData.assign(m_numInputs, nullptr);
+
+				if (m_useIoBinding)
+				{
+					m_ioBinding = std::make_unique<Ort::IoBinding>(*m_onnxSession);
+					bindOutputTensor();
+
+					// Batch sizes vary, so the outputs of a batch are always allocated by ONNX Runtime
+					m_batchBinding = std::make_unique<Ort::IoBinding>(*m_onnxSession);
+					for (size_t i = 0; i < m_runOutputCount; ++i)
+					{
+						m_batchBinding->BindOutput(m_outputNamePtrs[i], m_memoryInfo);
+					}
+				}
 			}
 
-			int CBoxAlgorithmOnnxClassifier::runOnnxInference(const std::vector<const OpenViBE::CMatrix *> &inputMatrices)
+			void CBoxAlgorithmOnnxClassifier::bindInputTensor(const size_t index, CMatrix &matrix)
 			{
-				// Convert to ONNX tensors
-				std::vector<Ort::Value> onnxInputTensors;
-				onnxInputTensors.reserve(m_numInputs);
+				// Batch of one, remaining dimensions come from the stream header (this also resolves dynamic axes)
+				std::vector<int64_t> &shape = m_tensorShapes[index];
+				shape.assign(1, 1);
+				for (size_t dim = 0; dim < matrix.getDimensionCount(); ++dim)
+				{
+					shape.push_back(int64_t(matrix.getDimensionSize(dim)));
+				}
+
+				const size_t elementCount = matrix.getBufferElementCount();
+				if (m_inputTypes[index] == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+				{
+					// The model consumes doubles: wrap the decoder buffer itself, no conversion nor copy per chunk
+					double *buffer = matrix.getBuffer();
+					m_boundBuffers[index] = buffer;
+					m_inputTensors[index] = Ort::Value::CreateTensor<double>(m_memoryInfo, buffer, elementCount, shape.data(), shape.size());
+				}
+				else
+				{
+					m_inputBuffers[index].resize(elementCount);
+					m_boundBuffers[index] = nullptr;
+					m_inputTensors[index] = Ort::Value::CreateTensor<float>(
+							m_memoryInfo, m_inputBuffers[index].data(), elementCount, shape.data(), shape.size());
+				}
+
+				if (m_ioBinding)
+				{
+					m_ioBinding->BindInput(m_inputNamePtrs[index], m_inputTensors[index]);
+				}
+			}
+
+			void CBoxAlgorithmOnnxClassifier::bindOutputTensor()
+			{
+				// Batch of one; other dynamic axes are only known after a run, in which case ONNX Runtime allocates the output
+				std::vector<int64_t> shape = m_outputShape;
+				if (!shape.empty() && shape[0] <= 0)
+				{
+					shape[0] = 1;
+				}
+				const bool isStatic = std::all_of(shape.begin(), shape.end(), [](const int64_t dim) { return dim > 0; });
+
+				if (isStatic && m_outputType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+				{
+					const size_t elementCount = std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+					m_outputBuffer.resize(elementCount);
+					m_outputTensor = Ort::Value::CreateTensor<float>(m_memoryInfo, m_outputBuffer.data(), elementCount, shape.data(), shape.size());
+					m_ioBinding->BindOutput(m_outputNamePtrs[0], m_outputTensor);
+				}
+				else
+				{
+					m_ioBinding->BindOutput(m_outputNamePtrs[0], m_memoryInfo);
+				}
+
+				// Score outputs other than the first are allocated by ONNX Runtime
+				for (size_t i = 1; i < m_runOutputCount; ++i)
+				{
+					m_ioBinding->BindOutput(m_outputNamePtrs[i], m_memoryInfo);
+				}
+			}
+
+			int CBoxAlgorithmOnnxClassifier::runOnnxInference(const std::vector<CMatrix *> &inputMatrices, SPhaseTimes &times)
+			{
+				// Refresh the persistent input tensors
+				auto phaseStartTime = std::chrono::high_resolution_clock::now();
 				for (size_t i = 0; i < m_numInputs; ++i)
 				{
-					const CMatrix *matrix = inputMatrices[i];
+					CMatrix *matrix = inputMatrices[i];
 					const double *buffer = matrix->getBuffer();
-					size_t elementCount = matrix->getBufferElementCount();
+					const size_t elementCount = matrix->getBufferElementCount();
+
+					if (m_inputTypes[i] == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+					{
+						// Tensor already wraps the decoder buffer, only rebind if it was reallocated
+						if (buffer != m_boundBuffers[i])
+						{
+							bindInputTensor(i, *matrix);
+						}
+						continue;
+					}
 
-					// Reuse pre-allocated buffer
-					m_inputBuffers[i].resize(elementCount);
-					for (size_t j = 0; j < elementCount; ++j)
+					if (elementCount != m_inputBuffers[i].size())
 					{
-						m_inputBuffers[i][j] = static_cast<float>(buffer[j]);
+						bindInputTensor(i, *matrix);
 					}
 
-					onnxInputTensors.push_back(
-							Ort::Value::CreateTensor<float>(
-									m_memoryInfo,
-									m_inputBuffers[i].data(),
-									m_inputBuffers[i].size(),
-									m_inputShapes[i].data(),
-									m_inputShapes[i].size()));
+					// Straight contiguous loop, vectorized by the compiler into packed double to float conversions
+					std::transform(buffer, buffer + elementCount, m_inputBuffers[i].begin(), [](const double value) { return static_cast<float>(value); });
 				}
 
-				// Prepare output names
-				const char *outputNames[] = {m_outputName.toASCIIString()};
+				times[ELatencyPhase::Convert] = millisecondsSince(phaseStartTime);
 
 				// Run inference
-				auto outputTensors = m_onnxSession->Run(
-						Ort::RunOptions{nullptr},
-						m_inputNamePtrs.data(),
-						onnxInputTensors.data(),
-						m_numInputs,
-						outputNames,
-						1);
+				phaseStartTime = std::chrono::high_resolution_clock::now();
+				std::vector<Ort::Value> outputTensors;
+				if (m_ioBinding)
+				{
+					m_onnxSession->Run(Ort::RunOptions{nullptr}, *m_ioBinding);
+					if (!m_outputTensor || m_scoreOutputCount > 0)
+					{
+						outputTensors = m_ioBinding->GetOutputValues();
+					}
+				}
+				else
+				{
+					outputTensors = m_onnxSession->Run(
+							Ort::RunOptions{nullptr},
+							m_inputNamePtrs.data(),
+							m_inputTensors.data(),
+							m_numInputs,
+							m_outputNamePtrs.data(),
+							m_runOutputCount);
+				}
+				Ort::Value &output = m_outputTensor ? m_outputTensor : outputTensors[0];
+				times[ELatencyPhase::Run] = millisecondsSince(phaseStartTime);
 
-				// Get output data (probabilities for each class)
-				float *outputData = outputTensors[0].GetTensorMutableData<float>();
+				phaseStartTime = std::chrono::high_resolution_clock::now();
+				const int predictedClass = predictClass(output, 0);
+				times[ELatencyPhase::Argmax] = millisecondsSince(phaseStartTime);
+
+				captureScores(outputTensors.data(), 0, m_scores);
+				return predictedClass;
+			}
 
-				// Log raw outputs
-				this->getLogManager() << Kernel::LogLevel_Debug << "Raw outputs: [";
-				for (size_t i = 0; i < m_numClasses; ++i)
+			int CBoxAlgorithmOnnxClassifier::predictClass(Ort::Value &output, const size_t row)
+			{
+				// Get output data (probabilities for each class)
+				const bool isDoubleOutput = (m_outputType == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE);
+				const size_t offset = row * m_numClasses;
+				const float *floatData = isDoubleOutput ? nullptr : output.GetTensorMutableData<float>() + offset;
+				const double *doubleData = isDoubleOutput ? output.GetTensorMutableData<double>() + offset : nullptr;
+				auto outputData = [&](const size_t i) { return isDoubleOutput ? doubleData[i] : double(floatData[i]); };
+
+				// Log raw outputs (the worker thread of the asynchronous mode does not log)
+				const bool logScores = !m_asyncInference;
+				if (logScores)
 				{
-					this->getLogManager() << outputData[i];
-					if (i < m_numClasses - 1)
-						this->getLogManager() << ", ";
+					this->getLogManager() << Kernel::LogLevel_Debug << "Raw outputs: [";
+					for (size_t i = 0; i < m_numClasses; ++i)
+					{
+						this->getLogManager() << outputData(i);
+						if (i < m_numClasses - 1)
+							this->getLogManager() << ", ";
+					}
+					this->getLogManager() << "] ";
 				}
-				this->getLogManager() << "] ";
 
 				// Find class with highest probability
 				int predictedClass = 0;
-				float maxProb = outputData[0];
+				double maxProb = outputData(0);
 				for (size_t i = 1; i < m_numClasses; ++i)
 				{
-					if (outputData[i] > maxProb)
+					if (outputData(i) > maxProb)
 					{
-						maxProb = outputData[i];
+						maxProb = outputData(i);
 						predictedClass = i;
 					}
 				}
 
-				this->getLogManager()
-						<< "Predicted class: " << predictedClass
-						<< " (value: " << maxProb << ")\n";
+				if (logScores)
+				{
+					this->getLogManager()
+							<< "Predicted class: " << predictedClass
+							<< " (value: " << maxProb << ")\n";
+				}
 
 				return predictedClass;
 			}
 
+			void CBoxAlgorithmOnnxClassifier::stageBatchRow(const std::vector<CMatrix *> &inputMatrices, const uint64_t endTime, const double decodeTime)
+			{
+				if (m_batchEndTimes.empty())
+				{
+					// Row layout of the whole batch is the one of the current header
+					m_batchShapes = m_tensorShapes;
+				}
+
+				for (size_t i = 0; i < m_numInputs; ++i)
+				{
+					const double *buffer = inputMatrices[i]->getBuffer();
+					m_batchInputs[i].insert(m_batchInputs[i].end(), buffer, buffer + inputMatrices[i]->getBufferElementCount());
+				}
+				m_batchEndTimes.push_back(endTime);
+				m_batchTimes.emplace_back();
+				m_batchTimes.back()[ELatencyPhase::Decode] = decodeTime;
+			}
+
+			std::vector<int> CBoxAlgorithmOnnxClassifier::runBatchedInference()
+			{
+				const size_t batchSize = m_batchEndTimes.size();
+
+				auto phaseStartTime = std::chrono::high_resolution_clock::now();
+				for (size_t i = 0; i < m_numInputs; ++i)
+				{
+					std::vector<int64_t> &shape = m_batchShapes[i];
+					shape[0] = int64_t(batchSize);
+
+					std::vector<double> &rows = m_batchInputs[i];
+					const void *data = rows.data();
+					if (m_inputTypes[i] != ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+					{
+						m_batchConverted[i].resize(rows.size());
+						std::transform(rows.begin(), rows.end(), m_batchConverted[i].begin(), [](const double value) { return static_cast<float>(value); });
+						data = m_batchConverted[i].data();
+					}
+
+					// Same batch size and buffers as the previous run: the tensor already wraps the rows
+					if (data == m_batchTensorData[i] && shape == m_batchTensorShapes[i])
+					{
+						continue;
+					}
+					if (m_inputTypes[i] == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+					{
+						m_batchTensors[i] = Ort::Value::CreateTensor<double>(m_memoryInfo, rows.data(), rows.size(), shape.data(), shape.size());
+					}
+					else
+					{
+						m_batchTensors[i] = Ort::Value::CreateTensor<float>(
+								m_memoryInfo, m_batchConverted[i].data(), rows.size(), shape.data(), shape.size());
+					}
+					m_batchTensorData[i] = data;
+					m_batchTensorShapes[i] = shape;
+					if (m_batchBinding)
+					{
+						m_batchBinding->BindInput(m_inputNamePtrs[i], m_batchTensors[i]);
+					}
+				}
+
+				const double convertTime = millisecondsSince(phaseStartTime);
+
+				phaseStartTime = std::chrono::high_resolution_clock::now();
+				std::vector<Ort::Value> outputTensors;
+				if (m_batchBinding)
+				{
+					m_onnxSession->Run(Ort::RunOptions{nullptr}, *m_batchBinding);
+					outputTensors = m_batchBinding->GetOutputValues();
+				}
+				else
+				{
+					outputTensors = m_onnxSession->Run(
+							Ort::RunOptions{nullptr},
+							m_inputNamePtrs.data(),
+							m_batchTensors.data(),
+							m_numInputs,
+							m_outputNamePtrs.data(),
+							m_runOutputCount);
+				}
+				const double runTime = millisecondsSince(phaseStartTime);
+
+				phaseStartTime = std::chrono::high_resolution_clock::now();
+				std::vector<int> predictedClasses;
+				predictedClasses.reserve(batchSize);
+				for (size_t row = 0; row < batchSize; ++row)
+				{
+					predictedClasses.push_back(predictClass(outputTensors[0], row));
+				}
+				const double argmaxTime = millisecondsSince(phaseStartTime);
+
+				for (auto &times : m_batchTimes)
+				{
+					times[ELatencyPhase::Convert] = convertTime / double(batchSize);
+					times[ELatencyPhase::Run]     = runTime / double(batchSize);
+					times[ELatencyPhase::Argmax]  = argmaxTime / double(batchSize);
+				}
+
+				m_batchScores.resize(batchSize);
+				for (size_t row = 0; row < batchSize; ++row)
+				{
+					captureScores(outputTensors.data(), row, m_batchScores[row]);
+				}
+				return predictedClasses;
+			}
+
+			bool CBoxAlgorithmOnnxClassifier::flushInference(const bool waitForWorker)
+			{
+				if (!m_asyncInference)
+				{
+					return flushBatch();
+				}
+
+				if (waitForWorker)
+				{
+					m_queue.waitIdle();
+				}
+				return emitAsyncResults();
+			}
+
+			bool CBoxAlgorithmOnnxClassifier::queueAsyncInference(const std::vector<CMatrix *> &inputMatrices, const uint64_t endTime, const double decodeTime)
+			{
+				// With the Wait policy results will be late, but none is lost
+				SInferenceJob job;
+				switch (m_queue.reserve(job))
+				{
+					case CInferenceQueue::EStatus::Dropped:
+						if (m_queue.droppedCount() == 1)
+						{
+							this->getLogManager() << Kernel::LogLevel_Warning << "Inference queue is full, dropping chunks.\n";
+						}
+						return true;
+					case CInferenceQueue::EStatus::Failed:
+						this->getLogManager() << Kernel::LogLevel_Error << "ONNX asynchronous inference failed: " << m_queue.takeError() << "\n";
+						return false;
+					case CInferenceQueue::EStatus::Queued:
+						break;
+				}
+
+				// Decoder matrices are overwritten by the next chunk, the worker gets its own copy
+				job.inputs.resize(m_numInputs);
+				for (size_t i = 0; i < m_numInputs; ++i)
+				{
+					const double *buffer = inputMatrices[i]->getBuffer();
+					job.inputs[i].assign(buffer, buffer + inputMatrices[i]->getBufferElementCount());
+				}
+				job.endTime = endTime;
+				job.decodeTime = decodeTime;
+				job.queueTime = std::chrono::high_resolution_clock::now();
+				m_queue.push(std::move(job));
+				return true;
+			}
+
+			void CBoxAlgorithmOnnxClassifier::inferenceWorker()
+			{
+				std::vector<SInferenceJob> jobs;
+
+				// Take every queued chunk when batching is possible, the oldest one otherwise
+				while (m_queue.take(m_batchChunks, jobs))
+				{
+					// Shapes are stable here: headers wait for the queue to be empty before rebinding.
+					m_batchShapes = m_tensorShapes;
+					m_batchEndTimes.clear();
+					m_batchTimes.clear();
+					for (const SInferenceJob &job : jobs)
+					{
+						// Copied rather than swapped, so that the batch tensors keep wrapping the same rows
+						for (size_t i = 0; i < m_numInputs; ++i)
+						{
+							m_batchInputs[i].insert(m_batchInputs[i].end(), job.inputs[i].begin(), job.inputs[i].end());
+						}
+						m_batchEndTimes.push_back(job.endTime);
+						m_batchTimes.emplace_back();
+						m_batchTimes.back()[ELatencyPhase::Decode] = job.decodeTime;
+					}
+
+					std::vector<int> predictedClasses;
+					std::string error;
+					try
+					{
+						predictedClasses = runBatchedInference();
+					}
+					catch (const Ort::Exception &e)
+					{
+						error = e.what();
+					}
+					const auto doneTime = std::chrono::high_resolution_clock::now();
+					for (auto &rows : m_batchInputs)
+					{
+						rows.clear();
+					}
+
+					// Results are ready before the jobs leave the flight, so waiting for the queue to be idle waits for them too
+					if (error.empty())
+					{
+						std::lock_guard<std::mutex> lock(m_resultMutex);
+						for (size_t row = 0; row < jobs.size(); ++row)
+						{
+							SPhaseTimes &times = m_batchTimes[row];
+							times[ELatencyPhase::Total] = std::chrono::duration<double, std::milli>(doneTime - jobs[row].queueTime).count();
+							m_results.push_back({m_batchEndTimes[row], predictedClasses[row], times, std::move(m_batchScores[row])});
+						}
+					}
+					m_queue.release(jobs, error);
+				}
+			}
+
+			bool CBoxAlgorithmOnnxClassifier::emitAsyncResults()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_resultMutex);
+					m_readyResults.swap(m_results);
+				}
+				const std::string error = m_queue.takeError();
+
+				if (!error.empty())
+				{
+					this->getLogManager() << Kernel::LogLevel_Error << "ONNX asynchronous inference failed: " << error << "\n";
+					return false;
+				}
+
+				Kernel::IBoxIO &boxCtx = this->getDynamicBoxContext();
+				for (auto &result : m_readyResults)
+				{
+					CStimulationSet *stimSet = m_stimEncoder.getInputStimulationSet();
+					stimSet->clear();
+					stimSet->push_back(OVTK_StimulationId_Label_01 + result.predictedClass, result.endTime, 0);
+
+					const auto encodeStartTime = std::chrono::high_resolution_clock::now();
+					m_stimEncoder.encodeBuffer();
+					boxCtx.markOutputAsReadyToSend(0, result.endTime, result.endTime);
+					sendScores(result.scores, result.endTime);
+
+					// Total latency includes the time spent waiting in the queue
+					SPhaseTimes &times = result.times;
+					times[ELatencyPhase::Encode] = millisecondsSince(encodeStartTime);
+					times[ELatencyPhase::Total] += times[ELatencyPhase::Decode] + times[ELatencyPhase::Encode];
+					recordLatency(times, result.endTime);
+				}
+				m_readyResults.clear();
+				return true;
+			}
+
+			bool CBoxAlgorithmOnnxClassifier::flushBatch()
+			{
+				if (m_batchEndTimes.empty())
+				{
+					return true;
+				}
+
+				Kernel::IBoxIO &boxCtx = this->getDynamicBoxContext();
+				const auto startTime = std::chrono::high_resolution_clock::now();
+				const size_t batchSize = m_batchEndTimes.size();
+
+				std::vector<int> predictedClasses;
+				try
+				{
+					predictedClasses = runBatchedInference();
+				}
+				catch (const Ort::Exception &e)
+				{
+					this->getLogManager() << Kernel::LogLevel_Error
+																<< "ONNX batched inference failed: " << e.what() << "\n";
+					return false;
+				}
+
+				// One label per stacked chunk, stamped with the end time of that chunk
+				for (size_t row = 0; row < batchSize; ++row)
+				{
+					CStimulationSet *stimSet = m_stimEncoder.getInputStimulationSet();
+					stimSet->clear();
+					stimSet->push_back(OVTK_StimulationId_Label_01 + predictedClasses[row], m_batchEndTimes[row], 0);
+
+					const auto encodeStartTime = std::chrono::high_resolution_clock::now();
+					m_stimEncoder.encodeBuffer();
+					boxCtx.markOutputAsReadyToSend(0, m_batchEndTimes[row], m_batchEndTimes[row]);
+					sendScores(m_batchScores[row], m_batchEndTimes[row]);
+
+					// Time spent waiting for the rest of the batch is not part of the chunk latency
+					SPhaseTimes &times = m_batchTimes[row];
+					times[ELatencyPhase::Encode] = millisecondsSince(encodeStartTime);
+					times[ELatencyPhase::Total]  = times[ELatencyPhase::Decode] + times[ELatencyPhase::Convert] + times[ELatencyPhase::Run]
+												  + times[ELatencyPhase::Argmax] + times[ELatencyPhase::Encode];
+					recordLatency(times, m_batchEndTimes[row]);
+				}
+
+				for (auto &rows : m_batchInputs)
+				{
+					rows.clear();
+				}
+				m_batchEndTimes.clear();
+				m_batchTimes.clear();
+
+				this->getLogManager() << Kernel::LogLevel_Debug
+															<< "Batch of " << batchSize << " buffers processed in " << millisecondsSince(startTime) << " ms\n";
+				return true;
+			}
+
+			void CBoxAlgorithmOnnxClassifier::captureScores(const Ort::Value *outputs, const size_t row, std::vector<SScoreRow> &scores) const
+			{
+				// Copied, as the tensors of a run do not outlive it
+				scores.resize(m_scoreOutputCount);
+				for (size_t i = 0; i < m_scoreOutputCount; ++i)
+				{
+					copyTensorRow(outputs[i], row, scores[i].values, scores[i].dims);
+				}
+			}
+
+			void CBoxAlgorithmOnnxClassifier::sendScores(const std::vector<SScoreRow> &scores, const uint64_t endTime)
+			{
+				Kernel::IBoxIO &boxCtx = this->getDynamicBoxContext();
+				for (size_t i = 0; i < m_scoreOutputCount; ++i)
+				{
+					const SScoreRow &score = scores[i];
+					CMatrix *matrix = m_scoreEncoders[i]->getInputMatrix();
+
+					// Dynamic axes are only known after a run: the header follows the first result, and any change of shape
+					if (score.dims != m_scoreHeaderDims[i])
+					{
+						matrix->resize(score.dims);
+						m_scoreEncoders[i]->encodeHeader();
+						boxCtx.markOutputAsReadyToSend(SCORE_OUTPUT_OFFSET + i, endTime, endTime);
+						m_scoreHeaderDims[i] = score.dims;
+					}
+
+					std::copy(score.values.begin(), score.values.end(), matrix->getBuffer());
+					m_scoreEncoders[i]->encodeBuffer();
+					boxCtx.markOutputAsReadyToSend(SCORE_OUTPUT_OFFSET + i, endTime, endTime);
+				}
+			}
+
+			void CBoxAlgorithmOnnxClassifier::recordLatency(const SPhaseTimes &times, const uint64_t endTime)
+			{
+				for (size_t i = 0; i < LATENCY_PHASE_COUNT; ++i)
+				{
+					m_latencyHistograms[i].record(times.ms[i]);
+				}
+
+				if (m_latencyCsv.is_open())
+				{
+					m_latencyCsv << CTime(endTime).toSeconds();
+					for (const double ms : times.ms)
+					{
+						m_latencyCsv << "," << ms;
+					}
+					m_latencyCsv << "\n";
+				}
+
+				m_hasNewLatency = true;
+				m_lastLatencyTime = endTime;
+			}
+
+			void CBoxAlgorithmOnnxClassifier::sendLatencyReport()
+			{
+				// Percentiles are cumulative since the start, sent at most once per process()
+				if (!m_latencyOutput || !m_hasNewLatency)
+				{
+					return;
+				}
+
+				double *buffer = m_latencyEncoder.getInputMatrix()->getBuffer();
+				for (size_t i = 0; i < LATENCY_PHASE_COUNT; ++i)
+				{
+					for (size_t j = 0; j < LATENCY_PERCENTILE_COUNT; ++j)
+					{
+						buffer[i * LATENCY_PERCENTILE_COUNT + j] = m_latencyHistograms[i].percentile(LATENCY_PERCENTILES[j]);
+					}
+				}
+				m_latencyEncoder.encodeBuffer();
+				this->getDynamicBoxContext().markOutputAsReadyToSend(1, m_lastLatencyTime, m_lastLatencyTime);
+				m_hasNewLatency = false;
+			}
+
 			bool CBoxAlgorithmOnnxClassifierListener::onSettingValueChanged(Kernel::IBox &box, const size_t index)
 			{
-				if (index != 0)
+				// Scenarios saved before the setting had an identifier only know it by name
+				size_t outputScoresIdx = 0;
+				if (!box.getInterfacorIndex(Kernel::EBoxInterfacorType::Setting, CBoxAlgorithmOnnxClassifier::SettingOutputScoresID(), outputScoresIdx)
+					&& !box.getInterfacorIndex(Kernel::EBoxInterfacorType::Setting, CString("Output Scores"), outputScoresIdx))
+				{
+					return true;
+				}
+				if (index != 0 && index != outputScoresIdx)
 				{
-					return true; // Only react to first setting (model path)
+					return true; // Only react to the model path and to the score outputs switch
 				}
 
 				CString modelPath;
-				box.getSettingValue(index, modelPath);
+				box.getSettingValue(0, modelPath);
+				CString outputScores;
+				box.getSettingValue(outputScoresIdx, outputScores);
+				const bool withScores = this->getConfigurationManager().expandAsBoolean(outputScores, false);
+
+				// Score outputs always follow the classification and latency outputs
+				while (box.getOutputCount() > SCORE_OUTPUT_OFFSET)
+				{
+					box.removeOutput(SCORE_OUTPUT_OFFSET);
+				}
+				if (index == outputScoresIdx && (!withScores || modelPath.length() == 0))
+				{
+					return true;
+				}
 
 				size_t numOutputs;
 				size_t numInputs;
 				std::vector<std::string> inputNames;
+				std::vector<std::string> outputNames;
 
 				try
 				{
-					Ort::Env env(ORT_LOGGING_LEVEL_ERROR, "MetadataReader");
+					// Only the model metadata is read, the session runs on the calling thread
+					bool globalThreadPools = false;
+					int intraOpThreads = 1;
+					int interOpThreads = 1;
+					const std::shared_ptr<Ort::Env> env = acquireSharedEnv(globalThreadPools, intraOpThreads, interOpThreads);
 
 					Ort::SessionOptions options;
 					options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_DISABLE_ALL);
+					if (globalThreadPools)
+					{
+						options.DisablePerSessionThreads();
+					}
+					else
+					{
+						options.SetIntraOpNumThreads(1);
+						options.SetInterOpNumThreads(1);
+					}
 
-					Ort::Session session(env, modelPath.toASCIIString(), options);
+					Ort::Session session(*env, modelPath.toASCIIString(), options);
 
 					Ort::AllocatorWithDefaultOptions allocator;
 
@@ -518,6 +1503,10 @@ namespace OpenViBE
 
 					// Get number of outputs
 					numOutputs = session.GetOutputCount();
+					for (size_t i = 0; i < numOutputs; ++i)
+					{
+						outputNames.push_back(std::string(session.GetOutputNameAllocated(i, allocator).get()));
+					}
 				}
 				catch (const Ort::Exception &e)
 				{
@@ -534,15 +1523,33 @@ namespace OpenViBE
 					return false;
 				}
 
-				// Log warning if multiple outputs (but don't block)
-				if (numOutputs > 1)
+				// Log if multiple outputs (but don't block)
+				if (numOutputs > 1 && !withScores)
 				{
-					this->getLogManager() << Kernel::LogLevel_Warning
+					this->getLogManager() << Kernel::LogLevel_Info
 																<< "ONNX model has " << numOutputs << " outputs. Using first output for classification.\n";
 				}
 
+				if (withScores)
+				{
+					// Scenarios saved before the latency output was added only have the classification one
+					if (box.getOutputCount() < SCORE_OUTPUT_OFFSET)
+					{
+						box.addOutput("Latency Percentiles", OV_TypeId_StreamedMatrix);
+					}
+					for (const auto &name : outputNames)
+					{
+						box.addOutput(name.c_str(), OV_TypeId_StreamedMatrix);
+					}
+				}
+
+				if (index != 0)
+				{
+					return true;
+				}
+
 				// Clear current inputs
-				for (size_t i = 0; i < box.getInputCount(); ++i)
+				while (box.getInputCount() > 0)
 				{
 					box.removeInput(0);
 				}
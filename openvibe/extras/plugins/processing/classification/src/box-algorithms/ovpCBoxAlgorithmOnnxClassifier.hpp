@@ -12,13 +12,20 @@
 
 // You may have to change this path to match your folder organisation
 #include "../ovp_defines.h"
+#include "ovpCInferenceQueue.hpp"
+#include "ovpCLatencyHistogram.hpp"
 
 #include <openvibe/ov_all.h>
 #include <toolkit/ovtk_all.h>
 #include <onnxruntime/core/session/onnxruntime_cxx_api.h>
+#include <array>
 #include <memory>
+#include <string>
 #include <vector>
 #include <chrono>
+#include <fstream>
+#include <mutex>
+#include <thread>
 
 // The unique identifiers for the box and its descriptor.
 // Identifier are randomly chosen by the skeleton-generator.
@@ -32,13 +39,24 @@ namespace OpenViBE
 	{
 		namespace Classification
 		{
+			/// <summary> Phases of the processing of one chunk, profiled separately. </summary>
+			enum class ELatencyPhase : size_t { Decode = 0, Convert, Run, Argmax, Encode, Total };
+			constexpr size_t LATENCY_PHASE_COUNT = 6;
+
+			/// <summary> Time spent in each phase for one chunk, in milliseconds. Phases shared by a batch are amortized over its chunks. </summary>
+			struct SPhaseTimes
+			{
+				std::array<double, LATENCY_PHASE_COUNT> ms{};
+				double &operator[](const ELatencyPhase phase) { return ms[size_t(phase)]; }
+				double operator[](const ELatencyPhase phase) const { return ms[size_t(phase)]; }
+			};
+
 			/// <summary> The class CBoxAlgorithmOnnxClassifier describes the box ONNX Classifier. </summary>
 			class CBoxAlgorithmOnnxClassifier final : virtual public Toolkit::TBoxAlgorithm<IBoxAlgorithm>
 			{
 			public:
 				CBoxAlgorithmOnnxClassifier()
-					: m_onnxEnv(ORT_LOGGING_LEVEL_WARNING, "ONNXClassifier"),
-					  m_memoryInfo(Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault))
+					: m_memoryInfo(Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault))
 				{
 				}
 
@@ -47,16 +65,18 @@ namespace OpenViBE
 				bool uninitialize() override;
 
 				// Here is the different process callbacks possible
-				//  - On clock ticks :
-				// bool processClock(Kernel::CMessageClock& msg) override;
+				//  - On clock ticks (polls the results of the asynchronous mode) :
+				bool processClock(Kernel::CMessageClock &msg) override;
 				//  - On new input received (the most common behaviour for signal processing) :
 				bool processInput(const size_t index) override;
 
-				// If you want to use processClock, you must provide the clock frequency.
-				// uint64_t getClockFrequency() override { return 1LL<<32; }
+				// The clock is only needed to emit asynchronous results when no input arrives.
+				uint64_t getClockFrequency() override { return m_asyncInference ? 64LL << 32 : 0; }
 
 				bool process() override;
 
+				static CIdentifier SettingOutputScoresID() { return CIdentifier(0x5E0C2A71, 0x13B94D8F); }
+
 				// As we do with any class in openvibe, we use the macro below to associate this box to an unique identifier.
 				// The inheritance information is also made available, as we provide the superclass Toolkit::TBoxAlgorithm < IBoxAlgorithm >
 			_IsDerivedFromClass_Final_(Toolkit::TBoxAlgorithm<IBoxAlgorithm>, Box_OnnxClassifier)
@@ -67,20 +87,57 @@ namespace OpenViBE
 
 				// Output decoder:
 				Toolkit::TStimulationEncoder<CBoxAlgorithmOnnxClassifier> m_stimEncoder;
+				Toolkit::TStreamedMatrixEncoder<CBoxAlgorithmOnnxClassifier> m_latencyEncoder;
+				std::vector<Toolkit::TStreamedMatrixEncoder<CBoxAlgorithmOnnxClassifier> *> m_scoreEncoders;
 
 			private:
-				int runOnnxInference(const std::vector<const CMatrix *> &inputMatrices);
+				/// <summary> One batch row of a model output, kept as the scores of one chunk. </summary>
+				struct SScoreRow
+				{
+					std::vector<double> values;
+					std::vector<size_t> dims;
+				};
+
+				int runOnnxInference(const std::vector<CMatrix *> &inputMatrices, SPhaseTimes &times);
+				int predictClass(Ort::Value &output, size_t row);
+				void stageBatchRow(const std::vector<CMatrix *> &inputMatrices, uint64_t endTime, double decodeTime);
+				std::vector<int> runBatchedInference();
+				bool flushBatch();
+				bool flushInference(bool waitForWorker);
+				bool queueAsyncInference(const std::vector<CMatrix *> &inputMatrices, uint64_t endTime, double decodeTime);
+				void inferenceWorker();
+				bool emitAsyncResults();
 				void initializeOnnxSession(const CString &modelPath);
-				// ONNX Runtime members
-				Ort::Env m_onnxEnv;
+				void bindInputTensor(size_t index, CMatrix &matrix);
+				void bindOutputTensor();
+				void captureScores(const Ort::Value *outputs, size_t row, std::vector<SScoreRow> &scores) const;
+				void sendScores(const std::vector<SScoreRow> &scores, uint64_t endTime);
+				void recordLatency(const SPhaseTimes &times, uint64_t endTime);
+				void sendLatencyReport();
+				// ONNX Runtime members, the environment is shared by all ONNX boxes of the process
+				std::shared_ptr<Ort::Env> m_onnxEnv;
 				std::unique_ptr<Ort::Session> m_onnxSession;
 				Ort::SessionOptions m_sessionOptions;
+				std::unique_ptr<Ort::IoBinding> m_ioBinding;
+				bool m_useIoBinding = true;
+
+				// Session configuration
+				bool m_useSharedThreadPool = true;
+				int m_intraOpThreads = 1;
+				int m_interOpThreads = 1;
+				GraphOptimizationLevel m_optimizationLevel = GraphOptimizationLevel::ORT_ENABLE_BASIC;
+				ExecutionMode m_executionMode = ExecutionMode::ORT_SEQUENTIAL;
+				std::string m_optimizedModelPath;
 
 				// Model metadata
 				size_t m_numInputs;
 				std::vector<std::vector<int64_t>> m_inputShapes;
+				std::vector<ONNXTensorElementDataType> m_inputTypes;
 				std::vector<CString> m_inputNames;
-				CString m_outputName;
+				std::vector<CString> m_outputNames;
+				std::vector<const char *> m_outputNamePtrs;
+				std::vector<int64_t> m_outputShape;
+				ONNXTensorElementDataType m_outputType = ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
 				size_t m_numClasses;
 
 				// Pre-allocated resources for inference
@@ -88,9 +145,59 @@ namespace OpenViBE
 				std::vector<const char *> m_inputNamePtrs;
 				std::vector<std::vector<float>> m_inputBuffers;
 
-				// Latency profiling
-				double m_totalProcessingTime = 0.0;
-				size_t m_bufferCount = 0;
+				// Persistent tensors, created once per stream header and reused for every chunk.
+				// Float inputs wrap m_inputBuffers, double inputs wrap the decoder matrix buffer directly.
+				std::vector<std::vector<int64_t>> m_tensorShapes;
+				std::vector<Ort::Value> m_inputTensors;
+				std::vector<const double *> m_boundBuffers;
+				std::vector<float> m_outputBuffer;
+				Ort::Value m_outputTensor{nullptr};
+
+				// Micro-batching: buffers pending in one process() call are stacked along the batch dimension
+				bool m_batchChunks = false;
+				std::vector<std::vector<double>> m_batchInputs;
+				std::vector<std::vector<float>> m_batchConverted;
+				std::vector<std::vector<int64_t>> m_batchShapes;
+				std::vector<uint64_t> m_batchEndTimes;
+				std::vector<SPhaseTimes> m_batchTimes;
+				std::vector<std::vector<SScoreRow>> m_batchScores;
+
+				// Persistent batch tensors, recreated only when the batch size or the wrapped buffer changes.
+				// Double inputs wrap m_batchInputs, float inputs wrap m_batchConverted.
+				std::vector<Ort::Value> m_batchTensors;
+				std::vector<std::vector<int64_t>> m_batchTensorShapes;
+				std::vector<const void *> m_batchTensorData;
+				std::unique_ptr<Ort::IoBinding> m_batchBinding;
+
+				// Raw output tensors: model output k is streamed on box output k + 2 when the box has it.
+				// Only the first model output is fetched when no score output is used.
+				size_t m_scoreOutputCount = 0;
+				size_t m_runOutputCount = 1;
+				std::vector<SScoreRow> m_scores;
+				std::vector<std::vector<size_t>> m_scoreHeaderDims;
+
+				// Asynchronous mode: chunks are classified by a worker thread, which owns the batch members above.
+				// Labels are emitted on a later process() with the end time of their chunk.
+				struct SInferenceResult
+				{
+					uint64_t endTime;
+					int predictedClass;
+					SPhaseTimes times; // Total is the time from queueing to classification here
+					std::vector<SScoreRow> scores;
+				};
+				bool m_asyncInference = false;
+				std::thread m_worker;
+				CInferenceQueue m_queue;
+				std::mutex m_resultMutex;
+				std::vector<SInferenceResult> m_results; // Pushed by the worker before it releases the jobs, see inferenceWorker()
+				std::vector<SInferenceResult> m_readyResults;
+
+				// Latency profiling, one histogram per phase. Percentiles are also streamed on the optional second output.
+				std::array<CLatencyHistogram, LATENCY_PHASE_COUNT> m_latencyHistograms;
+				std::ofstream m_latencyCsv;
+				bool m_latencyOutput = false;
+				bool m_hasNewLatency = false;
+				uint64_t m_lastLatencyTime = 0;
 			};
 
 			class CBoxAlgorithmOnnxClassifierListener final : public Toolkit::TBoxListener<IBoxListener>
@@ -136,8 +243,22 @@ namespace OpenViBE
 					prototype.addInputSupport(OV_TypeId_ChannelLocalisation);
 
 					prototype.addOutput("Classification", OV_TypeId_Stimulations);
+					prototype.addOutput("Latency Percentiles", OV_TypeId_StreamedMatrix);
 
 					prototype.addSetting("Model Filepath", OV_TypeId_Filename, "");
+					prototype.addSetting("Use IO Binding", OV_TypeId_Boolean, "true");
+					prototype.addSetting("Batch Pending Chunks", OV_TypeId_Boolean, "false");
+					prototype.addSetting("Share Thread Pool", OV_TypeId_Boolean, "true");
+					prototype.addSetting("Intra-op Threads", OV_TypeId_Integer, "1");
+					prototype.addSetting("Inter-op Threads", OV_TypeId_Integer, "1");
+					prototype.addSetting("Graph Optimization Level", OVP_TypeId_OnnxGraphOptimizationLevel, "Basic");
+					prototype.addSetting("Execution Mode", OVP_TypeId_OnnxExecutionMode, "Sequential");
+					prototype.addSetting("Optimized Model Cache", OV_TypeId_Filename, "");
+					prototype.addSetting("Asynchronous Inference", OV_TypeId_Boolean, "false");
+					prototype.addSetting("Max In-flight Chunks", OV_TypeId_Integer, "4");
+					prototype.addSetting("Queue Full Policy", OVP_TypeId_OnnxQueueFullPolicy, "Wait");
+					prototype.addSetting("Latency CSV File", OV_TypeId_Filename, "");
+					prototype.addSetting("Output Scores", OV_TypeId_Boolean, "false", false, CBoxAlgorithmOnnxClassifier::SettingOutputScoresID());
 
 					prototype.addFlag(OV_AttributeId_Box_FlagIsUnstable);
 					return true;
@@ -0,0 +1,129 @@
+#include "ovpCInferenceQueue.hpp"
+
+namespace OpenViBE
+{
+	namespace Plugins
+	{
+		namespace Classification
+		{
+			void CInferenceQueue::start(const size_t maxInFlight, const EOnnxQueueFullPolicy policy)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_jobs.clear();
+				m_error.clear();
+				m_maxInFlight  = maxInFlight;
+				m_policy       = policy;
+				m_inFlight     = 0;
+				m_droppedCount = 0;
+				m_isStopped    = false;
+			}
+
+			void CInferenceQueue::stop()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_isStopped = true;
+					m_inFlight -= m_jobs.size();
+					while (!m_jobs.empty())
+					{
+						m_freeJobs.push_back(std::move(m_jobs.front()));
+						m_jobs.pop_front();
+					}
+				}
+				m_jobQueued.notify_all();
+			}
+
+			CInferenceQueue::EStatus CInferenceQueue::reserve(SInferenceJob& job)
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				if (m_inFlight >= m_maxInFlight)
+				{
+					if (m_policy == EOnnxQueueFullPolicy::DropChunk)
+					{
+						m_droppedCount++;
+						return EStatus::Dropped;
+					}
+					m_jobDone.wait(lock, [this]() { return m_inFlight < m_maxInFlight || !m_error.empty(); });
+					// The chunk is not queued behind a broken session
+					if (!m_error.empty()) { return EStatus::Failed; }
+				}
+				if (!m_freeJobs.empty())
+				{
+					job = std::move(m_freeJobs.back());
+					m_freeJobs.pop_back();
+				}
+				return EStatus::Queued;
+			}
+
+			void CInferenceQueue::push(SInferenceJob&& job)
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_jobs.push_back(std::move(job));
+					m_inFlight++;
+				}
+				m_jobQueued.notify_one();
+			}
+
+			void CInferenceQueue::waitIdle()
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_jobDone.wait(lock, [this]() { return m_inFlight == 0 || !m_error.empty(); });
+			}
+
+			bool CInferenceQueue::take(const bool batch, std::vector<SInferenceJob>& jobs)
+			{
+				jobs.clear();
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_jobQueued.wait(lock, [this]() { return m_isStopped || !m_jobs.empty(); });
+				if (m_isStopped) { return false; }
+
+				const size_t count = batch ? m_jobs.size() : 1;
+				for (size_t i = 0; i < count; ++i)
+				{
+					jobs.push_back(std::move(m_jobs.front()));
+					m_jobs.pop_front();
+				}
+				return true;
+			}
+
+			void CInferenceQueue::release(std::vector<SInferenceJob>& jobs, const std::string& error)
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_inFlight -= jobs.size();
+					for (auto& job : jobs) { m_freeJobs.push_back(std::move(job)); }
+					if (!error.empty()) { m_error = error; }
+				}
+				jobs.clear();
+				m_jobDone.notify_all();
+			}
+
+			bool CInferenceQueue::hasError() const
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return !m_error.empty();
+			}
+
+			std::string CInferenceQueue::takeError()
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				std::string error;
+				error.swap(m_error);
+				return error;
+			}
+
+			size_t CInferenceQueue::inFlight() const
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_inFlight;
+			}
+
+			size_t CInferenceQueue::droppedCount() const
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_droppedCount;
+			}
+		}  // namespace Classification
+	}  // namespace Plugins
+}  // namespace OpenViBE
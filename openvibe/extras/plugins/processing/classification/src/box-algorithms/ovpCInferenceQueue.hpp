@@ -0,0 +1,102 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file ovpCInferenceQueue.hpp
+/// \brief Queue of the chunks waiting for the inference worker of the ONNX Classifier box.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OpenViBE
+{
+	namespace Plugins
+	{
+		namespace Classification
+		{
+			/// <summary> What the asynchronous mode does with a chunk when the inference queue is full. </summary>
+			enum class EOnnxQueueFullPolicy
+			{
+				DropChunk = 0, ///< The chunk is not classified, the scheduler is never blocked
+				Wait = 1       ///< The scheduler waits for a free slot, labels are late but none is lost
+			};
+
+			/// <summary> One chunk to classify, with its own copy of the input matrices. </summary>
+			struct SInferenceJob
+			{
+				std::vector<std::vector<double>> inputs;
+				uint64_t endTime = 0;
+				double decodeTime = 0.0;
+				std::chrono::high_resolution_clock::time_point queueTime;
+			};
+
+			/// <summary> Chunks queued by the box for its inference worker, bounded by the number of chunks in flight. </summary>
+			/// <remarks>
+			/// A chunk is in flight from the time it is queued until the worker releases it, so the chunks being classified count too.
+			/// Jobs are recycled once released, their buffers keep their capacity from one chunk to the next.
+			/// Every method is thread safe, the box thread queues the chunks and the worker thread takes them.
+			/// </remarks>
+			class CInferenceQueue final
+			{
+			public:
+				enum class EStatus
+				{
+					Queued,  ///< A slot is reserved, the job has to be pushed
+					Dropped, ///< The queue is full and the policy drops the chunk
+					Failed   ///< The worker failed while the box was waiting for a slot
+				};
+
+				/// <summary> Empties the queue and sets its bound, the worker can take jobs until it is stopped. </summary>
+				void start(size_t maxInFlight, EOnnxQueueFullPolicy policy);
+
+				/// <summary> Abandons the queued jobs and wakes the worker up, only the jobs already taken are still in flight. </summary>
+				void stop();
+
+				/// <summary> Reserves a slot for a chunk, applying the policy when the queue is full. </summary>
+				/// <param name="job"> Recycled job to fill when the slot is reserved. </param>
+				EStatus reserve(SInferenceJob& job);
+
+				/// <summary> Queues the job of the slot reserved last. </summary>
+				void push(SInferenceJob&& job);
+
+				/// <summary> Waits until no chunk is in flight anymore or the worker failed. </summary>
+				void waitIdle();
+
+				/// <summary> Waits for queued jobs and takes every one of them, or only the oldest when not batching. </summary>
+				/// <returns> False once the queue is stopped. </returns>
+				bool take(bool batch, std::vector<SInferenceJob>& jobs);
+
+				/// <summary> Ends the flight of the jobs taken, with the error of their inference if any. </summary>
+				void release(std::vector<SInferenceJob>& jobs, const std::string& error);
+
+				bool hasError() const;
+				/// <summary> Gives the error of the worker and clears it. </summary>
+				std::string takeError();
+
+				size_t inFlight() const;
+				size_t droppedCount() const;
+
+			private:
+				mutable std::mutex m_mutex;
+				std::condition_variable m_jobQueued;
+				std::condition_variable m_jobDone;
+				std::deque<SInferenceJob> m_jobs;
+				std::vector<SInferenceJob> m_freeJobs;
+				std::string m_error;
+				size_t m_maxInFlight = 1;
+				EOnnxQueueFullPolicy m_policy = EOnnxQueueFullPolicy::Wait;
+				size_t m_inFlight = 0;
+				size_t m_droppedCount = 0;
+				bool m_isStopped = false;
+			};
+		} // namespace Classification
+	} // namespace Plugins
+} // namespace OpenViBE
@@ -0,0 +1,80 @@
+#include "ovpCLatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OpenViBE
+{
+	namespace Plugins
+	{
+		namespace Classification
+		{
+			namespace
+			{
+				constexpr size_t SUB_BUCKET_BITS  = 7;
+				constexpr size_t SUB_BUCKET_COUNT = size_t(1) << SUB_BUCKET_BITS;	// Values below are recorded exactly
+				constexpr size_t SUB_BUCKET_HALF  = SUB_BUCKET_COUNT / 2;			// Linear buckets per power of two above
+				constexpr size_t MAX_VALUE_BITS   = 44;								// 2^44 ns is close to 5 hours, longer values are clamped
+				constexpr size_t BUCKET_COUNT     = SUB_BUCKET_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKET_HALF;
+			}  // namespace
+
+			CLatencyHistogram::CLatencyHistogram() : m_buckets(BUCKET_COUNT, 0) {}
+
+			void CLatencyHistogram::record(const double ms)
+			{
+				const uint64_t ns = ms <= 0.0 ? 0 : uint64_t(std::llround(ms * 1e6));
+				m_buckets[bucketIndex(ns)]++;
+				m_count++;
+				m_max = std::max(m_max, ns);
+				m_sum += ms;
+			}
+
+			void CLatencyHistogram::reset()
+			{
+				std::fill(m_buckets.begin(), m_buckets.end(), 0);
+				m_count = 0;
+				m_max   = 0;
+				m_sum   = 0.0;
+			}
+
+			double CLatencyHistogram::percentile(const double percent) const
+			{
+				if (m_count == 0) { return 0.0; }
+
+				const double clamped = std::min(std::max(percent, 0.0), 100.0);
+				const uint64_t rank  = std::max(uint64_t(1), uint64_t(std::ceil(clamped / 100.0 * double(m_count))));
+
+				uint64_t seen = 0;
+				for (size_t i = 0; i < m_buckets.size(); ++i)
+				{
+					seen += m_buckets[i];
+					if (seen >= rank) { return double(std::min(bucketHighestValue(i), m_max)) * 1e-6; }
+				}
+				return max();
+			}
+
+			size_t CLatencyHistogram::bucketIndex(const uint64_t ns)
+			{
+				if (ns < SUB_BUCKET_COUNT) { return size_t(ns); }
+
+				size_t msb = SUB_BUCKET_BITS;
+				while (msb + 1 < MAX_VALUE_BITS && (ns >> (msb + 1)) != 0) { msb++; }
+				if ((ns >> MAX_VALUE_BITS) != 0) { return BUCKET_COUNT - 1; }
+
+				// The top SUB_BUCKET_BITS - 1 bits below the most significant one select the linear sub-bucket
+				const size_t shift = msb - (SUB_BUCKET_BITS - 1);
+				const size_t sub   = size_t(ns >> shift) - SUB_BUCKET_HALF;
+				return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + sub;
+			}
+
+			uint64_t CLatencyHistogram::bucketHighestValue(const size_t index)
+			{
+				if (index < SUB_BUCKET_COUNT) { return uint64_t(index); }
+
+				const size_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1;
+				const uint64_t sub = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+				return ((sub + 1) << shift) - 1;
+			}
+		}  // namespace Classification
+	}  // namespace Plugins
+}  // namespace OpenViBE
@@ -0,0 +1,53 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file ovpCLatencyHistogram.hpp
+/// \brief Log-linear latency histogram used to profile the ONNX Classifier box.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OpenViBE
+{
+	namespace Plugins
+	{
+		namespace Classification
+		{
+			/// <summary> Fixed memory histogram of durations, in the spirit of HdrHistogram. </summary>
+			/// <remarks>
+			/// Values are recorded in nanoseconds. Each power of two is split in 64 linear sub-buckets,
+			/// so any percentile is reported with a relative error below 1.6% whatever its magnitude.
+			/// Recording is O(1) and never allocates, which makes it usable on every chunk.
+			/// </remarks>
+			class CLatencyHistogram final
+			{
+			public:
+				CLatencyHistogram();
+
+				/// <summary> Records one duration, in milliseconds. </summary>
+				void record(double ms);
+				void reset();
+
+				size_t count() const { return m_count; }
+				double max() const { return double(m_max) * 1e-6; }
+				double mean() const { return m_count == 0 ? 0.0 : m_sum / double(m_count); }
+
+				/// <summary> Smallest recorded value (in milliseconds) such that at least <c>percent</c> % of the values are lower or equal. </summary>
+				double percentile(double percent) const;
+
+			private:
+				static size_t bucketIndex(uint64_t ns);
+				static uint64_t bucketHighestValue(size_t index);
+
+				std::vector<uint64_t> m_buckets;
+				size_t m_count  = 0;
+				uint64_t m_max  = 0;
+				double m_sum    = 0.0;
+			};
+		} // namespace Classification
+	} // namespace Plugins
+} // namespace OpenViBE
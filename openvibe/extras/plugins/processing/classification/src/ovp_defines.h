@@ -10,5 +10,8 @@
 
 #define OVP_TypeId_ClassificationPairwiseStrategy					OpenViBE::CIdentifier(0x0DD51C74, 0x3C4E74C9)
 #define OVP_TypeId_OneVsOne_DecisionAlgorithms						OpenViBE::CIdentifier(0xDEC1510, 0xDEC1510)
+#define OVP_TypeId_OnnxGraphOptimizationLevel						OpenViBE::CIdentifier(0x3A61C0D7, 0x5E2B94F1)
+#define OVP_TypeId_OnnxExecutionMode								OpenViBE::CIdentifier(0x7C0E15A2, 0x21D8B6E4)
+#define OVP_TypeId_OnnxQueueFullPolicy								OpenViBE::CIdentifier(0x4B9D3E60, 0x0F7A52C8)
 
 bool OVFloatEqual(double first, double second);
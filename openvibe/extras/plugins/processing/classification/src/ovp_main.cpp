@@ -53,6 +53,21 @@ OVP_Declare_Begin()
 	context.getTypeManager().registerEnumerationEntry(OVP_TypeId_OneVsOne_DecisionAlgorithms, "Multi-layer Perceptron",
 													  OVP_ClassId_Algorithm_ClassifierMLP.id());
 
+	// ONNX section
+	context.getTypeManager().registerEnumerationType(OVP_TypeId_OnnxGraphOptimizationLevel, "ONNX Graph Optimization Level");
+	context.getTypeManager().registerEnumerationEntry(OVP_TypeId_OnnxGraphOptimizationLevel, "Disabled", ORT_DISABLE_ALL);
+	context.getTypeManager().registerEnumerationEntry(OVP_TypeId_OnnxGraphOptimizationLevel, "Basic", ORT_ENABLE_BASIC);
+	context.getTypeManager().registerEnumerationEntry(OVP_TypeId_OnnxGraphOptimizationLevel, "Extended", ORT_ENABLE_EXTENDED);
+	context.getTypeManager().registerEnumerationEntry(OVP_TypeId_OnnxGraphOptimizationLevel, "All", ORT_ENABLE_ALL);
+
+	context.getTypeManager().registerEnumerationType(OVP_TypeId_OnnxExecutionMode, "ONNX Execution Mode");
+	context.getTypeManager().registerEnumerationEntry(OVP_TypeId_OnnxExecutionMode, "Sequential", ORT_SEQUENTIAL);
+	context.getTypeManager().registerEnumerationEntry(OVP_TypeId_OnnxExecutionMode, "Parallel", ORT_PARALLEL);
+
+	context.getTypeManager().registerEnumerationType(OVP_TypeId_OnnxQueueFullPolicy, "ONNX Queue Full Policy");
+	context.getTypeManager().registerEnumerationEntry(OVP_TypeId_OnnxQueueFullPolicy, "Drop Chunk", size_t(EOnnxQueueFullPolicy::DropChunk));
+	context.getTypeManager().registerEnumerationEntry(OVP_TypeId_OnnxQueueFullPolicy, "Wait", size_t(EOnnxQueueFullPolicy::Wait));
+
 	// Register boxes
 	OVP_Declare_New(CBoxAlgorithmOutlierRemovalDesc)
 	OVP_Declare_New(CBoxAlgorithmOnnxClassifierDesc)
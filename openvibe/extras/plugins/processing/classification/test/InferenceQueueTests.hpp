@@ -0,0 +1,190 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file InferenceQueueTests.hpp
+/// \brief Tests for the batching and the queue full policies of the asynchronous mode of the ONNX Classifier box.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "box-algorithms/ovpCInferenceQueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//---------------------------------------------------------------------------------------------------
+class InferenceQueue_Tests : public testing::Test
+{
+protected:
+	using CInferenceQueue = OpenViBE::Plugins::Classification::CInferenceQueue;
+	using EStatus = CInferenceQueue::EStatus;
+	using SInferenceJob = OpenViBE::Plugins::Classification::SInferenceJob;
+
+	// Reserves a slot and queues a job for the chunk ending at the given time
+	EStatus queue(const uint64_t endTime)
+	{
+		SInferenceJob job;
+		const EStatus status = m_queue.reserve(job);
+		if (status == EStatus::Queued)
+		{
+			job.endTime = endTime;
+			m_queue.push(std::move(job));
+		}
+		return status;
+	}
+
+	static std::vector<uint64_t> endTimes(const std::vector<SInferenceJob>& jobs)
+	{
+		std::vector<uint64_t> times;
+		for (const auto& job : jobs) { times.push_back(job.endTime); }
+		return times;
+	}
+
+	CInferenceQueue m_queue;
+	std::vector<SInferenceJob> m_jobs;
+};
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(InferenceQueue_Tests, batching)
+{
+	m_queue.start(8, OpenViBE::Plugins::Classification::EOnnxQueueFullPolicy::Wait);
+	for (uint64_t i = 0; i < 3; ++i) { ASSERT_EQ(EStatus::Queued, queue(i)); }
+
+	// Without batching the oldest chunk is taken alone
+	ASSERT_TRUE(m_queue.take(false, m_jobs));
+	EXPECT_EQ(std::vector<uint64_t>({ 0 }), endTimes(m_jobs));
+	m_queue.release(m_jobs, "");
+	EXPECT_TRUE(m_jobs.empty());
+	EXPECT_EQ(2, m_queue.inFlight());
+
+	// With batching every queued chunk is taken, in queueing order
+	ASSERT_EQ(EStatus::Queued, queue(3));
+	ASSERT_TRUE(m_queue.take(true, m_jobs));
+	EXPECT_EQ(std::vector<uint64_t>({ 1, 2, 3 }), endTimes(m_jobs));
+	EXPECT_EQ(3, m_queue.inFlight()) << "Chunks being classified aren't in flight anymore.";
+	m_queue.release(m_jobs, "");
+	EXPECT_EQ(0, m_queue.inFlight());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(InferenceQueue_Tests, dropChunkPolicy)
+{
+	m_queue.start(2, OpenViBE::Plugins::Classification::EOnnxQueueFullPolicy::DropChunk);
+	ASSERT_EQ(EStatus::Queued, queue(0));
+	ASSERT_EQ(EStatus::Queued, queue(1));
+
+	// Chunks taken by the worker are still in flight, the queue stays full until they are released
+	ASSERT_TRUE(m_queue.take(true, m_jobs));
+	EXPECT_EQ(EStatus::Dropped, queue(2));
+	EXPECT_EQ(EStatus::Dropped, queue(3));
+	EXPECT_EQ(2, m_queue.droppedCount());
+
+	m_queue.release(m_jobs, "");
+	EXPECT_EQ(EStatus::Queued, queue(4));
+	ASSERT_TRUE(m_queue.take(true, m_jobs));
+	EXPECT_EQ(std::vector<uint64_t>({ 4 }), endTimes(m_jobs)) << "Dropped chunks are queued.";
+	m_queue.release(m_jobs, "");
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(InferenceQueue_Tests, waitPolicy)
+{
+	m_queue.start(2, OpenViBE::Plugins::Classification::EOnnxQueueFullPolicy::Wait);
+	std::atomic<bool> isReleased(false);
+	std::thread worker([&]()
+	{
+		std::vector<SInferenceJob> jobs;
+		while (m_queue.take(false, jobs))
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			isReleased = true;
+			m_queue.release(jobs, "");
+		}
+	});
+
+	// Every chunk is queued, the box waits for the worker when the queue is full
+	for (uint64_t i = 0; i < 10; ++i)
+	{
+		ASSERT_EQ(EStatus::Queued, queue(i));
+		EXPECT_LE(m_queue.inFlight(), 2);
+	}
+	EXPECT_TRUE(isReleased);
+	m_queue.waitIdle();
+	EXPECT_EQ(0, m_queue.inFlight());
+	EXPECT_EQ(0, m_queue.droppedCount());
+
+	m_queue.stop();
+	worker.join();
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(InferenceQueue_Tests, waitPolicyWorkerError)
+{
+	m_queue.start(1, OpenViBE::Plugins::Classification::EOnnxQueueFullPolicy::Wait);
+	ASSERT_EQ(EStatus::Queued, queue(0));
+	std::thread worker([&]()
+	{
+		std::vector<SInferenceJob> jobs;
+		ASSERT_TRUE(m_queue.take(false, jobs));
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		// A failure of a single job releases it with its error, the slot is free again
+		m_queue.release(jobs, "inference failed");
+	});
+
+	// The box was waiting for a slot, the failure is reported instead of queueing the chunk
+	EXPECT_EQ(EStatus::Failed, queue(1));
+	worker.join();
+	EXPECT_EQ(0, m_queue.inFlight()) << "Chunk is queued after a failure of the worker.";
+	EXPECT_TRUE(m_queue.hasError());
+	EXPECT_EQ("inference failed", m_queue.takeError());
+	EXPECT_FALSE(m_queue.hasError());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(InferenceQueue_Tests, stop)
+{
+	m_queue.start(4, OpenViBE::Plugins::Classification::EOnnxQueueFullPolicy::Wait);
+	for (uint64_t i = 0; i < 3; ++i) { ASSERT_EQ(EStatus::Queued, queue(i)); }
+	ASSERT_TRUE(m_queue.take(false, m_jobs));
+
+	// Queued chunks are abandoned, the one being classified stays in flight until the worker releases it
+	m_queue.stop();
+	EXPECT_EQ(1, m_queue.inFlight());
+	m_queue.release(m_jobs, "");
+	EXPECT_EQ(0, m_queue.inFlight());
+	EXPECT_FALSE(m_queue.take(true, m_jobs));
+	EXPECT_TRUE(m_jobs.empty());
+
+	// Starting again gives an empty queue
+	m_queue.start(4, OpenViBE::Plugins::Classification::EOnnxQueueFullPolicy::Wait);
+	ASSERT_EQ(EStatus::Queued, queue(5));
+	ASSERT_TRUE(m_queue.take(true, m_jobs));
+	EXPECT_EQ(std::vector<uint64_t>({ 5 }), endTimes(m_jobs));
+	m_queue.release(m_jobs, "");
+}
+//---------------------------------------------------------------------------------------------------
@@ -0,0 +1,109 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file LatencyHistogramTests.hpp
+/// \brief Tests for the latency histogram of the ONNX Classifier box.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "box-algorithms/ovpCLatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using OpenViBE::Plugins::Classification::CLatencyHistogram;
+
+//---------------------------------------------------------------------------------------------------
+TEST(LatencyHistogram_Tests, empty)
+{
+	const CLatencyHistogram histogram;
+	EXPECT_EQ(0, histogram.count());
+	EXPECT_EQ(0.0, histogram.mean());
+	EXPECT_EQ(0.0, histogram.max());
+	EXPECT_EQ(0.0, histogram.percentile(50));
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(LatencyHistogram_Tests, smallValuesAreExact)
+{
+	// Below 128 ns every value has its own bucket
+	CLatencyHistogram histogram;
+	for (size_t ns = 1; ns <= 100; ++ns) { histogram.record(double(ns) * 1e-6); }
+
+	EXPECT_EQ(100, histogram.count());
+	EXPECT_NEAR(50.5e-6, histogram.mean(), 1e-12);
+	EXPECT_DOUBLE_EQ(100e-6, histogram.max());
+	EXPECT_DOUBLE_EQ(1e-6, histogram.percentile(0));
+	EXPECT_DOUBLE_EQ(1e-6, histogram.percentile(1));
+	EXPECT_DOUBLE_EQ(50e-6, histogram.percentile(50));
+	EXPECT_DOUBLE_EQ(99e-6, histogram.percentile(99));
+	EXPECT_DOUBLE_EQ(100e-6, histogram.percentile(100));
+	EXPECT_DOUBLE_EQ(100e-6, histogram.percentile(150)) << "Percentiles above 100 aren't clamped.";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(LatencyHistogram_Tests, percentilesWithinRelativeError)
+{
+	// Durations from 1 µs to 10 s, spread over many powers of two
+	std::vector<double> values;
+	for (size_t i = 0; i < 1000; ++i) { values.push_back(1e-3 * std::pow(10.0, 7.0 * double(i) / 999.0)); }
+
+	CLatencyHistogram histogram;
+	for (const double value : values) { histogram.record(value); }
+	std::sort(values.begin(), values.end());
+
+	for (const double percent : { 1.0, 10.0, 50.0, 90.0, 99.0, 99.9 })
+	{
+		const size_t rank     = size_t(std::ceil(percent / 100.0 * double(values.size())));
+		const double expected = values[rank - 1];
+		const double actual   = histogram.percentile(percent);
+		EXPECT_GE(actual, expected * (1 - 1e-9)) << "Percentile " << percent << " is below the recorded value.";
+		EXPECT_LE(actual, expected * 1.016) << "Percentile " << percent << " is beyond the relative error.";
+	}
+	EXPECT_DOUBLE_EQ(values.back(), histogram.percentile(100)) << "Highest percentile isn't the maximum.";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(LatencyHistogram_Tests, outliersAndReset)
+{
+	CLatencyHistogram histogram;
+	for (size_t i = 0; i < 99; ++i) { histogram.record(1.0); }
+	histogram.record(1000.0);
+	histogram.record(-1.0);	// Negative durations are recorded as 0
+
+	EXPECT_EQ(101, histogram.count());
+	EXPECT_DOUBLE_EQ(1000.0, histogram.max());
+	EXPECT_NEAR(1.0, histogram.percentile(50), 0.016);
+	EXPECT_NEAR(1.0, histogram.percentile(98), 0.016);
+	EXPECT_DOUBLE_EQ(1000.0, histogram.percentile(100));
+	EXPECT_EQ(0.0, histogram.percentile(0));
+
+	histogram.reset();
+	EXPECT_EQ(0, histogram.count());
+	EXPECT_EQ(0.0, histogram.max());
+	EXPECT_EQ(0.0, histogram.percentile(99));
+}
+//---------------------------------------------------------------------------------------------------
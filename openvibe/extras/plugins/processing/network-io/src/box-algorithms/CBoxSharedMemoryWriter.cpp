@@ -24,70 +24,46 @@
 
 #include "CBoxSharedMemoryWriter.hpp"
 
-#include <iostream>
-#include <sstream>
-#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <string>
 
 namespace OpenViBE {
 namespace Plugins {
 namespace FileReadingAndWriting {
 
-#define time2ms(x, y) ((x) * 1000 + (y) / 1000.0) + 0.5
-
 //--------------------------------------------------------------------------------
 bool CBoxSharedMemoryWriter::initialize()
 {
-	//remove and create shared memory
-	m_sharedMemoryName = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 0); // can be local variable
-	boost::interprocess::shared_memory_object::remove(m_sharedMemoryName.toASCIIString());
-	m_sharedMemoryArray = boost::interprocess::managed_shared_memory(boost::interprocess::create_only, m_sharedMemoryName.toASCIIString(), 655360);
-
-	//remove and create mutex
-	m_mutexName = m_sharedMemoryName + "_Mutex";
-	boost::interprocess::named_mutex::remove(m_mutexName.toASCIIString());
-	m_mutex = new boost::interprocess::named_mutex(boost::interprocess::open_or_create, m_mutexName.toASCIIString());
-
-	//create shared vector for meta info (type and name)
-	const ShmemAllocatorMetaInfo metaInfo(m_sharedMemoryArray.get_segment_manager());
-	MyVectorMetaInfo* metaInfoVector = m_sharedMemoryArray.construct<MyVectorMetaInfo>("MetaInfo")(std::less<ShmString>(), metaInfo);
-	const StringAllocator instString(m_sharedMemoryArray.get_segment_manager());
-
-	//fill meta info vector and create shared vector variable for the appropriate types
+	m_sharedMemoryName = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 0);
+
 	const Kernel::IBox& boxContext = this->getStaticBoxContext();
-	for (size_t i = 0; i < boxContext.getInputCount(); ++i) {
-		CIdentifier typeID;
-		std::ostringstream convert;   // stream used for the conversion
-		convert << i;
-
-		boxContext.getInputType(i, typeID);
-		if (typeID == OVTK_TypeId_StreamedMatrix) {
-			m_decoders.push_back(new Toolkit::TStreamedMatrixDecoder<CBoxSharedMemoryWriter>());
-			ShmString name("Matrix", instString);
-			name += ShmString(convert.str().c_str(), instString);
-			metaInfoVector->insert(std::make_pair(name, typeID));
-
-			const ShmemAllocatorMatrix inst(m_sharedMemoryArray.get_segment_manager());
-			m_streamedMatrices.push_back(m_sharedMemoryArray.construct<MyVectorStreamedMatrix>(name.c_str())(inst));
-
-			this->getLogManager() << Kernel::LogLevel_Info << "Constructed variable in shared memory of type matrix with name " << name.c_str() << "\n";
+	const size_t nInput            = boxContext.getInputCount();
+	m_decoders.assign(nInput, nullptr);
+	m_typeIDs.assign(nInput, CIdentifier::undefined());
+	m_streams.assign(nInput, SharedMemory::CRingWriter::SStream());
+	m_headerReceived.assign(nInput, false);
+
+	for (size_t i = 0; i < nInput; ++i) {
+		boxContext.getInputType(i, m_typeIDs[i]);
+		SharedMemory::CRingWriter::SStream& stream = m_streams[i];
+		stream.typeID                              = m_typeIDs[i].id();
+		if (m_typeIDs[i] == OVTK_TypeId_StreamedMatrix) {
+			m_decoders[i] = new Toolkit::TStreamedMatrixDecoder<CBoxSharedMemoryWriter>(*this, i);
+			stream.name   = "Matrix" + std::to_string(i);
+			stream.type   = SharedMemory::EStreamType::Matrix;
 		}
-		else if (typeID == OVTK_TypeId_Stimulations) {
-			m_decoders.push_back(new Toolkit::TStimulationDecoder<CBoxSharedMemoryWriter>());
-			ShmString name("Stimuli", instString);
-			name += ShmString(convert.str().c_str(), instString);
-			metaInfoVector->insert(std::make_pair(name, typeID));
-
-			const ShmemAllocatorStimulation inst(m_sharedMemoryArray.get_segment_manager());
-			m_stimSets.push_back(m_sharedMemoryArray.construct<MyVectorStimulation>(name.c_str())(inst));
-
-			this->getLogManager() << Kernel::LogLevel_Info << "Constructed variable in shared memory of type stimulation with name " << name.c_str() << "\n";
+		else if (m_typeIDs[i] == OVTK_TypeId_Stimulations) {
+			m_decoders[i]       = new Toolkit::TStimulationDecoder<CBoxSharedMemoryWriter>(*this, i);
+			stream.name         = "Stimuli" + std::to_string(i);
+			stream.type         = SharedMemory::EStreamType::Stimulations;
+			m_headerReceived[i] = true;		// The slots of stimulations do not depend on the header
+		}
+		else {
+			this->getLogManager() << Kernel::LogLevel_Warning << "Input type " << m_typeIDs[i] << " is not supported\n";
+			m_headerReceived[i] = true;
 		}
-		else { this->getLogManager() << Kernel::LogLevel_Warning << "Input type " << typeID << " is not supported\n"; }
-		m_decoders.back()->initialize(*this, i);
 	}
 
-	//m_inputCounter = 0;
-
+	m_stimulations.reserve(SharedMemory::RING_MAX_STIMULATION);
 	return true;
 }
 //--------------------------------------------------------------------------------
@@ -95,40 +71,16 @@ bool CBoxSharedMemoryWriter::initialize()
 //--------------------------------------------------------------------------------
 bool CBoxSharedMemoryWriter::uninitialize()
 {
-	m_sharedMemoryArray.destroy<MyVectorMetaInfo>("MetaInfo");
-
-	const Kernel::IBox& boxContext = this->getStaticBoxContext();
-	for (int i = int(boxContext.getInputCount() - 1); i >= 0; i--) {
-		CIdentifier typeID;
-		boxContext.getInputType(i, typeID);
-		const std::string idxStr = std::to_string(i);
-
-		if (typeID == OVTK_TypeId_StreamedMatrix) {
-			this->getLogManager() << Kernel::LogLevel_Debug << "Uninitialize shared memory variable associated with input " << i << "\n";
-			for (size_t j = 0; j < m_streamedMatrices.back()->size(); ++j) {
-				m_sharedMemoryArray.deallocate(m_streamedMatrices.back()->at(j)->data.get());
-				m_sharedMemoryArray.deallocate(m_streamedMatrices.back()->at(j).get());
-			}
-			this->getLogManager() << Kernel::LogLevel_Debug << "Deallocated shared memory for variable with name Matrix " << idxStr << "\n";
-			m_streamedMatrices.back()->clear();
-			m_sharedMemoryArray.destroy<MyVectorStreamedMatrix>(("Matrix " + idxStr).c_str());
+	m_writer.close();
+	this->getLogManager() << Kernel::LogLevel_Debug << "Removed shared memory " << m_sharedMemoryName << "\n";
 
-			//TODO: pop_back()?
+	for (auto* decoder : m_decoders) {
+		if (decoder) {
+			decoder->uninitialize();
+			delete decoder;
 		}
-		else if (typeID == OVTK_TypeId_Stimulations) {
-			m_stimSets.back()->clear();
-			m_sharedMemoryArray.destroy<MyVectorStimulation>(("Stimuli" + idxStr).c_str());
-		}
-	}
-	this->getLogManager() << Kernel::LogLevel_Debug << "Destroyed all shared variables associated with input" << "\n";
-	boost::interprocess::shared_memory_object::remove(m_sharedMemoryName.toASCIIString());
-	boost::interprocess::named_mutex::remove(m_mutexName.toASCIIString());
-	delete m_mutex;
-	for (size_t i = 0; i < boxContext.getInputCount(); ++i) {
-		m_decoders[i]->uninitialize();
-		delete m_decoders[i];
 	}
-
+	m_decoders.clear();
 
 	return true;
 }
@@ -143,77 +95,82 @@ bool CBoxSharedMemoryWriter::processInput(const size_t /*index*/)
 //--------------------------------------------------------------------------------
 
 //--------------------------------------------------------------------------------
-bool CBoxSharedMemoryWriter::process()
+bool CBoxSharedMemoryWriter::createSegment()
 {
-	Kernel::IBoxIO& boxContext           = this->getDynamicBoxContext();
-	const Kernel::IBox& staticBoxContext = this->getStaticBoxContext();
-
-	size_t iStimulusCounter = 0;
-	size_t iMatrixCounter   = 0;
-
-	for (size_t i = 0; i < staticBoxContext.getInputCount(); ++i) {
-		CIdentifier typeID;
-		staticBoxContext.getInputType(i, typeID);
-		if (typeID == OVTK_TypeId_Stimulations) {
-			for (size_t j = 0; j < boxContext.getInputChunkCount(i); ++j) {
-				//m_oAlgo0_StimulationDecoder.decode(j,i, false);
-				m_decoders[i]->decode(j, false);
-				//CStimulationSet stimSet;
-				CStimulationSet* stimSet = dynamic_cast<Toolkit::TStimulationDecoder<CBoxSharedMemoryWriter>*>(m_decoders[i])->
-						getOutputStimulationSet();
-				//Toolkit::StimulationSet::copy(l_oStimSet, *m_oAlgo0_StimulationDecoder.getOutputStimulationSet());
-				if (m_decoders[i]->isHeaderReceived()) { boxContext.markInputAsDeprecated(i, j); }
-				if (m_decoders[i]->isBufferReceived()) {
-					if (stimSet->size() > 0) {
-						boost::interprocess::scoped_lock<boost::interprocess::named_mutex> lock(*m_mutex, boost::interprocess::try_to_lock);
-						if (lock) {
-							for (size_t k = 0; k < stimSet->size(); ++k) {
-								// @fixme m_stimSets defined as 32bit will only work correctly with stimuli that fit in 32bits (OV stimulations can be 64bit)
-								m_stimSets[iStimulusCounter]->push_back(size_t(stimSet->getId(k)));
-								this->getLogManager() << Kernel::LogLevel_Info << "Added stimulus with id " << m_stimSets[iStimulusCounter]->back() <<
-										" to shared memory variable\n";
-							}
-							boxContext.markInputAsDeprecated(i, j);
-						}
-						else { this->getLogManager() << Kernel::LogLevel_Warning << "Shared memory writer could not lock mutex\n"; }
-					}
-					else { boxContext.markInputAsDeprecated(i, j); }
-				}
-				if (m_decoders[i]->isEndReceived()) { boxContext.markInputAsDeprecated(i, j); }
+	Kernel::IBoxIO& boxContext = this->getDynamicBoxContext();
+
+	bool ready = true;
+	for (size_t i = 0; i < m_decoders.size(); ++i) {
+		if (m_headerReceived[i]) { continue; }
+		// The header is the first chunk of the stream, the following ones stay in the input until the segment exists
+		if (boxContext.getInputChunkCount(i) > 0) {
+			m_decoders[i]->decode(0);
+			if (m_decoders[i]->isHeaderReceived()) {
+				const CMatrix* matrix = dynamic_cast<Toolkit::TStreamedMatrixDecoder<CBoxSharedMemoryWriter>*>(m_decoders[i])->getOutputMatrix();
+				SharedMemory::CRingWriter::SStream& stream = m_streams[i];
+				stream.nRow = matrix->getDimensionCount() > 0 ? matrix->getDimensionSize(0) : 1;
+				stream.nCol = stream.nRow == 0 ? 0 : matrix->getBufferElementCount() / stream.nRow;
+				m_headerReceived[i] = true;
+
+				this->getLogManager() << Kernel::LogLevel_Trace << "Matrix input " << i << " has " << stream.nRow << " rows by " << stream.nCol << " columns\n";
 			}
-			iStimulusCounter++;
 		}
-		else if (typeID == OVTK_TypeId_StreamedMatrix) {
-			for (size_t j = 0; j < boxContext.getInputChunkCount(i); ++j) {
-				m_decoders[i]->decode(j, false);
-				CMatrix* matrix = dynamic_cast<Toolkit::TStreamedMatrixDecoder<CBoxSharedMemoryWriter>*>(m_decoders[i])->getOutputMatrix();
-				if (m_decoders[i]->isHeaderReceived()) { boxContext.markInputAsDeprecated(i, j); }
-				if (m_decoders[i]->isBufferReceived()) {
-					boost::interprocess::scoped_lock<boost::interprocess::named_mutex> lock(*m_mutex, boost::interprocess::try_to_lock);
-					if (lock) {
-						boost::interprocess::offset_ptr<SMatrix> shmMatrix = static_cast<SMatrix*>(m_sharedMemoryArray.allocate(sizeof(SMatrix)));
+		ready = ready && m_headerReceived[i];
+	}
+	if (!ready) { return true; }
 
-						//if we receive a vector (second dimension to 0) we force to one otherwise no memory will be allocated
-						const size_t row = (matrix->getDimensionSize(1) == 0) ? 1 : matrix->getDimensionSize(1);
+	std::vector<SharedMemory::CRingWriter::SStream> streams;
+	for (size_t i = 0; i < m_decoders.size(); ++i) { if (m_decoders[i]) { streams.push_back(m_streams[i]); } }
+	OV_ERROR_UNLESS_KRF(m_writer.create(m_sharedMemoryName.toASCIIString(), streams),
+						"Could not create shared memory " << m_sharedMemoryName << ": " << m_writer.getLastError().c_str(),
+						Kernel::ErrorType::BadResourceCreation);
 
-						shmMatrix->rowDim = row;
-						shmMatrix->colDim = matrix->getDimensionSize(0);
+	for (const auto& stream : streams) {
+		this->getLogManager() << Kernel::LogLevel_Info << "Constructed variable in shared memory with name " << stream.name.c_str() << "\n";
+	}
+	return true;
+}
+//--------------------------------------------------------------------------------
 
-						this->getLogManager() << Kernel::LogLevel_Trace << "dimensions " << matrix->getDimensionCount() << "row " << matrix->getDimensionSize(1)
-								<< " by " << " columns " << matrix->getDimensionSize(0) << "\n";
+//--------------------------------------------------------------------------------
+bool CBoxSharedMemoryWriter::process()
+{
+	if (!m_writer.isOpen()) {
+		if (!createSegment()) { return false; }
+		if (!m_writer.isOpen()) { return true; }
+	}
 
-						shmMatrix->data = static_cast<double*>(m_sharedMemoryArray.allocate(matrix->getDimensionSize(0) * row * sizeof(double)));
-						for (size_t k = 0; k < matrix->getBufferElementCount(); ++k) { *(shmMatrix->data + k) = *(matrix->getBuffer() + k); }
+	Kernel::IBoxIO& boxContext = this->getDynamicBoxContext();
 
-						m_streamedMatrices[iMatrixCounter]->push_back(shmMatrix);
+	// The streams of the segment are the supported inputs, in order
+	size_t stream = 0;
+	for (size_t i = 0; i < m_decoders.size(); ++i) {
+		if (!m_decoders[i]) { continue; }
 
-						boxContext.markInputAsDeprecated(i, j);
-					}
+		for (size_t j = 0; j < boxContext.getInputChunkCount(i); ++j) {
+			m_decoders[i]->decode(j);
+			if (!m_decoders[i]->isBufferReceived()) { continue; }
+
+			const uint64_t startTime = boxContext.getInputChunkStartTime(i, j);
+			const uint64_t endTime   = boxContext.getInputChunkEndTime(i, j);
+			if (m_typeIDs[i] == OVTK_TypeId_StreamedMatrix) {
+				const CMatrix* matrix = dynamic_cast<Toolkit::TStreamedMatrixDecoder<CBoxSharedMemoryWriter>*>(m_decoders[i])->getOutputMatrix();
+				OV_ERROR_UNLESS_KRF(m_writer.writeMatrix(stream, startTime, endTime, matrix->getBuffer(), matrix->getBufferElementCount()),
+									"Matrix received on input " << i << " does not have the dimensions of its header",
+									Kernel::ErrorType::BadInput);
+			}
+			else {
+				const CStimulationSet* stimSet = dynamic_cast<Toolkit::TStimulationDecoder<CBoxSharedMemoryWriter>*>(m_decoders[i])->
+						getOutputStimulationSet();
+				m_stimulations.resize(stimSet->size());
+				for (size_t k = 0; k < stimSet->size(); ++k) {
+					m_stimulations[k] = { stimSet->getId(k), stimSet->getDate(k), stimSet->getDuration(k) };
+					this->getLogManager() << Kernel::LogLevel_Trace << "Added stimulus with id " << stimSet->getId(k) << " to shared memory variable\n";
 				}
-				if (m_decoders[i]->isEndReceived()) { boxContext.markInputAsDeprecated(i, j); }
+				m_writer.writeStimulations(stream, startTime, endTime, m_stimulations.data(), m_stimulations.size());
 			}
-			iMatrixCounter++;
 		}
+		stream++;
 	}
 
 	return true;
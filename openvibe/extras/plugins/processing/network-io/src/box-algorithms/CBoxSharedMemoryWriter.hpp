@@ -24,50 +24,25 @@
 
 #pragma once
 
-//You may have to change this path to match your folder organisation
 #include "defines.hpp"
 
 #include <openvibe/ov_all.h>
 #include <toolkit/ovtk_all.h>
 
-//#include <pair>
-#include <vector>
-#include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/interprocess/containers/vector.hpp>
-#include <boost/interprocess/containers/map.hpp>
-#include <boost/interprocess/allocators/allocator.hpp>
-#include <boost/interprocess/sync/named_mutex.hpp>
-#include <boost/interprocess/containers/string.hpp>
+#include <shared-memory/CRingWriter.hpp>
 
-// The unique identifiers for the box and its descriptor.
-// Identifier are randomly chosen by the skeleton-generator.
+#include <vector>
 
 namespace OpenViBE {
 namespace Plugins {
 namespace FileReadingAndWriting {
-
-struct SMatrix
-{
-	size_t rowDim, colDim;
-	boost::interprocess::offset_ptr<double> data;
-};
-
-typedef boost::interprocess::allocator<char, boost::interprocess::managed_shared_memory::segment_manager> CharAllocator;
-typedef boost::interprocess::basic_string<char, std::char_traits<char>, CharAllocator> ShmString;
-typedef boost::interprocess::allocator<ShmString, boost::interprocess::managed_shared_memory::segment_manager> StringAllocator;
-//typedef vector<ShmString, StringAllocator> MyShmStringVector;		
-typedef boost::interprocess::allocator<std::pair<const ShmString, CIdentifier>, boost::interprocess::managed_shared_memory::segment_manager>
-ShmemAllocatorMetaInfo;
-typedef boost::interprocess::map<ShmString, CIdentifier, std::less<ShmString>, ShmemAllocatorMetaInfo> MyVectorMetaInfo;
-
-typedef boost::interprocess::allocator<size_t, boost::interprocess::managed_shared_memory::segment_manager> ShmemAllocatorStimulation;
-typedef boost::interprocess::allocator<boost::interprocess::offset_ptr<SMatrix>, boost::interprocess::managed_shared_memory::segment_manager>
-ShmemAllocatorMatrix;
-typedef boost::interprocess::vector<size_t, ShmemAllocatorStimulation> MyVectorStimulation;
-typedef boost::interprocess::vector<boost::interprocess::offset_ptr<SMatrix>, ShmemAllocatorMatrix> MyVectorStreamedMatrix;
-
 //--------------------------------------------------------------------------------
 /// <summary>  The class CBoxSharedMemoryWriter describes the box SharedMemoryWriter. </summary>
+/// <remarks>
+/// Each input is written to a ring of fixed size slots in the shared memory segment, see <see cref="SharedMemory::CRingWriter"/>.
+/// The slots of a matrix input are sized from its header, so the segment is only created once every matrix input received its header,
+/// the chunks received meanwhile are kept in the inputs.
+/// </remarks>
 class CBoxSharedMemoryWriter final : virtual public Toolkit::TBoxAlgorithm<IBoxAlgorithm>
 {
 public:
@@ -82,16 +57,18 @@ public:
 	_IsDerivedFromClass_Final_(Toolkit::TBoxAlgorithm<IBoxAlgorithm>, Box_SharedMemoryWriter)
 
 protected:
+	// Decodes the headers of the matrix inputs and creates the segment once all of them are known
+	bool createSegment();
+
 	std::vector<Toolkit::TDecoder<CBoxSharedMemoryWriter>*> m_decoders;
+	std::vector<CIdentifier> m_typeIDs;
 	CString m_sharedMemoryName;
-	boost::interprocess::managed_shared_memory m_sharedMemoryArray;
+	SharedMemory::CRingWriter m_writer;
 
 private:
-	CIdentifier m_typeID = CIdentifier::undefined();
-	CString m_mutexName;
-	boost::interprocess::named_mutex* m_mutex = nullptr;
-	std::vector<MyVectorStimulation*> m_stimSets;
-	std::vector<MyVectorStreamedMatrix*> m_streamedMatrices;
+	std::vector<SharedMemory::CRingWriter::SStream> m_streams;	// One per input, the matrix dimensions are set when their header is received
+	std::vector<bool> m_headerReceived;
+	std::vector<SharedMemory::SStimulation> m_stimulations;
 };
 
 
@@ -122,11 +99,11 @@ public:
 	CString getDetailedDescription() const override
 	{
 		return
-				"The box writes input to shared memory so that it can be read by another process. Stimuli and streamed matrices are supported, and transformed into a format that can be written into shared memory. Based on the input types, a metainfo variable will be created in shared memory that will specify which variables have which type. This way the client can know what it will be reading.";
+				"The box writes input to shared memory so that it can be read by other processes. Stimuli and streamed matrices are supported. Each input is written to a ring of fixed size slots named after its type and index (Matrix<i> or Stimuli<i>), the oldest chunks being overwritten when the ring is full. Readers never block the box and detect when they fell behind, the openvibe-module-shared-memory library implements such a reader.";
 	}
 
 	CString getCategory() const override { return "File reading and writing"; }
-	CString getVersion() const override { return "1.0"; }
+	CString getVersion() const override { return "2.0"; }
 	CString getStockItemName() const override { return ""; }
 
 	CIdentifier getCreatedClass() const override { return Box_SharedMemoryWriter; }
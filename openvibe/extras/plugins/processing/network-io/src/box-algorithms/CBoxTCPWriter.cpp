@@ -24,9 +24,8 @@
 
 #include "CBoxTCPWriter.hpp"
 
-#include <ctime>
+#include <algorithm>
 #include <boost/bind/bind.hpp>
-#include <boost/enable_shared_from_this.hpp>
 #include <boost/asio.hpp>
 #include <boost/predef/other/endian.h>
 
@@ -39,19 +38,13 @@ using boost::asio::ip::tcp;
 //--------------------------------------------------------------------------------
 void CBoxTCPWriter::startAccept()
 {
-	tcp::socket* socket = new tcp::socket(m_ioContext);
-
-	// Since startAccept will only be called inside ioContext.poll(), there is no need to access control m_sockets
-	m_sockets.push_back(socket);
-
-	this->getLogManager() << Kernel::LogLevel_Debug << "We are now using " << m_sockets.size() << " socket(s)\n";
-
-	m_acceptor->async_accept(*socket, boost::bind(&CBoxTCPWriter::handleAccept, this, boost::asio::placeholders::error, socket));
+	m_acceptedClient.reset(new CTCPWriterClient(m_ioContext, m_maxQueueSize, m_fullQueuePolicy));
+	m_acceptor->async_accept(m_acceptedClient->getSocket(), boost::bind(&CBoxTCPWriter::handleAccept, this, boost::asio::placeholders::error));
 }
 //--------------------------------------------------------------------------------
 
 //--------------------------------------------------------------------------------
-void CBoxTCPWriter::handleAccept(const boost::system::error_code& ec, tcp::socket* pSocket)
+void CBoxTCPWriter::handleAccept(const boost::system::error_code& ec)
 {
 	if (!m_acceptor->is_open()) {
 		this->getLogManager() << Kernel::LogLevel_Debug << "handleAccept() was called with acceptor already closed\n";
@@ -61,25 +54,22 @@ void CBoxTCPWriter::handleAccept(const boost::system::error_code& ec, tcp::socke
 	if (!ec) {
 		this->getLogManager() << Kernel::LogLevel_Debug << "Handling a new incoming connection\n";
 
+		CTCPWriterClient& client = *m_acceptedClient;
+		m_clients.push_back(std::move(m_acceptedClient));
+		this->getLogManager() << Kernel::LogLevel_Debug << "We are now using " << m_clients.size() << " socket(s)\n";
+
+		boost::system::error_code optionError;
+		client.getSocket().set_option(tcp::no_delay(m_noDelay), optionError);
+		if (optionError) { this->getLogManager() << Kernel::LogLevel_Warning << "Could not set TCP no delay option: '" << optionError.message() << "'\n"; }
+
 		// Send the known configuration to the client
 		if (m_activeDecoder != &m_stimulationDecoder || m_outputStyle == TCPWRITER_RAW) {
-			try {
-				write(*pSocket, boost::asio::buffer(static_cast<void*>(&m_rawVersion), sizeof(uint32_t)));
-				write(*pSocket, boost::asio::buffer(static_cast<void*>(&m_endianness), sizeof(uint32_t)));
-				write(*pSocket, boost::asio::buffer(static_cast<void*>(&m_frequency), sizeof(uint32_t)));
-				write(*pSocket, boost::asio::buffer(static_cast<void*>(&m_nChannels), sizeof(uint32_t)));
-				write(*pSocket, boost::asio::buffer(static_cast<void*>(&m_nSamplesPerChunk), sizeof(uint32_t)));
-				write(*pSocket, boost::asio::buffer(static_cast<void*>(&m_reserved0), sizeof(uint32_t)));
-				write(*pSocket, boost::asio::buffer(static_cast<void*>(&m_reserved1), sizeof(uint32_t)));
-				write(*pSocket, boost::asio::buffer(static_cast<void*>(&m_reserved2), sizeof(uint32_t)));
-			}
-			catch (boost::system::system_error& error) {
-				this->getLogManager() << Kernel::LogLevel_Warning << "Issue '" << error.code().message() << "' with writing header to client\n";
-			}
+			const uint32_t header[] = { m_rawVersion, m_endianness, m_frequency, m_nChannels, m_nSamplesPerChunk, m_reserved0, m_reserved1, m_reserved2 };
+			const uint8_t* ptr      = reinterpret_cast<const uint8_t*>(header);
+			queueBuffer(client, std::make_shared<const std::vector<uint8_t>>(ptr, ptr + sizeof(header)));
 		}
 	}
 	else {
-		// @fixme should the socket be closed in this case?
 		this->getLogManager() << Kernel::LogLevel_Warning << "Issue '" << ec.message() << "' with accepting a connection.\n";
 	}
 	// Already schedule the accepting of the next connection
@@ -101,6 +91,17 @@ bool CBoxTCPWriter::initialize()
 	const uint64_t port = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 0);
 	m_outputStyle       = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 1);
 
+	// Boxes saved before the send queue settings existed keep the default ones
+	m_maxQueueSize    = 1024 * 1024;
+	m_fullQueuePolicy = TCPWRITER_DROP_OLDEST;
+	m_noDelay         = true;
+	if (boxContext.getSettingCount() > 4) {
+		const int64_t maxQueueSize = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 2);
+		m_maxQueueSize             = size_t(std::max<int64_t>(maxQueueSize, 1)) * 1024;
+		m_fullQueuePolicy          = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 3);
+		m_noDelay                  = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 4);
+	}
+
 	m_rawVersion = htonl(1); // TCP Writer output format version
 #if defined(BOOST_ENDIAN_LITTLE_BYTE)
 	m_endianness = htonl(1);
@@ -155,23 +156,26 @@ bool CBoxTCPWriter::uninitialize()
 		m_activeDecoder = nullptr;
 	}
 
-	for (tcp::socket* sock : m_sockets) {
-		if (sock->is_open()) {
-			try {
-				sock->shutdown(boost::asio::socket_base::shutdown_both);
-				sock->close();
-			}
-			catch (boost::system::system_error& error) {
-				// Just report...
-				this->getLogManager() << Kernel::LogLevel_Warning << "Error in uninitialize() socket shutdown/close: '" << error.code().message() << "'\n";
-			}
+	// The data still queued is not sent, closing the sockets completes the pending writes with an error
+	for (auto& client : m_clients) {
+		if (client->getDroppedCount() != 0) {
+			this->getLogManager() << Kernel::LogLevel_Info << "Dropped " << client->getDroppedCount() << " buffers for a client which did not read fast enough\n";
 		}
+		if (client->getQueuedCount() != 0) {
+			this->getLogManager() << Kernel::LogLevel_Info << "Discarded " << client->getQueuedCount() << " buffers (" << client->getQueueSize()
+					<< " bytes) still queued for a client\n";
+		}
+		closeClient(*client);
+	}
+	if (m_acceptor) {
+		boost::system::error_code ec;
+		m_acceptor->close(ec);
 	}
 	m_ioContext.poll();
 	m_ioContext.stop();
 
-	for (tcp::socket* sock : m_sockets) { delete sock; }
-	m_sockets.clear();
+	m_clients.clear();
+	m_acceptedClient.reset();
 
 	delete m_acceptor;
 	m_acceptor = nullptr;
@@ -180,6 +184,14 @@ bool CBoxTCPWriter::uninitialize()
 }
 //--------------------------------------------------------------------------------
 
+//--------------------------------------------------------------------------------
+bool CBoxTCPWriter::processClock(Kernel::CMessageClock& /*msg*/)
+{
+	pollClients();
+	return true;
+}
+//--------------------------------------------------------------------------------
+
 //--------------------------------------------------------------------------------
 bool CBoxTCPWriter::processInput(const size_t /*index*/)
 {
@@ -189,46 +201,64 @@ bool CBoxTCPWriter::processInput(const size_t /*index*/)
 //--------------------------------------------------------------------------------
 
 //--------------------------------------------------------------------------------
-bool CBoxTCPWriter::sendToClients(const void* buffer, const size_t size)
+bool CBoxTCPWriter::sendToClients(const buffer_t& buffer)
 {
-	if (size == 0 || buffer == nullptr) {
+	if (buffer->empty()) {
 		// Nothing to send, shouldn't happen
 		this->getLogManager() << Kernel::LogLevel_Warning << "Asked to send an empty buffer to clients (shouldn't happen)\n";
 		return false;
 	}
 
-	auto it = m_sockets.begin();
-	while (it != m_sockets.end()) {
-		tcp::socket* tmpSock = (*it);
-		bool hadError        = false;
-		if (tmpSock->is_open()) {
-			try { write(*tmpSock, boost::asio::buffer(buffer, size)); }
-			catch (boost::system::system_error& error) {
-				this->getLogManager() << Kernel::LogLevel_Warning << "Got error '" << error.code().message() << "' while trying to write to socket\n";
-				hadError = true;
-			}
-		}
-		if (hadError) {
-			// Close the socket
-			this->getLogManager() << Kernel::LogLevel_Debug << "Closing the socket\n";
-			try {
-				tmpSock->shutdown(boost::asio::socket_base::shutdown_both);
-				tmpSock->close();
-			}
-			catch (boost::system::system_error& error) {
-				// Just report...
-				this->getLogManager() << Kernel::LogLevel_Warning << "Error while socket shutdown/close: '" << error.code().message() << "'\n";
-			}
-			m_ioContext.poll();
-			delete tmpSock;
-			it = m_sockets.erase(it);
-		}
-		else { ++it; }
-	}
+	for (auto& client : m_clients) { if (client->isOpen()) { queueBuffer(*client, buffer); } }
 	return true;
 }
 //--------------------------------------------------------------------------------
 
+//--------------------------------------------------------------------------------
+void CBoxTCPWriter::queueBuffer(CTCPWriterClient& client, const buffer_t& buffer)
+{
+	const size_t nDropped = client.getDroppedCount();
+	switch (client.queue(buffer)) {
+		case CTCPWriterClient::EStatus::Disconnected:
+			this->getLogManager() << Kernel::LogLevel_Warning << "Disconnected a client which did not read fast enough\n";
+			break;
+		case CTCPWriterClient::EStatus::Dropped:
+			if (nDropped == 0) { this->getLogManager() << Kernel::LogLevel_Warning << "A client does not read fast enough, dropping the oldest data\n"; }
+			break;
+		default:
+			break;
+	}
+}
+//--------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------
+void CBoxTCPWriter::closeClient(CTCPWriterClient& client)
+{
+	if (!client.isOpen()) { return; }
+
+	this->getLogManager() << Kernel::LogLevel_Debug << "Closing the socket\n";
+	const boost::system::error_code ec = client.close();
+	if (ec) { this->getLogManager() << Kernel::LogLevel_Warning << "Error while socket shutdown/close: '" << ec.message() << "'\n"; }
+}
+//--------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------
+void CBoxTCPWriter::pollClients()
+{
+	m_ioContext.poll();
+
+	// A closed client is only forgotten once its pending write completed
+	m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(), [this](const std::unique_ptr<CTCPWriterClient>& client)
+	{
+		if (!client->isDone()) { return false; }
+		if (client->getWriteError()) {
+			this->getLogManager() << Kernel::LogLevel_Warning << "Got error '" << client->getWriteError().message() << "' while trying to write to socket\n";
+		}
+		return true;
+	}), m_clients.end());
+}
+//--------------------------------------------------------------------------------
+
 //--------------------------------------------------------------------------------
 bool CBoxTCPWriter::process()
 {
@@ -236,7 +266,7 @@ bool CBoxTCPWriter::process()
 	Kernel::IBoxIO& boxContext = this->getDynamicBoxContext();
 
 	// Process the asio loop once (e.g. see if there's new connections)
-	m_ioContext.poll();
+	pollClients();
 
 	for (size_t i = 0; i < boxContext.getInputChunkCount(0); ++i) {
 		m_activeDecoder->decode(i);
@@ -254,11 +284,11 @@ bool CBoxTCPWriter::process()
 					case 1:
 						// Ok, this is a vector, openvibe style. Interpret it as 1 channel row vector.
 						m_nChannels = 1;
-						m_nSamplesPerChunk = decoder->getOutputMatrix()->getDimensionSize(0);
+						m_nSamplesPerChunk = uint32_t(decoder->getOutputMatrix()->getDimensionSize(0));
 						break;
 					case 2:
-						m_nChannels = decoder->getOutputMatrix()->getDimensionSize(0);
-						m_nSamplesPerChunk = decoder->getOutputMatrix()->getDimensionSize(1);
+						m_nChannels = uint32_t(decoder->getOutputMatrix()->getDimensionSize(0));
+						m_nSamplesPerChunk = uint32_t(decoder->getOutputMatrix()->getDimensionSize(1));
 						break;
 					default:
 						this->getLogManager() << Kernel::LogLevel_Error << "Only 1 and 2 dimensional matrices are supported\n";
@@ -273,24 +303,23 @@ bool CBoxTCPWriter::process()
 			}
 
 			// Signal specific part
-			if (m_activeDecoder == &m_signalDecoder) { m_frequency = size_t(m_signalDecoder.getOutputSamplingRate()); }
+			if (m_activeDecoder == &m_signalDecoder) { m_frequency = uint32_t(m_signalDecoder.getOutputSamplingRate()); }
 
 			//if (m_activeDecoder == &m_stimDecoder) { }	// Stimulus, do nothing
 		}
-		if (m_activeDecoder->isBufferReceived()) {
-			if (m_activeDecoder == &m_matrixDecoder) {
-				const CMatrix* matrix = m_matrixDecoder.getOutputMatrix();
-
-				sendToClients((void*)matrix->getBuffer(), matrix->getBufferElementCount() * sizeof(double));
-			}
-			else if (m_activeDecoder == &m_signalDecoder) {
-				const CMatrix* matrix = m_signalDecoder.getOutputMatrix();
+		// The data of a chunk is copied once to a buffer shared by the send queues of the clients
+		if (m_activeDecoder->isBufferReceived() && !m_clients.empty()) {
+			if (m_activeDecoder == &m_matrixDecoder || m_activeDecoder == &m_signalDecoder) {
+				const CMatrix* matrix = (m_activeDecoder == &m_matrixDecoder ? m_matrixDecoder.getOutputMatrix() : m_signalDecoder.getOutputMatrix());
+				const uint8_t* ptr    = reinterpret_cast<const uint8_t*>(matrix->getBuffer());
 
-				sendToClients((void*)matrix->getBuffer(), matrix->getBufferElementCount() * sizeof(double));
+				sendToClients(std::make_shared<const std::vector<uint8_t>>(ptr, ptr + matrix->getBufferElementCount() * sizeof(double)));
 			}
 			else // stimulus
 			{
+				// All the stimulations of the chunk are sent at once
 				const CStimulationSet* stimSet = m_stimulationDecoder.getOutputStimulationSet();
+				auto buffer                    = std::make_shared<std::vector<uint8_t>>();
 				for (size_t j = 0; j < stimSet->size(); ++j) {
 					const uint64_t id = stimSet->getId(j);
 					// uint64_t date = stimSet->getDate(j);
@@ -298,13 +327,15 @@ bool CBoxTCPWriter::process()
 
 					switch (m_outputStyle) {
 						case TCPWRITER_RAW:
-							sendToClients((void*)&id, sizeof(id));
-							break;
+						{
+							const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&id);
+							buffer->insert(buffer->end(), ptr, ptr + sizeof(id));
+						}
+						break;
 						case TCPWRITER_HEX:
 						{
-							std::string tmp = CIdentifier(id).str() + "\r\n";
-							const char* ptr = tmp.c_str();
-							sendToClients((void*)ptr, strlen(ptr));
+							const std::string tmp = CIdentifier(id).str() + "\r\n";
+							buffer->insert(buffer->end(), tmp.begin(), tmp.end());
 						}
 						break;
 						case TCPWRITER_STRING:
@@ -312,9 +343,7 @@ bool CBoxTCPWriter::process()
 							std::string tmp = this->getTypeManager().getEnumerationEntryNameFromValue(OV_TypeId_Stimulation, id).toASCIIString();
 							if (tmp.empty()) { tmp = "Unregistered_stimulus " + CIdentifier(id).str(); }
 							tmp += "\r\n";
-
-							const char* ptr = tmp.c_str();
-							sendToClients((void*)ptr, strlen(ptr));
+							buffer->insert(buffer->end(), tmp.begin(), tmp.end());
 						}
 						break;
 						default:
@@ -322,6 +351,7 @@ bool CBoxTCPWriter::process()
 							return false;
 					}
 				}
+				if (!buffer->empty()) { sendToClients(buffer); }
 			}
 		}
 		if (m_activeDecoder->isEndReceived()) { }
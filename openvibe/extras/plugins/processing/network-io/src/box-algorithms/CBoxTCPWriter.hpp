@@ -25,11 +25,13 @@
 #pragma once
 
 #include "defines.hpp"
+#include "CTCPWriterClient.hpp"
 
 #include <openvibe/ov_all.h>
 #include <toolkit/ovtk_all.h>
 
-#include <ctime>
+#include <memory>
+#include <vector>
 #include <boost/asio.hpp>
 
 enum { TCPWRITER_RAW, TCPWRITER_HEX, TCPWRITER_STRING }; // stimulation output types
@@ -48,13 +50,24 @@ public:
 	bool initialize() override;
 	bool uninitialize() override;
 
+	// The clock keeps the writes to the clients going between the input chunks
+	uint64_t getClockFrequency() override { return 64LL << 32; }
+	bool processClock(Kernel::CMessageClock& msg) override;
 	bool processInput(const size_t index) override;
 	bool process() override;
 
 	_IsDerivedFromClass_Final_(Toolkit::TBoxAlgorithm<IBoxAlgorithm>, Box_TCPWriter)
 
 protected:
-	bool sendToClients(const void* buffer, size_t size);
+	typedef CTCPWriterClient::buffer_t buffer_t;
+
+	// Queues a buffer for all the clients, whose writes proceed when the asio loop is polled
+	bool sendToClients(const buffer_t& buffer);
+	void queueBuffer(CTCPWriterClient& client, const buffer_t& buffer);
+	void closeClient(CTCPWriterClient& client);
+
+	// Polls the asio loop and forgets the clients which disconnected
+	void pollClients();
 
 	// Stream decoder
 	Toolkit::TStimulationDecoder<CBoxTCPWriter> m_stimulationDecoder;
@@ -64,24 +77,28 @@ protected:
 
 	boost::asio::io_context m_ioContext;
 	boost::asio::ip::tcp::acceptor* m_acceptor = nullptr;
-	std::vector<boost::asio::ip::tcp::socket*> m_sockets;
+	std::unique_ptr<CTCPWriterClient> m_acceptedClient;		// Client of the pending accept
+	std::vector<std::unique_ptr<CTCPWriterClient>> m_clients;
 
 	uint64_t m_outputStyle = 0;
+	size_t m_maxQueueSize  = 0;								// In bytes
+	uint64_t m_fullQueuePolicy = TCPWRITER_DROP_OLDEST;
+	bool m_noDelay = true;
 
 	CIdentifier m_inputType = CIdentifier::undefined();
 
 	// Data written as global output header, 8*4 = 32 bytes. Padding allows dumb readers to step with double (==8 bytes).
-	size_t m_rawVersion       = 0;					// in network byte order, version of the raw stream
-	size_t m_endianness       = 0;					// in network byte order, 0==unknown, 1==little, 2==big, 3==pdp
-	size_t m_frequency        = 0;					// this and the rest are in host byte order
-	size_t m_nChannels        = 0;
-	size_t m_nSamplesPerChunk = 0;
-	size_t m_reserved0        = 0;
-	size_t m_reserved1        = 0;
-	size_t m_reserved2        = 0;
+	uint32_t m_rawVersion       = 0;				// in network byte order, version of the raw stream
+	uint32_t m_endianness       = 0;				// in network byte order, 0==unknown, 1==little, 2==big, 3==pdp
+	uint32_t m_frequency        = 0;				// this and the rest are in host byte order
+	uint32_t m_nChannels        = 0;
+	uint32_t m_nSamplesPerChunk = 0;
+	uint32_t m_reserved0        = 0;
+	uint32_t m_reserved1        = 0;
+	uint32_t m_reserved2        = 0;
 
 	void startAccept();
-	void handleAccept(const boost::system::error_code& ec, boost::asio::ip::tcp::socket* pSocket);
+	void handleAccept(const boost::system::error_code& ec);
 };
 
 //--------------------------------------------------------------------------------
@@ -125,7 +142,7 @@ public:
 	CString getShortDescription() const override { return "Send input stream out via a TCP socket"; }
 	CString getDetailedDescription() const override { return "\n"; }
 	CString getCategory() const override { return "Acquisition and network IO"; }
-	CString getVersion() const override { return "0.2"; }
+	CString getVersion() const override { return "0.3"; }
 	CString getStockItemName() const override { return "gtk-connect"; }
 
 	CIdentifier getCreatedClass() const override { return Box_TCPWriter; }
@@ -140,6 +157,9 @@ public:
 
 		prototype.addSetting("Port",OV_TypeId_Integer, "5678");
 		prototype.addSetting("Output format", TypeID_TCPWriter_RawOutputStyle, "Raw");
+		prototype.addSetting("Client queue size (kB)",OV_TypeId_Integer, "1024");
+		prototype.addSetting("When client queue is full", TypeID_TCPWriter_FullQueuePolicy, "Drop oldest data");
+		prototype.addSetting("Disable Nagle algorithm",OV_TypeId_Boolean, "true");
 
 		prototype.addFlag(Kernel::BoxFlag_CanModifyInput);
 
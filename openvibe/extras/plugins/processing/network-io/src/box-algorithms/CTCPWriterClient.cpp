@@ -0,0 +1,108 @@
+///-------------------------------------------------------------------------------------------------
+/// 
+/// \file CTCPWriterClient.cpp
+/// \brief Client of the box TCP Writer and its send queue.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+/// 
+///-------------------------------------------------------------------------------------------------
+
+#include "CTCPWriterClient.hpp"
+
+#include <algorithm>
+#include <boost/bind/bind.hpp>
+
+namespace OpenViBE {
+namespace Plugins {
+namespace NetworkIO {
+
+// Maximum number of queued buffers gathered in a single write
+static constexpr size_t MAX_GATHERED_BUFFERS = 64;
+
+//--------------------------------------------------------------------------------
+CTCPWriterClient::EStatus CTCPWriterClient::queue(const buffer_t& buffer)
+{
+	EStatus status = EStatus::Queued;
+	m_queue.push_back(buffer);
+	m_queueSize += buffer->size();
+
+	if (m_queueSize > m_maxQueueSize) {
+		if (m_fullQueuePolicy == TCPWRITER_DISCONNECT) {
+			close();
+			return EStatus::Disconnected;
+		}
+
+		// Drops whole buffers following the ones being written, so that the client still receives complete chunks
+		while (m_queueSize > m_maxQueueSize && m_queue.size() > m_nSending + 1) {
+			const auto it = m_queue.begin() + m_nSending;
+			m_queueSize -= (*it)->size();
+			m_queue.erase(it);
+			m_nDropped++;
+			status = EStatus::Dropped;
+		}
+	}
+
+	startWrite();
+	return status;
+}
+//--------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------
+boost::system::error_code CTCPWriterClient::close()
+{
+	boost::system::error_code ec;
+	if (!m_socket.is_open()) { return ec; }
+
+	m_socket.shutdown(boost::asio::socket_base::shutdown_both, ec);
+	m_socket.close(ec);
+	return ec;
+}
+//--------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------
+void CTCPWriterClient::startWrite()
+{
+	if (m_nSending != 0 || m_queue.empty() || !m_socket.is_open()) { return; }
+
+	m_nSending = std::min(m_queue.size(), MAX_GATHERED_BUFFERS);
+	m_sending.clear();
+	for (size_t i = 0; i < m_nSending; ++i) { m_sending.push_back(boost::asio::buffer(*m_queue[i])); }
+
+	boost::asio::async_write(m_socket, m_sending, boost::bind(&CTCPWriterClient::handleWrite, this, boost::asio::placeholders::error));
+}
+//--------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------
+void CTCPWriterClient::handleWrite(const boost::system::error_code& ec)
+{
+	for (size_t i = 0; i < m_nSending; ++i) { m_queueSize -= m_queue[i]->size(); }
+	m_queue.erase(m_queue.begin(), m_queue.begin() + m_nSending);
+	m_nSending = 0;
+
+	if (ec) {
+		if (ec != boost::asio::error::operation_aborted) { m_writeError = ec; }
+		close();
+		return;
+	}
+	startWrite();
+}
+//--------------------------------------------------------------------------------
+
+}  // namespace NetworkIO
+}  // namespace Plugins
+}  // namespace OpenViBE
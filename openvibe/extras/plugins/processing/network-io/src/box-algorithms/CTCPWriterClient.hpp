@@ -0,0 +1,96 @@
+///-------------------------------------------------------------------------------------------------
+/// 
+/// \file CTCPWriterClient.hpp
+/// \brief Client of the box TCP Writer and its send queue.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+/// 
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+#include <boost/asio.hpp>
+
+enum { TCPWRITER_DROP_OLDEST, TCPWRITER_DISCONNECT };	// policies when the send queue of a client is full
+
+namespace OpenViBE {
+namespace Plugins {
+namespace NetworkIO {
+
+//--------------------------------------------------------------------------------
+/// <summary> A client connected to the box TCP Writer and the buffers waiting to be sent to it. </summary>
+/// <remarks>
+/// The first buffers of the queue are written in a single gathered write, which proceeds when the asio loop of the socket is polled.
+/// When the queue exceeds its maximum size, the oldest buffers not being written are dropped or the client is disconnected.
+/// The client must be kept until <see cref="isDone"/> is true, the pending write referring to it.
+/// </remarks>
+class CTCPWriterClient final
+{
+public:
+	typedef std::shared_ptr<const std::vector<uint8_t>> buffer_t;	// Shared by the send queues of all the clients
+
+	enum class EStatus { Queued, Dropped, Disconnected };
+
+	/// <param name="ioContext"> The asio loop of the socket. </param>
+	/// <param name="maxQueueSize"> Size in bytes above which the queue is full. </param>
+	/// <param name="fullQueuePolicy"> What is done when the queue is full, <c>TCPWRITER_DROP_OLDEST</c> or <c>TCPWRITER_DISCONNECT</c>. </param>
+	CTCPWriterClient(boost::asio::io_context& ioContext, const size_t maxQueueSize, const uint64_t fullQueuePolicy)
+		: m_socket(ioContext), m_maxQueueSize(maxQueueSize), m_fullQueuePolicy(fullQueuePolicy) { }
+
+	boost::asio::ip::tcp::socket& getSocket() { return m_socket; }
+	bool isOpen() const { return m_socket.is_open(); }
+
+	/// <summary> Tells whether the client is closed and its last write completed, so that it can be forgotten. </summary>
+	bool isDone() const { return !m_socket.is_open() && m_nSending == 0; }
+
+	/// <summary> Queues a buffer and starts writing it if no write is pending. </summary>
+	/// <returns> <c>Dropped</c> if older buffers were dropped, <c>Disconnected</c> if the client was closed because its queue was full. </returns>
+	EStatus queue(const buffer_t& buffer);
+
+	/// <summary> Closes the socket, the pending write completes with an error when the asio loop is polled. </summary>
+	/// <returns> The error of the shutdown or of the closing of the socket. </returns>
+	boost::system::error_code close();
+
+	/// <summary> Gets the error which closed the client while writing, other than the abortion of the write by <see cref="close"/>. </summary>
+	const boost::system::error_code& getWriteError() const { return m_writeError; }
+
+	size_t getQueuedCount() const { return m_queue.size(); }
+	size_t getQueueSize() const { return m_queueSize; }
+	size_t getDroppedCount() const { return m_nDropped; }
+
+private:
+	void startWrite();
+	void handleWrite(const boost::system::error_code& ec);
+
+	boost::asio::ip::tcp::socket m_socket;
+	size_t m_maxQueueSize      = 0;
+	uint64_t m_fullQueuePolicy = TCPWRITER_DROP_OLDEST;
+
+	std::deque<buffer_t> m_queue;
+	size_t m_queueSize = 0;	// In bytes
+	size_t m_nSending  = 0;	// Number of buffers at the front of the queue being written
+	std::vector<boost::asio::const_buffer> m_sending;
+	size_t m_nDropped = 0;
+	boost::system::error_code m_writeError;
+};
+}  // namespace NetworkIO
+}  // namespace Plugins
+}  // namespace OpenViBE
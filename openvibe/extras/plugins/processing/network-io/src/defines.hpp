@@ -38,6 +38,7 @@
 //---------------------------------------------------------------------------------------------------
 #define TypeID_TCPWriter_OutputStyle		OpenViBE::CIdentifier(0x6D7E53DD, 0x6A0A4753)
 #define TypeID_TCPWriter_RawOutputStyle		OpenViBE::CIdentifier(0x77D3E238, 0xB954EC48)
+#define TypeID_TCPWriter_FullQueuePolicy	OpenViBE::CIdentifier(0x1B6E4A2C, 0x8F3D9157)
 
 // Global defines
 //---------------------------------------------------------------------------------------------------
@@ -52,6 +52,10 @@ OVP_Declare_Begin()
 	context.getTypeManager().registerEnumerationType(TypeID_TCPWriter_RawOutputStyle, "Raw output");
 	context.getTypeManager().registerEnumerationEntry(TypeID_TCPWriter_RawOutputStyle, "Raw", TCPWRITER_RAW);
 
+	context.getTypeManager().registerEnumerationType(TypeID_TCPWriter_FullQueuePolicy, "Full queue policy");
+	context.getTypeManager().registerEnumerationEntry(TypeID_TCPWriter_FullQueuePolicy, "Drop oldest data", TCPWRITER_DROP_OLDEST);
+	context.getTypeManager().registerEnumerationEntry(TypeID_TCPWriter_FullQueuePolicy, "Disconnect client", TCPWRITER_DISCONNECT);
+
 OVP_Declare_End()
 
 }  // namespace Plugins
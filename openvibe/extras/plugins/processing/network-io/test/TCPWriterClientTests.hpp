@@ -0,0 +1,185 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file TCPWriterClientTests.hpp
+/// \brief Tests for the send queue of the clients of the TCP Writer box and its full queue policies, over loopback connections.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "CTCPWriterClient.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+//---------------------------------------------------------------------------------------------------
+class TCPWriterClient_Tests : public testing::Test
+{
+protected:
+	using CTCPWriterClient = OpenViBE::Plugins::NetworkIO::CTCPWriterClient;
+	using EStatus = CTCPWriterClient::EStatus;
+	using tcp = boost::asio::ip::tcp;
+
+	// Size of the buffers sent, the socket buffers are made small so that a reader which doesn't read fills them quickly
+	static constexpr size_t BUFFER_SIZE = 16 * 1024;
+	static constexpr size_t SOCKET_BUFFER_SIZE = 4 * 1024;
+
+	// Connects a client of the writer to the reader
+	void connect(const size_t maxQueueSize, const uint64_t fullQueuePolicy)
+	{
+		m_client.reset(new CTCPWriterClient(m_ioContext, maxQueueSize, fullQueuePolicy));
+		tcp::acceptor acceptor(m_ioContext, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+		m_reader.open(tcp::v4());
+		m_reader.set_option(boost::asio::socket_base::receive_buffer_size(int(SOCKET_BUFFER_SIZE)));
+		m_reader.connect(acceptor.local_endpoint());
+		acceptor.accept(m_client->getSocket());
+		m_client->getSocket().set_option(boost::asio::socket_base::send_buffer_size(int(SOCKET_BUFFER_SIZE)));
+	}
+
+	// The n-th buffer starts with its number, the rest of it identifies it too
+	static CTCPWriterClient::buffer_t buffer(const uint64_t n)
+	{
+		auto buffer = std::make_shared<std::vector<uint8_t>>(BUFFER_SIZE, uint8_t(n % 251));
+		std::memcpy(buffer->data(), &n, sizeof(n));
+		return buffer;
+	}
+
+	// Reads the given size on a thread while the writes proceed, returns the numbers of the buffers read
+	std::vector<uint64_t> read(const size_t size)
+	{
+		std::vector<uint8_t> data(size);
+		boost::system::error_code ec;
+		std::thread reader([&]() { boost::asio::read(m_reader, boost::asio::buffer(data), ec); });
+		while (m_client->getQueuedCount() != 0 && !m_client->isDone()) { m_ioContext.run_one_for(std::chrono::milliseconds(10)); }
+		reader.join();
+		EXPECT_FALSE(ec) << ec.message();
+
+		// Only whole buffers are expected
+		std::vector<uint64_t> numbers;
+		for (size_t offset = 0; offset + BUFFER_SIZE <= data.size(); offset += BUFFER_SIZE) {
+			uint64_t n = 0;
+			std::memcpy(&n, data.data() + offset, sizeof(n));
+			numbers.push_back(n);
+			const auto expected = buffer(n);
+			EXPECT_TRUE(std::equal(expected->begin(), expected->end(), data.begin() + offset)) << "Buffer " << n << " is damaged.";
+		}
+		return numbers;
+	}
+
+	boost::asio::io_context m_ioContext;
+	tcp::socket m_reader { m_ioContext };
+	std::unique_ptr<CTCPWriterClient> m_client;
+};
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(TCPWriterClient_Tests, buffersInOrder)
+{
+	connect(1024 * BUFFER_SIZE, TCPWRITER_DROP_OLDEST);
+	for (uint64_t i = 0; i < 200; ++i) {
+		ASSERT_EQ(EStatus::Queued, m_client->queue(buffer(i)));
+		m_ioContext.poll();
+	}
+
+	std::vector<uint64_t> expected;
+	for (uint64_t i = 0; i < 200; ++i) { expected.push_back(i); }
+	EXPECT_EQ(expected, read(200 * BUFFER_SIZE));
+	EXPECT_EQ(0, m_client->getQueuedCount());
+	EXPECT_EQ(0, m_client->getQueueSize());
+	EXPECT_EQ(0, m_client->getDroppedCount());
+	EXPECT_TRUE(m_client->isOpen());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(TCPWriterClient_Tests, dropOldest)
+{
+	// The reader doesn't read while the buffers are queued
+	connect(4 * BUFFER_SIZE, TCPWRITER_DROP_OLDEST);
+	bool isDropped = false;
+	for (uint64_t i = 0; i < 200; ++i) {
+		isDropped |= m_client->queue(buffer(i)) == EStatus::Dropped;
+		m_ioContext.poll();
+		// Only the buffers being written, at most the 4 queued when their write started, and the newest one can't be dropped
+		ASSERT_LE(m_client->getQueueSize(), 5 * BUFFER_SIZE) << "Queue exceeds its maximum size.";
+	}
+	EXPECT_TRUE(isDropped);
+	EXPECT_TRUE(m_client->isOpen()) << "Client is disconnected with the drop oldest policy.";
+	const size_t nDropped = m_client->getDroppedCount();
+	ASSERT_GT(nDropped, 0);
+
+	// The client receives whole buffers in order, with the newest ones
+	const std::vector<uint64_t> numbers = read((200 - nDropped) * BUFFER_SIZE);
+	ASSERT_EQ(200 - nDropped, numbers.size());
+	for (size_t i = 1; i < numbers.size(); ++i) { EXPECT_LT(numbers[i - 1], numbers[i]); }
+	EXPECT_EQ(199, numbers.back()) << "Newest buffer is dropped.";
+	EXPECT_EQ(0, m_client->getQueuedCount());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(TCPWriterClient_Tests, disconnect)
+{
+	connect(4 * BUFFER_SIZE, TCPWRITER_DISCONNECT);
+	EStatus status = EStatus::Queued;
+	for (uint64_t i = 0; i < 200 && status == EStatus::Queued; ++i) {
+		status = m_client->queue(buffer(i));
+		m_ioContext.poll();
+	}
+	ASSERT_EQ(EStatus::Disconnected, status);
+	EXPECT_FALSE(m_client->isOpen());
+	EXPECT_EQ(0, m_client->getDroppedCount());
+
+	// The pending write is aborted, which isn't a write error
+	m_ioContext.poll();
+	EXPECT_TRUE(m_client->isDone()) << "Client can't be forgotten after its disconnection.";
+	EXPECT_FALSE(m_client->getWriteError()) << m_client->getWriteError().message();
+
+	// The reader sees the end of the connection after the data sent before the disconnection
+	std::vector<uint8_t> data(BUFFER_SIZE);
+	boost::system::error_code ec;
+	while (!ec) { m_reader.read_some(boost::asio::buffer(data), ec); }
+	EXPECT_TRUE(ec == boost::asio::error::eof || ec == boost::asio::error::connection_reset) << ec.message();
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(TCPWriterClient_Tests, readerDisconnection)
+{
+	connect(1024 * BUFFER_SIZE, TCPWRITER_DROP_OLDEST);
+	m_reader.close();
+
+	// The writes fail once the connection is known to be closed, the client is closed with the error
+	for (uint64_t i = 0; i < 1000 && !m_client->isDone(); ++i) {
+		m_client->queue(buffer(i));
+		m_ioContext.run_one_for(std::chrono::milliseconds(10));
+	}
+	ASSERT_TRUE(m_client->isDone());
+	EXPECT_TRUE(m_client->getWriteError());
+	EXPECT_EQ(EStatus::Queued, m_client->queue(buffer(0)));
+	m_ioContext.poll();
+	EXPECT_TRUE(m_client->isDone()) << "Closed client writes.";
+}
+//---------------------------------------------------------------------------------------------------
@@ -57,7 +57,7 @@ bool CPluginFiddler::startHook(const std::vector<CString>& /*selectedChannelName
 	return true;
 }
 
-void CPluginFiddler::loopHook(std::deque<std::vector<float>>& buffers, CStimulationSet& stimSet, const uint64_t /*start*/, const uint64_t /*end*/,
+void CPluginFiddler::loopHook(CSampleBuffer& buffers, CStimulationSet& stimSet, const uint64_t /*start*/, const uint64_t /*end*/,
 							  const uint64_t /* sampleTime */)
 {
 	if (m_BCI2000VersionFiddlerStrength > 10e-06F) {
@@ -94,9 +94,7 @@ void CPluginFiddler::loopHook(std::deque<std::vector<float>>& buffers, CStimulat
 				const float bump2 = std::exp(-std::pow(st - lobe2, 2) / spread2) * (st * std::pow(1 - st, 4));
 				const float value = (-0.5F * bump1 + 0.9F * bump2) * 40.0F;
 
-				std::vector<float>& sample = buffers[i];
-				float* tmp                 = &sample[0];
-				for (size_t j = 0; j < sample.size(); ++j) { tmp[j] += value * m_BCI2000VersionFiddlerStrength; }
+				for (size_t j = 0; j < buffers.getChannelCount(); ++j) { buffers.at(i, j) += value * m_BCI2000VersionFiddlerStrength; }
 				m_Counter++;
 			}
 
@@ -23,7 +23,7 @@ public:
 
 	bool startHook(const std::vector<CString>& selectedChannelNames, const size_t sampling, const size_t nChannel, const size_t nSamplePerSentBlock) override;
 	void stopHook() override {}
-	void loopHook(std::deque<std::vector<float>>& buffers, CStimulationSet& stimSet, const uint64_t start, const uint64_t end,
+	void loopHook(CSampleBuffer& buffers, CStimulationSet& stimSet, const uint64_t start, const uint64_t end,
 				  const uint64_t sampleTime) override;
 
 	// Plugin implementation
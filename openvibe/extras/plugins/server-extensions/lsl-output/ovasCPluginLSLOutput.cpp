@@ -72,6 +72,7 @@ bool CPluginLSLOutput::startHook(const std::vector<CString>& selectedChannelName
 								 const size_t nSamplePerSentBlock)
 {
 	m_nSamplePerSentBlock = nSamplePerSentBlock;
+	m_sample.resize(nChannel);
 
 	m_useOVTimestamps = m_kernelCtx.getConfigurationManager().expandAsBoolean("${LSL_UseOVTimestamps}", m_useOVTimestamps);
 	m_startTime       = System::Time::zgetTime();
@@ -108,7 +109,7 @@ bool CPluginLSLOutput::startHook(const std::vector<CString>& selectedChannelName
 	return true;
 }
 
-void CPluginLSLOutput::loopHook(std::deque<std::vector<float>>& buffers, CStimulationSet& stimSet, const uint64_t start, const uint64_t end,
+void CPluginLSLOutput::loopHook(CSampleBuffer& buffers, CStimulationSet& stimSet, const uint64_t start, const uint64_t end,
 								const uint64_t /*sampleTime*/)
 {
 	if (m_IsLSLOutputEnabled) {
@@ -119,12 +120,16 @@ void CPluginLSLOutput::loopHook(std::deque<std::vector<float>>& buffers, CStimul
 			if (m_useOVTimestamps) {
 				const double sampleStepInSec = CTime(sampleStep).toSeconds();
 				const double chunkStartInSec = CTime(start).toSeconds();
-				for (size_t i = 0; i < m_nSamplePerSentBlock; ++i) { m_signalOutlet->push_sample(buffers[i], chunkStartInSec + double(i) * sampleStepInSec); }
+				for (size_t i = 0; i < m_nSamplePerSentBlock; ++i) {
+					buffers.copySample(i, m_sample.data());
+					m_signalOutlet->push_sample(m_sample, chunkStartInSec + double(i) * sampleStepInSec);
+				}
 			}
 			else {
 				for (size_t i = 0; i < m_nSamplePerSentBlock; ++i) {
 					const double lslTime = LSL::getLSLRelativeTime(m_startTime + CTime(start + i * sampleStep));
-					m_signalOutlet->push_sample(buffers[i], lslTime);
+					buffers.copySample(i, m_sample.data());
+					m_signalOutlet->push_sample(m_sample, lslTime);
 				}
 			}
 
@@ -43,7 +43,7 @@ public:
 
 	bool startHook(const std::vector<CString>& selectedChannelNames, const size_t sampling, const size_t nChannel, const size_t nSamplePerSentBlock) override;
 	void stopHook() override;
-	void loopHook(std::deque<std::vector<float>>& buffers, CStimulationSet& stimSet, const uint64_t start, const uint64_t end,
+	void loopHook(CSampleBuffer& buffers, CStimulationSet& stimSet, const uint64_t start, const uint64_t end,
 				  const uint64_t sampleTime) override;
 
 	// Plugin implementation
@@ -58,6 +58,7 @@ private:
 	lsl::stream_outlet* m_stimulusOutlet = nullptr;
 
 	size_t m_nSamplePerSentBlock = 0;
+	std::vector<float> m_sample;	// Sample being pushed to the signal outlet
 
 	bool m_useOVTimestamps = false;
 	CTime m_startTime      = CTime(0);
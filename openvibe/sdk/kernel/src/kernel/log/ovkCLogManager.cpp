@@ -1,51 +1,164 @@
 #include "ovkCLogManager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
 namespace OpenViBE {
 namespace Kernel {
 
+namespace {
+// Messages waiting for the background writer, a logging thread waits for a free slot once it is full
+constexpr size_t QUEUE_SIZE = 1024;
+
+std::atomic<size_t> nManager { 0 };
+
+bool isLevelActive(const uint32_t activeLevels, const ELogLevel level) { return level >= 0 && level < 32 && (activeLevels >> level) & 1; }
+
+/// <summary> Gets the levels of the message active for a listener, a bit per level. </summary>
+uint32_t getActiveLevels(ILogListener* listener, const log_message_t& message)
+{
+	uint32_t activeLevels = 0;
+	const auto check      = [&](const ELogLevel level)
+	{
+		if (level >= 0 && level < 32 && !isLevelActive(activeLevels, level) && listener->isActive(level)) { activeLevels |= 1U << level; }
+	};
+
+	check(message.level);
+	for (const auto& event : message.events) { if (event.type == log_event_t::EType::Level) { check(ELogLevel(event.value.u64)); } }
+	return activeLevels;
+}
+
+void replay(const log_message_t& message, ILogListener* listener, const uint32_t activeLevels)
+{
+	ELogLevel level = message.level;
+	for (const auto& event : message.events)
+	{
+		if (event.type == log_event_t::EType::Level) { level = ELogLevel(event.value.u64); }
+		if (!isLevelActive(activeLevels, level)) { continue; }
+
+		switch (event.type)
+		{
+			case log_event_t::EType::Time: listener->log(CTime(event.value.u64));
+				break;
+			case log_event_t::EType::Size:
+#if defined __clang__
+				listener->log(size_t(event.value.u64));
+#else
+				listener->log(event.value.u64);
+#endif
+				break;
+			case log_event_t::EType::UInteger64: listener->log(event.value.u64);
+				break;
+			case log_event_t::EType::UInteger32: listener->log(uint32_t(event.value.u64));
+				break;
+			case log_event_t::EType::Integer64: listener->log(event.value.i64);
+				break;
+			case log_event_t::EType::Integer: listener->log(int(event.value.i64));
+				break;
+			case log_event_t::EType::Double: listener->log(event.value.f64);
+				break;
+			case log_event_t::EType::Boolean: listener->log(event.value.u64 != 0);
+				break;
+			case log_event_t::EType::Identifier: listener->log(CIdentifier(event.value.u64));
+				break;
+			case log_event_t::EType::String: listener->log(message.text.c_str() + event.value.u64);
+				break;
+			case log_event_t::EType::Level: listener->log(ELogLevel(event.value.u64));
+				break;
+			case log_event_t::EType::Color: listener->log(ELogColor(event.value.u64));
+				break;
+		}
+	}
+}
+}  // namespace
+
+CLogManager::CLogManager(const IKernelContext& ctx) : TKernelObject<ILogManager>(ctx), m_id(++nManager), m_queue(QUEUE_SIZE)
+{
+	for (auto& active : m_activeLevels) { active.store(true, std::memory_order_relaxed); }
+}
+
+CLogManager::~CLogManager()
+{
+	if (m_writer.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_wakeMutex);
+			m_stop = true;
+		}
+		m_wakeCondition.notify_one();
+		m_writer.join();
+	}
+}
+
 bool CLogManager::isActive(const ELogLevel level)
 {
-	const auto it = m_activeLevels.find(level);
-	if (it == m_activeLevels.end()) { return true; }
-	return it->second;
+	if (level < LogLevel_First || level > LogLevel_Last) { return true; }
+	return m_activeLevels[level].load(std::memory_order_relaxed);
 }
 
 bool CLogManager::activate(const ELogLevel level, const bool active)
 {
-	m_activeLevels[level] = active;
+	if (level < LogLevel_First || level > LogLevel_Last) { return false; }
+	m_activeLevels[level].store(active, std::memory_order_relaxed);
+	++m_version;
 	return true;
 }
 
 bool CLogManager::activate(const ELogLevel startLevel, const ELogLevel endLevel, const bool active)
 {
-	for (int i = startLevel; i <= endLevel; ++i) { m_activeLevels[ELogLevel(i)] = active; }
+	for (int i = startLevel; i <= endLevel; ++i) { m_activeLevels[i].store(active, std::memory_order_relaxed); }
+	++m_version;
 	return true;
 }
 
+void CLogManager::log(const double value)
+{
+	thread_state_t& state = getThreadState();
+	if (!state.active) { return; }
+
+	begin(state);
+	log_event_t event;
+	event.type      = log_event_t::EType::Double;
+	event.value.f64 = value;
+	state.message.events.push_back(event);
+}
+
 void CLogManager::log(const char* value)
 {
-	logForEach<const char*>(value);
+	thread_state_t& state = getThreadState();
+	if (state.active)
 	{
-		GRAB_OWNERSHIP;
+		begin(state);
+		log_event_t event;
+		event.type      = log_event_t::EType::String;
+		event.value.u64 = state.message.text.size();
+		state.message.events.push_back(event);
+		state.message.text.append(value);
+		state.message.text.push_back('\0');
+	}
 
-		std::string copy(value);
-		if (copy.length() > 0 && copy[copy.length() - 1] == '\n')
-		{
-			// we are done, release
-			m_owner = std::thread::id();
-			m_condition.notify_one();
-		}
+	// The end of line completes the message, even if it was not recorded itself
+	if (!state.message.events.empty())
+	{
+		const size_t length = std::strlen(value);
+		if (length > 0 && value[length - 1] == '\n') { dispatch(state); }
 	}
 }
 
 void CLogManager::log(const ELogLevel level)
 {
-	{
-		GRAB_OWNERSHIP;
-		m_currentLogLevel = level;
-	}
+	thread_state_t& state = getThreadState();
+	state.level           = level;
+	updateActivity(state);
+	if (!state.active) { return; }
 
-	logForEach<ELogLevel>(level);
+	begin(state);
+	log_event_t event;
+	event.type      = log_event_t::EType::Level;
+	event.value.u64 = uint64_t(level);
+	state.message.events.push_back(event);
+	state.message.maxLevel = std::max(state.message.maxLevel, level);
 }
 
 bool CLogManager::addListener(ILogListener* listener)
@@ -53,33 +166,179 @@ bool CLogManager::addListener(ILogListener* listener)
 	std::unique_lock<std::mutex> lock(m_mutex);
 
 	if (listener == nullptr) { return false; }
+	if (std::find(m_listeners.begin(), m_listeners.end(), listener) != m_listeners.end()) { return false; }
 
-	auto it = m_listeners.begin();
-	while (it != m_listeners.end())
+	m_listeners.push_back(listener);
+	if (isWrittenInBackground(listener))
 	{
-		if ((*it) == listener) { return false; }
-		++it;
+		std::lock_guard<std::mutex> writerLock(m_writerMutex);
+		m_asyncListeners.push_back(listener);
+		if (!m_writer.joinable()) { m_writer = std::thread(&CLogManager::write, this); }
 	}
-
-	m_listeners.push_back(listener);
+	else { m_syncListeners.push_back(listener); }
+	++m_version;
 	return true;
 }
 
 bool CLogManager::removeListener(ILogListener* listener)
 {
-	std::unique_lock<std::mutex> lock(m_mutex);
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		const auto it = std::find(m_listeners.begin(), m_listeners.end(), listener);
+		if (it == m_listeners.end()) { return false; }
+		m_listeners.erase(it);	// due to constraint in addListener(), listener can be in the array only once
+		m_syncListeners.erase(std::remove(m_syncListeners.begin(), m_syncListeners.end(), listener), m_syncListeners.end());
+		++m_version;
+	}
 
-	auto it = m_listeners.begin();
-	while (it != m_listeners.end())
+	if (isWrittenInBackground(listener))
 	{
-		if ((*it) == listener)
+		// The messages already dispatched are still written to the listener
+		flush();
+		std::lock_guard<std::mutex> lock(m_writerMutex);
+		m_asyncListeners.erase(std::remove(m_asyncListeners.begin(), m_asyncListeners.end(), listener), m_asyncListeners.end());
+	}
+	return true;
+}
+
+void CLogManager::flush()
+{
+	std::unique_lock<std::mutex> lock(m_writerMutex);
+	if (!m_writer.joinable()) { return; }
+
+	const size_t count = m_queue.getPushCount();
+	wake();
+	m_flushCondition.wait(lock, [&]() { return m_nWritten >= count; });
+}
+
+CLogManager::thread_state_t& CLogManager::getThreadState()
+{
+	static thread_local thread_state_t state;
+	if (state.manager != m_id)
+	{
+		state         = thread_state_t();
+		state.manager = m_id;
+	}
+	if (state.version != m_version.load(std::memory_order_acquire)) { refresh(state); }
+	return state;
+}
+
+void CLogManager::refresh(thread_state_t& state)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		state.version          = m_version.load(std::memory_order_acquire);
+		state.listeners        = m_listeners;
+		state.hasSyncListeners = !m_syncListeners.empty();
+		state.asyncListeners.clear();
+		for (auto* listener : m_listeners)
+		{
+			if (std::find(m_syncListeners.begin(), m_syncListeners.end(), listener) == m_syncListeners.end()) { state.asyncListeners.push_back(listener); }
+		}
+	}
+	updateActivity(state);
+}
+
+void CLogManager::updateActivity(thread_state_t& state)
+{
+	state.active = state.level != LogLevel_None && isActive(state.level)
+				   && std::any_of(state.listeners.begin(), state.listeners.end(), [&](ILogListener* listener) { return listener->isActive(state.level); });
+}
+
+void CLogManager::begin(thread_state_t& state)
+{
+	if (state.message.events.empty()) { state.message.level = state.message.maxLevel = state.level; }
+}
+
+void CLogManager::record(const log_event_t::EType type, const uint64_t value)
+{
+	thread_state_t& state = getThreadState();
+	if (!state.active) { return; }
+
+	begin(state);
+	log_event_t event;
+	event.type      = type;
+	event.value.u64 = value;
+	state.message.events.push_back(event);
+}
+
+void CLogManager::dispatch(thread_state_t& state)
+{
+	log_message_t& message = state.message;
+	if (state.hasSyncListeners)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto* listener : m_syncListeners) { replay(message, listener, getActiveLevels(listener, message)); }
+	}
+
+	if (!state.asyncListeners.empty())
+	{
+		// The writer runs later, the listeners are asked now which levels they take
+		for (auto* listener : state.asyncListeners) { message.listeners.emplace_back(listener, getActiveLevels(listener, message)); }
+
+		const bool isCritical = message.maxLevel >= LogLevel_Error;
+		while (!m_queue.push(message))
+		{
+			wake();
+			std::this_thread::yield();
+		}
+		message.clear();
+
+		if (isCritical) { flush(); }
+		else { wake(); }
+	}
+	else { message.clear(); }
+}
+
+void CLogManager::write()
+{
+	log_message_t message;
+	while (true)
+	{
+		bool hasWritten = false;
 		{
-			m_listeners.erase(it);
-			return true;	// due to constraint in addListener(), listener can be in the array only once, so we can return
+			std::lock_guard<std::mutex> lock(m_writerMutex);
+			while (m_queue.pop(message))
+			{
+				// A listener removed since the message was queued is skipped
+				for (const auto& listener : message.listeners)
+				{
+					if (std::find(m_asyncListeners.begin(), m_asyncListeners.end(), listener.first) != m_asyncListeners.end())
+					{
+						replay(message, listener.first, listener.second);
+					}
+				}
+				message.clear();
+				m_nWritten++;
+				hasWritten = true;
+			}
 		}
-		++it;
+		if (hasWritten) { m_flushCondition.notify_all(); }
+
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		if (m_stop && m_queue.empty()) { return; }
+		m_sleeping.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		m_wakeCondition.wait_for(lock, std::chrono::milliseconds(100), [this]() { return m_stop || !m_queue.empty(); });
+		m_sleeping.store(false, std::memory_order_relaxed);
+	}
+}
+
+void CLogManager::wake()
+{
+	// Pairs with the fence of the writer between announcing it sleeps and checking the queue
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_sleeping.load(std::memory_order_relaxed))
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_wakeCondition.notify_one();
 	}
-	return false;
+}
+
+bool CLogManager::isWrittenInBackground(ILogListener* listener)
+{
+	return listener->isDerivedFromClass(OVK_ClassId_Kernel_Log_LogListenerConsole) || listener->isDerivedFromClass(OVK_ClassId_Kernel_Log_LogListenerFile);
 }
 
 }  // namespace Kernel
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "../ovkTKernelObject.h"
+#include "ovkCLogQueue.h"
 
+#include <array>
+#include <atomic>
 #include <vector>
-#include <map>
 
 #include <mutex>
 #include <condition_variable>
@@ -12,66 +14,98 @@
 namespace OpenViBE {
 namespace Kernel {
 
+/// <summary> Log manager dispatching the messages of every thread to the log listeners. </summary>
+/// <remarks>
+/// Each thread assembles its messages on its own, fragments are only recorded if the current level is active
+/// for the manager and at least one listener. A message is dispatched once its last fragment ends with an end of line:
+/// the console and file listeners are written by a background thread fed through a bounded queue,
+/// other listeners (e.g. user interfaces) are called on the logging thread.
+/// Error and fatal messages are waited for, so they are written before the logging thread goes on.
+/// The levels active for each background listener are captured with the message, so later changes do not apply to queued messages.
+/// </remarks>
 class CLogManager final : public TKernelObject<ILogManager>
 {
 public:
 
-	explicit CLogManager(const IKernelContext& ctx) : TKernelObject<ILogManager>(ctx) {}
+	explicit CLogManager(const IKernelContext& ctx);
+	~CLogManager() override;
+
 	bool isActive(const ELogLevel level) override;
 	bool activate(const ELogLevel level, const bool active) override;
 	bool activate(const ELogLevel startLevel, const ELogLevel endLevel, const bool active) override;
 	bool activate(const bool active) override { return activate(LogLevel_First, LogLevel_Last, active); }
-	void log(const CTime value) override { logForEach<const CTime>(value); }
+	void log(const CTime value) override { record(log_event_t::EType::Time, value.time()); }
 #if defined __clang__
-	void log(const size_t value) override { logForEach<const size_t>(value); }
+	void log(const size_t value) override { record(log_event_t::EType::Size, uint64_t(value)); }
 #endif
-	void log(const uint64_t value) override { logForEach<const uint64_t>(value); }
-	void log(const uint32_t value) override { logForEach<const uint32_t>(value); }
-	void log(const int64_t value) override { logForEach<const int64_t>(value); }
-	void log(const int value) override { logForEach<const int>(value); }
-	void log(const double value) override { logForEach<const double>(value); }
-	void log(const bool value) override { logForEach<const bool>(value); }
-	void log(const CIdentifier& value) override { logForEach<const CIdentifier&>(value); }
+	void log(const uint64_t value) override { record(log_event_t::EType::UInteger64, value); }
+	void log(const uint32_t value) override { record(log_event_t::EType::UInteger32, value); }
+	void log(const int64_t value) override { record(log_event_t::EType::Integer64, uint64_t(value)); }
+	void log(const int value) override { record(log_event_t::EType::Integer, uint64_t(int64_t(value))); }
+	void log(const double value) override;
+	void log(const bool value) override { record(log_event_t::EType::Boolean, value ? 1 : 0); }
+	void log(const CIdentifier& value) override { record(log_event_t::EType::Identifier, value.id()); }
 	void log(const CString& value) override { log(value.toASCIIString()); }
 	void log(const std::string& value) override { log(value.c_str()); }
 	void log(const char* value) override;
 	void log(const ELogLevel level) override;
-	void log(const ELogColor color) override { logForEach<ELogColor>(color); }
+	void log(const ELogColor color) override { record(log_event_t::EType::Color, uint64_t(color)); }
 	bool addListener(ILogListener* listener) override;
 	bool removeListener(ILogListener* listener) override;
 
+	/// <summary> Waits until the messages dispatched so far are written by the background thread. </summary>
+	void flush();
+
 	_IsDerivedFromClass_Final_(TKernelObject<ILogManager>, OVK_ClassId_Kernel_Log_LogManager)
 
 protected:
 
-	// This macro waits until m_oHolder is either the current thread id or unassigned
-#define GRAB_OWNERSHIP std::unique_lock<std::mutex> lock(m_mutex); \
-	m_condition.wait(lock, [this]() { return (this->m_owner == std::thread::id() || this->m_owner == std::this_thread::get_id() ); } ); \
-	m_owner = std::this_thread::get_id();
-
-	template <class T>
-	void logForEach(T tValue)
+	/// <summary> Message being assembled by a thread. </summary>
+	typedef struct SThreadState
 	{
-		GRAB_OWNERSHIP;
+		size_t manager             = 0;				// Log manager the state belongs to
+		size_t version             = 0;				// Version of the listeners and active levels it was checked against
+		ELogLevel level            = LogLevel_Info;
+		bool active                = false;			// Fragments at the current level are recorded
+		bool hasSyncListeners      = false;
+		std::vector<ILogListener*> listeners;
+		std::vector<ILogListener*> asyncListeners;	// Listeners written in background
+		log_message_t message;
+	} thread_state_t;
 
-		if (m_currentLogLevel != LogLevel_None && this->isActive(m_currentLogLevel))
-		{
-			for (auto i = m_listeners.begin(); i != m_listeners.end(); ++i) { if ((*i)->isActive(m_currentLogLevel)) { (*i)->log(tValue); } }
-		}
-	}
+	/// <summary> Gets the state of the calling thread, checked against the current listeners and active levels. </summary>
+	thread_state_t& getThreadState();
+	void refresh(thread_state_t& state);
+	void updateActivity(thread_state_t& state);
+	void begin(thread_state_t& state);
+	void record(log_event_t::EType type, uint64_t value);
+	void dispatch(thread_state_t& state);
+	void write();
+	void wake();
 
-	std::vector<ILogListener*> m_listeners;
-	std::map<ELogLevel, bool> m_activeLevels;
-	ELogLevel m_currentLogLevel = LogLevel_Info;
-
-	// Variables to make sure only one thread writes to the LogManager at a time.
-	// Concurrency control operating logic:
-	//   Calling log() will wait until it obtains logmanager ownership for the calling thread
-	//   Only thread having the ownership can write to the log
-	//   After a thread logs an entry ending in an EOL character, the ownership is freed.
+	static bool isWrittenInBackground(ILogListener* listener);
+
+	size_t m_id = 0;
+	std::atomic<size_t> m_version { 1 };
+	std::array<std::atomic<bool>, LogLevel_Last + 1> m_activeLevels;
+
+	// Listener lists, the listeners called on the logging threads are called with m_mutex held
 	std::mutex m_mutex;
-	std::condition_variable m_condition;
-	std::thread::id m_owner;
+	std::vector<ILogListener*> m_listeners;
+	std::vector<ILogListener*> m_syncListeners;
+
+	// Background writer, its listeners are only used with m_writerMutex held
+	CLogQueue m_queue;
+	std::thread m_writer;
+	std::mutex m_writerMutex;
+	std::condition_variable m_flushCondition;
+	std::vector<ILogListener*> m_asyncListeners;
+	size_t m_nWritten = 0;
+
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wakeCondition;
+	std::atomic<bool> m_sleeping { false };
+	bool m_stop = false;
 };
 
 }  // namespace Kernel
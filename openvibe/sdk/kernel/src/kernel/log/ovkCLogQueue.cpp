@@ -0,0 +1,58 @@
+#include "ovkCLogQueue.h"
+
+#include <utility>
+
+namespace OpenViBE {
+namespace Kernel {
+
+CLogQueue::CLogQueue(const size_t size)
+{
+	size_t n = 2;
+	while (n < size) { n <<= 1; }
+	m_cells.reset(new cell_t[n]);
+	m_mask = n - 1;
+	for (size_t i = 0; i < n; ++i) { m_cells[i].sequence.store(i, std::memory_order_relaxed); }
+}
+
+bool CLogQueue::push(log_message_t& message)
+{
+	size_t pos = m_pushPos.load(std::memory_order_relaxed);
+	while (true)
+	{
+		cell_t& cell       = m_cells[pos & m_mask];
+		const size_t seq   = cell.sequence.load(std::memory_order_acquire);
+		const int64_t diff = int64_t(seq) - int64_t(pos);
+		if (diff == 0)
+		{
+			if (m_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				std::swap(cell.message, message);
+				cell.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (diff < 0) { return false; }	// The consumer has not freed the cell yet
+		else { pos = m_pushPos.load(std::memory_order_relaxed); }
+	}
+}
+
+bool CLogQueue::pop(log_message_t& message)
+{
+	const size_t pos = m_popPos.load(std::memory_order_relaxed);
+	cell_t& cell     = m_cells[pos & m_mask];
+	if (cell.sequence.load(std::memory_order_acquire) != pos + 1) { return false; }
+
+	std::swap(cell.message, message);
+	m_popPos.store(pos + 1, std::memory_order_relaxed);
+	cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+	return true;
+}
+
+bool CLogQueue::empty() const
+{
+	const size_t pos = m_popPos.load(std::memory_order_relaxed);
+	return m_cells[pos & m_mask].sequence.load(std::memory_order_acquire) != pos + 1;
+}
+
+}  // namespace Kernel
+}  // namespace OpenViBE
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../ovkTKernelObject.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OpenViBE {
+namespace Kernel {
+/// <summary> Fragment of a log message, as received by the log manager. </summary>
+typedef struct SLogEvent
+{
+	enum class EType { Time, Size, UInteger64, UInteger32, Integer64, Integer, Double, Boolean, Identifier, String, Level, Color };
+
+	EType type = EType::String;
+
+	union
+	{
+		uint64_t u64;
+		int64_t i64;
+		double f64;
+	} value { 0 };	// Offset in the message text for strings
+} log_event_t;
+
+/// <summary> Log message assembled by a thread, from the first fragment to the end of line. </summary>
+typedef struct SLogMessage
+{
+	std::vector<log_event_t> events;
+	std::string text;					// String fragments, each one followed by a null character
+	ELogLevel level    = LogLevel_Info;	// Level in effect before the first fragment
+	ELogLevel maxLevel = LogLevel_Info;	// Highest level in effect during the message
+
+	// Listeners written in background, with a bit set for each level of the message they had active when it was queued
+	std::vector<std::pair<ILogListener*, uint32_t>> listeners;
+
+	void clear()
+	{
+		events.clear();
+		text.clear();
+		listeners.clear();
+	}
+} log_message_t;
+
+/// <summary> Bounded multiple producers, single consumer queue of log messages. </summary>
+/// <remarks>
+/// Messages are swapped in and out of the queue cells rather than copied,
+/// so the event and text storage keeps circulating between the threads once allocated.
+/// </remarks>
+class CLogQueue final
+{
+public:
+
+	/// <param name="size"> Number of messages the queue can hold, rounded up to a power of two. </param>
+	explicit CLogQueue(size_t size);
+
+	/// <summary> Moves a message at the back of the queue, the message is left with the storage of a consumed one. </summary>
+	/// <returns> <c>false</c> if the queue is full. </returns>
+	bool push(log_message_t& message);
+
+	/// <summary> Moves the front message of the queue out, must only be called by the consumer thread. </summary>
+	/// <returns> <c>false</c> if the queue is empty. </returns>
+	bool pop(log_message_t& message);
+
+	bool empty() const;
+
+	/// <summary> Number of messages pushed so far, messages are popped in that order. </summary>
+	size_t getPushCount() const { return m_pushPos.load(std::memory_order_acquire); }
+
+private:
+
+	typedef struct SCell
+	{
+		std::atomic<size_t> sequence { 0 };
+		log_message_t message;
+	} cell_t;
+
+	std::unique_ptr<cell_t[]> m_cells;
+	size_t m_mask = 0;
+
+	alignas(64) std::atomic<size_t> m_pushPos { 0 };
+	alignas(64) std::atomic<size_t> m_popPos { 0 };
+};
+}  // namespace Kernel
+}  // namespace OpenViBE
@@ -5,6 +5,7 @@ namespace Kernel {
 
 CBuffer::CBuffer(const CBuffer& buffer)
 {
+	this->setPooled(true);
 	this->CMemoryBuffer::setSize(buffer.getSize(), true);
 	memcpy(this->CMemoryBuffer::getDirectPointer(), buffer.getDirectPointer(), buffer.getSize());
 }
@@ -2,16 +2,25 @@
 
 #include <openvibe/ov_all.h>
 
+#include <utility>
+
 namespace OpenViBE {
 namespace Kernel {
+/// <summary> Buffer of a chunk, its storage is drawn from the pool as chunks are continuously created and released. </summary>
 class CBuffer final : public CMemoryBuffer
 {
 public:
 
-	CBuffer() { }
+	CBuffer() { this->setPooled(true); }
 	explicit CBuffer(const CBuffer& buffer);
+	CBuffer(CBuffer&& buffer) noexcept : CMemoryBuffer(std::move(buffer)) { }
 
 	CBuffer& operator=(const CBuffer& buffer);
+	CBuffer& operator=(CBuffer&& buffer) noexcept
+	{
+		CMemoryBuffer::operator=(std::move(buffer));
+		return *this;
+	}
 };
 }  // namespace Kernel
 }  // namespace OpenViBE
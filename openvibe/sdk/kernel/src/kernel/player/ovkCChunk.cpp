@@ -0,0 +1,32 @@
+#include "ovkCChunk.h"
+
+#include <atomic>
+
+namespace OpenViBE {
+namespace Kernel {
+
+// Beyond that, the chunks of an output are kept by slow readers and their buffers are not recycled
+static const size_t MAX_RECYCLED_BUFFER = 16;
+
+void CChunk::renewBuffer(std::vector<std::shared_ptr<CBuffer>>& recycled)
+{
+	for (const auto& buffer : recycled)
+	{
+		if (buffer.use_count() == 1)
+		{
+			// The last other reference may have been released by another thread of the parallel scheduler
+			std::atomic_thread_fence(std::memory_order_acquire);
+			buffer->setSize(0, true);
+			m_buffer   = buffer;
+			m_isPooled = true;
+			return;
+		}
+	}
+
+	m_buffer   = std::make_shared<CBuffer>();
+	m_isPooled = recycled.size() < MAX_RECYCLED_BUFFER;
+	if (m_isPooled) { recycled.push_back(m_buffer); }
+}
+
+}  // namespace Kernel
+}  // namespace OpenViBE
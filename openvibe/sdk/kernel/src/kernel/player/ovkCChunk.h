@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ovkCBuffer.h"
+
+#include <memory>
+#include <vector>
+
+namespace OpenViBE {
+namespace Kernel {
+/// <summary> Chunk of a box stream, all the copies of a chunk share the same buffer. </summary>
+/// <remarks>
+/// A chunk is copied for each link of its output and again when queued on the target box,
+/// sharing the buffer makes these copies pointer copies. Boxes only read their input chunks,
+/// so the buffer is only copied if written while shared.
+/// The buffers of an output are kept in a pool to be reused once sent and released by every reader,
+/// the reference held by that pool does not count as sharing.
+/// </remarks>
+class CChunk
+{
+public:
+
+	CChunk() : m_buffer(std::make_shared<CBuffer>()) { }
+
+	CChunk(const CChunk& chunk) : m_buffer(chunk.m_buffer), m_startTime(chunk.m_startTime), m_endTime(chunk.m_endTime) { }
+
+	CChunk& operator=(const CChunk& chunk)
+	{
+		m_buffer       = chunk.m_buffer;
+		m_startTime    = chunk.m_startTime;
+		m_endTime      = chunk.m_endTime;
+		m_isDeprecated = chunk.m_isDeprecated;
+		m_isPooled     = false;
+		return *this;
+	}
+
+	const CBuffer& getBuffer() const { return *m_buffer; }
+	uint64_t getStartTime() const { return m_startTime; }
+	uint64_t getEndTime() const { return m_endTime; }
+	bool isDeprecated() const { return m_isDeprecated; }
+
+	CBuffer& getBuffer()
+	{
+		if (m_buffer.use_count() > (m_isPooled ? 2 : 1)) {
+			m_buffer   = std::make_shared<CBuffer>(*m_buffer);
+			m_isPooled = false;
+		}
+		return *m_buffer;
+	}
+
+	/// <summary> Leaves the buffer to the copies of the chunk and continues with an empty one. </summary>
+	/// <param name="recycled"> Buffers of the chunks previously sent, reused once no chunk holds them anymore. </param>
+	void renewBuffer(std::vector<std::shared_ptr<CBuffer>>& recycled);
+
+	bool setStartTime(const uint64_t startTime)
+	{
+		m_startTime = startTime;
+		return true;
+	}
+
+	bool setEndTime(const uint64_t endTime)
+	{
+		m_endTime = endTime;
+		return true;
+	}
+
+	bool markAsDeprecated(const bool isDeprecated)
+	{
+		m_isDeprecated = isDeprecated;
+		return true;
+	}
+
+protected:
+
+	std::shared_ptr<CBuffer> m_buffer;
+	uint64_t m_startTime = 0;
+	uint64_t m_endTime   = 0;
+	bool m_isDeprecated  = false;
+	bool m_isPooled      = false;	// The buffer is also held by the pool given to renewBuffer
+};
+}  // namespace Kernel
+}  // namespace OpenViBE
@@ -7,6 +7,7 @@
 
 #include <system/ovCChrono.h>
 
+#include <atomic>
 #include <string>
 
 namespace OpenViBE {
@@ -56,7 +57,7 @@ protected:
 	uint64_t m_currentTimeToReach     = 0;
 	uint64_t m_lateness               = 0;
 	uint64_t m_innerLateness          = 0;
-	EPlayerStatus m_status            = EPlayerStatus::Stop;
+	std::atomic<EPlayerStatus> m_status { EPlayerStatus::Stop };	// Boxes may stop or pause the player from the threads of the parallel scheduler
 	bool m_isInitializing             = false;
 	double m_fastForwardMaximumFactor = 0;
 
@@ -5,13 +5,16 @@
 #include "ovkCPlayer.h"
 #include "../scenario/ovkCScenarioSettingKeywordParserCallback.h"
 #include "ovkCBoxSettingModifierVisitor.h"
+#include "ovkCThreadPool.h"
 
 #include <fs/Files.h>
 
 #include <string>
 
+#include <algorithm>
 #include <cstdlib>
 #include <set>
+#include <thread>
 
 #if defined TARGET_OS_Windows
 #define stricmp _stricmp
@@ -450,6 +453,10 @@ ESchedulerInitialization CScheduler::initialize()
 		}
 	}
 
+	m_isParallel = boxInitialization && this->getConfigurationManager().expandAsBoolean("${Kernel_ParallelScheduler}", false);
+	if (boxInitialization && !this->buildRoutes()) { return ESchedulerInitialization::Failed; }
+	if (m_isParallel && !this->buildLevels()) { return ESchedulerInitialization::Failed; }
+
 	m_steps       = 0;
 	m_currentTime = 0;
 
@@ -481,6 +488,12 @@ bool CScheduler::uninitialize()
 	for (auto it = m_simulatedBoxes.begin(); it != m_simulatedBoxes.end(); ++it) { delete it->second; }
 	m_simulatedBoxes.clear();
 
+	m_threadPool.reset();
+	m_scheduledBoxes.clear();
+	m_levels.clear();
+	m_nCallerBoxes.clear();
+	m_isParallel = false;
+
 	m_scenario = nullptr;
 
 	return boxUninitialization;
@@ -495,36 +508,25 @@ bool CScheduler::loop()
 
 	bool boxProcessing = true;
 	m_oBenchmarkChrono.stepIn();
-	for (auto it = m_simulatedBoxes.begin(); it != m_simulatedBoxes.end(); ++
-		 it)
+	if (m_isParallel) { boxProcessing = this->loopLevels(); }
+	else
 	{
-		CSimulatedBox* simulatedBox = it->second;
-
-		System::CChrono& simulatedBoxChrono = m_simulatedBoxChronos[it->first.second];
-
-		IBox* box = m_scenario->getBoxDetails(it->first.second);
-
-		OV_ERROR_UNLESS_KRF(box, "Unable to get box details for box with id " << it->first.second.str(), Kernel::ErrorType::ResourceNotFound);
-
-		simulatedBoxChrono.stepIn();
-
-		if (!translateException([&]() { return this->processBox(simulatedBox, it->first.second); },
-								std::bind(&CScheduler::handleException, this, simulatedBox, "Box processing", std::placeholders::_1)))
+		for (auto& scheduled : m_scheduledBoxes)
 		{
-			boxProcessing = false;
+			scheduled.chrono->stepIn();
 
-			// break here because we do not want to keep on processing if one
-			// box fails
-			break;
-		}
+			if (!translateException([&]() { return this->processBox(scheduled); },
+									std::bind(&CScheduler::handleException, this, scheduled.simulatedBox, "Box processing", std::placeholders::_1)))
+			{
+				boxProcessing = false;
 
-		simulatedBoxChrono.stepOut();
+				// break here because we do not want to keep on processing if one
+				// box fails
+				break;
+			}
 
-		if (simulatedBoxChrono.hasNewEstimation())
-		{
-			//IBox* box=m_scenario->getBoxDetails(it->first.second);
-			box->addAttribute(OV_AttributeId_Box_ComputationTimeLastSecond, "");
-			box->setAttributeValue(OV_AttributeId_Box_ComputationTimeLastSecond, CIdentifier(simulatedBoxChrono.getTotalStepInDuration()).toString());
+			scheduled.chrono->stepOut();
+			this->updateComputationTime(scheduled);
 		}
 	}
 	m_oBenchmarkChrono.stepOut();
@@ -552,71 +554,261 @@ bool CScheduler::loop()
 	return boxProcessing;
 }
 
-bool CScheduler::processBox(CSimulatedBox* simulatedBox, const CIdentifier& boxID)
+bool CScheduler::processBox(scheduled_box_t& scheduled)
 {
-	if (simulatedBox)
+	CSimulatedBox* simulatedBox = scheduled.simulatedBox;
+	const CIdentifier& boxID    = scheduled.id;
+
+	OV_ERROR_UNLESS_KRF(simulatedBox->processClock(), "Process clock failed for box with id " << boxID.str(), Kernel::ErrorType::Internal);
+	if (simulatedBox->isReadyToProcess())
 	{
-		OV_ERROR_UNLESS_KRF(simulatedBox->processClock(), "Process clock failed for box with id " << boxID.str(), Kernel::ErrorType::Internal);
-		if (simulatedBox->isReadyToProcess())
-		{
-			OV_ERROR_UNLESS_KRF(simulatedBox->process(), "Process failed for box with id " << boxID.str(), Kernel::ErrorType::Internal);
-		}
+		OV_ERROR_UNLESS_KRF(simulatedBox->process(), "Process failed for box with id " << boxID.str(), Kernel::ErrorType::Internal);
+	}
 
-		//if the box is muted we still have to erase chunks that arrives at the input
-		std::map<size_t, std::list<CChunk>>& simulatedBoxInput = m_simulatedBoxInputs[boxID];
-		for (auto it1 = simulatedBoxInput.begin(); it1 != simulatedBoxInput.end(); ++it1)
+	//if the box is muted we still have to erase chunks that arrives at the input
+	for (size_t index = 0; index < scheduled.inputs.size(); ++index)
+	{
+		// Indexed as a box linked to itself appends to the chunks being processed
+		std::vector<CChunk>& chunks = scheduled.inputs[index];
+		for (size_t i = 0; i < chunks.size(); ++i)
 		{
-			std::list<CChunk>& simulatedBoxInputChunkList = it1->second;
-			for (auto it2 = simulatedBoxInputChunkList.begin(); it2 != simulatedBoxInputChunkList.end(); ++it2)
-			{
-				OV_ERROR_UNLESS_KRF(simulatedBox->processInput(it1->first, *it2),
-									"Process failed for box with id " << boxID.str() << " on input " << it1->first,
-									ErrorType::Internal);
+			OV_ERROR_UNLESS_KRF(simulatedBox->processInput(index, chunks[i]),
+								"Process failed for box with id " << boxID.str() << " on input " << index,
+								ErrorType::Internal);
 
-				if (simulatedBox->isReadyToProcess())
-				{
-					OV_ERROR_UNLESS_KRF(simulatedBox->process(), "Process failed for box with id " << boxID.str(), Kernel::ErrorType::Internal);
-				}
+			if (simulatedBox->isReadyToProcess())
+			{
+				OV_ERROR_UNLESS_KRF(simulatedBox->process(), "Process failed for box with id " << boxID.str(), Kernel::ErrorType::Internal);
 			}
-			simulatedBoxInputChunkList.clear();
 		}
+		chunks.clear();
 	}
 
 	return true;
 }
 
+void CScheduler::updateComputationTime(const scheduled_box_t& scheduled) const
+{
+	if (scheduled.chrono->hasNewEstimation())
+	{
+		scheduled.box->addAttribute(OV_AttributeId_Box_ComputationTimeLastSecond, "");
+		scheduled.box->setAttributeValue(OV_AttributeId_Box_ComputationTimeLastSecond, CIdentifier(scheduled.chrono->getTotalStepInDuration()).toString());
+	}
+}
+
 //___________________________________________________________________//
 //                                                                   //
 
-bool CScheduler::sendInput(const CChunk& chunk, const CIdentifier& boxId, const size_t index)
+bool CScheduler::buildRoutes()
 {
-	IBox* box = m_scenario->getBoxDetails(boxId);
-	if (box->hasAttribute(OV_AttributeId_Box_Disabled)) { return true; }
-	OV_ERROR_UNLESS_KRF(box, "Tried to send data chunk with invalid box identifier " << boxId.str(), Kernel::ErrorType::ResourceNotFound);
+	m_scheduledBoxes.clear();
+
+	// Ranks follow the processing order
+	std::map<CIdentifier, size_t> ranks;
+	for (const auto& simulatedBox : m_simulatedBoxes)
+	{
+		scheduled_box_t scheduled;
+		scheduled.id           = simulatedBox.first.second;
+		scheduled.simulatedBox = simulatedBox.second;
+		scheduled.box          = m_scenario->getBoxDetails(scheduled.id);
+		scheduled.chrono       = &m_simulatedBoxChronos[scheduled.id];
+		OV_ERROR_UNLESS_KRF(scheduled.box, "Unable to get box details for box with id " << scheduled.id.str(), Kernel::ErrorType::ResourceNotFound);
+		scheduled.inputs.resize(scheduled.box->getInputCount());
+
+		ranks[scheduled.id] = m_scheduledBoxes.size();
+		m_scheduledBoxes.push_back(std::move(scheduled));
+	}
+
+	// Links are resolved once here rather than on each chunk sent, chunks sent to a disabled box are dropped
+	typedef struct SLink
+	{
+		size_t output = 0;
+		size_t target = 0;
+		size_t input  = 0;
+	} link_t;
+	std::vector<std::vector<link_t>> links(m_scheduledBoxes.size());
+	for (size_t rank = 0; rank < m_scheduledBoxes.size(); ++rank)
+	{
+		const scheduled_box_t& scheduled = m_scheduledBoxes[rank];
+
+		CIdentifier* listID = nullptr;
+		size_t nbElems      = 0;
+		m_scenario->getLinkIdentifierFromBoxList(scheduled.id, &listID, &nbElems);
+		for (size_t i = 0; i < nbElems; ++i)
+		{
+			const ILink* link = m_scenario->getLinkDetails(listID[i]);
+			if (!link) { continue; }
+			const auto target = ranks.find(link->getTargetBoxIdentifier());
+			if (target == ranks.end()) { continue; }
+
+			link_t route;
+			route.output = link->getSourceBoxOutputIndex();
+			route.target = target->second;
+			route.input  = link->getTargetBoxInputIndex();
+			if (route.output >= scheduled.box->getOutputCount() || route.input >= m_scheduledBoxes[route.target].inputs.size())
+			{
+				m_scenario->releaseIdentifierList(listID);
+				OV_ERROR_KRF("Invalid link from output " << route.output << " of box " << scheduled.id.str()
+							 << " to input " << route.input << " of box " << m_scheduledBoxes[route.target].id.str(), ErrorType::OutOfBound);
+			}
+			links[rank].push_back(route);
+		}
+		m_scenario->releaseIdentifierList(listID);
+	}
+
+	for (size_t rank = 0; rank < m_scheduledBoxes.size(); ++rank)
+	{
+		scheduled_box_t& scheduled         = m_scheduledBoxes[rank];
+		std::vector<chunk_route_t>& routes = scheduled.simulatedBox->m_Routes;
+		routes.clear();
+
+		if (!m_isParallel)
+		{
+			// Chunks are directly queued on the target box, boxes processed after the source get them on this step
+			for (const link_t& link : links[rank])
+			{
+				std::vector<CChunk>* queue = &m_scheduledBoxes[link.target].inputs[link.input];
+				routes.push_back({ link.output, { { queue, queue } } });
+			}
+			continue;
+		}
+
+		// Chunks are kept by the source box until the target box gathers them, see gatherInputs(),
+		// with one slot per target box input so that several links to the same input keep their order.
+		// A box linked to itself is the only one to use its queues while it is processed, its chunks are
+		// queued directly to be processed on the same step, as in the sequential mode.
+		std::vector<std::pair<size_t, size_t>> slots;
+		for (const link_t& link : links[rank])
+		{
+			const std::pair<size_t, size_t> slot(link.target, link.input);
+			if (link.target != rank && std::find(slots.begin(), slots.end(), slot) == slots.end()) { slots.push_back(slot); }
+		}
+		for (auto& sentChunks : scheduled.sentChunks) { sentChunks.assign(slots.size(), std::vector<CChunk>()); }
+
+		for (size_t slot = 0; slot < slots.size(); ++slot)
+		{
+			chunk_source_t source;
+			source.rank  = rank;
+			source.slot  = slot;
+			source.input = slots[slot].second;
+			m_scheduledBoxes[slots[slot].first].sources.push_back(source);
+		}
+		for (const link_t& link : links[rank])
+		{
+			if (link.target == rank)
+			{
+				std::vector<CChunk>* queue = &scheduled.inputs[link.input];
+				routes.push_back({ link.output, { { queue, queue } } });
+				continue;
+			}
+			const size_t slot = size_t(std::find(slots.begin(), slots.end(), std::make_pair(link.target, link.input)) - slots.begin());
+			routes.push_back({ link.output, { { &scheduled.sentChunks[0][slot], &scheduled.sentChunks[1][slot] } } });
+		}
+	}
+
+	return true;
+}
 
-	OV_ERROR_UNLESS_KRF(index < box->getInputCount(),
-						"Tried to send data chunk with invalid input index " << index << " for box identifier" << boxId.str(),
-						ErrorType::OutOfBound);
+bool CScheduler::buildLevels()
+{
+	m_levels.clear();
+	m_nCallerBoxes.clear();
+
+	// In the sequential mode a box receives in the same step the chunks of the boxes processed before it,
+	// so it has to be processed in a later level than them. Chunks of the boxes processed after it only
+	// reach it on the next step, such links do not constrain the levels.
+	std::vector<size_t> levels(m_scheduledBoxes.size(), 0);
+	size_t nLevel = 0;
+	for (size_t rank = 0; rank < m_scheduledBoxes.size(); ++rank)
+	{
+		// Sources were added by buildRoutes() in ascending rank
+		for (const chunk_source_t& source : m_scheduledBoxes[rank].sources)
+		{
+			if (source.rank < rank) { levels[rank] = std::max(levels[rank], levels[source.rank] + 1); }
+		}
+		nLevel = std::max(nLevel, levels[rank] + 1);
+	}
 
-	auto it = m_simulatedBoxes.begin();
-	while (it != m_simulatedBoxes.end() && it->first.second != boxId) { ++it; }
+	// Visualization boxes draw in widgets owned by the scheduler thread, they stay on it
+	m_levels.resize(nLevel);
+	m_nCallerBoxes.resize(nLevel, 0);
+	std::vector<size_t> pooledBoxes;
+	for (size_t rank = 0; rank < m_scheduledBoxes.size(); ++rank)
+	{
+		const Plugins::IPluginObjectDesc* desc = this->getPluginManager().getPluginObjectDescCreating(m_scheduledBoxes[rank].box->getAlgorithmClassIdentifier());
+		if (desc && desc->hasFunctionality(Plugins::EPluginFunctionality::Visualization))
+		{
+			m_levels[levels[rank]].push_back(rank);
+			m_nCallerBoxes[levels[rank]]++;
+		}
+		else { pooledBoxes.push_back(rank); }
+	}
+	size_t nMaxBox = 0;
+	for (const size_t rank : pooledBoxes) { m_levels[levels[rank]].push_back(rank); }
+	for (const auto& level : m_levels) { nMaxBox = std::max(nMaxBox, level.size()); }
 
-	OV_ERROR_UNLESS_KRF(it != m_simulatedBoxes.end(),
-						"Tried to send data chunk with invalid simulated box identifier " << boxId.str(),
-						ErrorType::ResourceNotFound);
-	CSimulatedBox* simulatedBox = it->second;
+	// More threads than boxes in the widest level would never get any work
+	size_t nThread = size_t(this->getConfigurationManager().expandAsUInteger("${Kernel_ParallelSchedulerThreadCount}", 0));
+	if (nThread == 0) { nThread = std::max(1U, std::thread::hardware_concurrency()); }
+	nThread = std::min(nThread, nMaxBox);
+	m_threadPool = std::make_unique<CThreadPool>(nThread);
 
-	// use a fatal here because failing to meet this invariant
-	// means there is a bug in the scheduler implementation
-	OV_FATAL_UNLESS_K(simulatedBox, "Null box found for id " << boxId.str(), Kernel::ErrorType::BadValue);
+	this->getLogManager() << LogLevel_Trace << "Parallel scheduling of " << m_scheduledBoxes.size() << " boxes in " << nLevel << " levels on "
+			<< nThread << " threads\n";
 
-	// TODO: check if index does not overflow
+	return true;
+}
 
-	m_simulatedBoxInputs[boxId][index].push_back(chunk);
+bool CScheduler::loopLevels()
+{
+	const size_t parity = m_steps & 1;
+	for (size_t level = 0; level < m_levels.size(); ++level)
+	{
+		const std::vector<size_t>& ranks = m_levels[level];
+		m_threadPool->run(ranks.size(), [&](const size_t i)
+		{
+			scheduled_box_t& scheduled = m_scheduledBoxes[ranks[i]];
+			this->gatherInputs(ranks[i], parity);
+
+			scheduled.chrono->stepIn();
+			scheduled.succeeded = translateException([&]() { return this->processBox(scheduled); },
+													 std::bind(&CScheduler::handleException, this, scheduled.simulatedBox, "Box processing",
+															   std::placeholders::_1));
+			scheduled.chrono->stepOut();
+		}, m_nCallerBoxes[level]);
+
+		bool boxProcessing = true;
+		for (const size_t rank : ranks)
+		{
+			boxProcessing &= m_scheduledBoxes[rank].succeeded;
+			this->updateComputationTime(m_scheduledBoxes[rank]);
+		}
 
+		// The boxes of the failing level have all been processed, but we do not want to go further
+		if (!boxProcessing) { return false; }
+	}
 	return true;
 }
 
+void CScheduler::gatherInputs(const size_t rank, const size_t parity)
+{
+	scheduled_box_t& scheduled = m_scheduledBoxes[rank];
+
+	const auto gather = [&](const chunk_source_t& source, const size_t sourceParity)
+	{
+		std::vector<CChunk>& sentChunks = m_scheduledBoxes[source.rank].sentChunks[sourceParity][source.slot];
+		std::vector<CChunk>& chunks     = scheduled.inputs[source.input];
+		chunks.insert(chunks.end(), sentChunks.begin(), sentChunks.end());
+		sentChunks.clear();
+	};
+
+	// Same order as the sequential mode: first the chunks sent on the previous step by the boxes processed after this one,
+	// then the ones sent on this step by the boxes processed before it, each time in the processing order of the sources.
+	// The chunks of a box linked to itself are already queued, see buildRoutes().
+	for (const chunk_source_t& source : scheduled.sources) { if (source.rank > rank) { gather(source, 1 - parity); } }
+	for (const chunk_source_t& source : scheduled.sources) { if (source.rank < rank) { gather(source, parity); } }
+}
+
 uint64_t CScheduler::getCurrentLateness() const { return m_rPlayer.getCurrentSimulatedLateness(); }
 double CScheduler::getFastForwardMaximumFactor() const { return m_rPlayer.getFastForwardMaximumFactor(); }
 
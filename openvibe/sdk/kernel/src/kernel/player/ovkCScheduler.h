@@ -1,17 +1,19 @@
 #pragma once
 
 #include "../ovkTKernelObject.h"
+#include "ovkCSimulatedBox.h"
 #include <system/ovCChrono.h>
+#include <array>
 #include <map>
-#include <list>
+#include <memory>
+#include <vector>
 
 namespace OpenViBE {
 namespace Kernel {
 enum class ESchedulerInitialization { Success, BoxInitializationFailed, Failed };
 
-class CSimulatedBox;
-class CChunk;
 class CPlayer;
+class CThreadPool;
 
 class CScheduler final : public TKernelObject<IKernelObject>
 {
@@ -29,7 +31,7 @@ public:
 	bool uninitialize();
 	bool loop();
 
-	bool sendInput(const CChunk& chunk, const CIdentifier& boxId, size_t index);
+	size_t getStepCount() const { return m_steps; }
 	uint64_t getCurrentTime() const { return m_currentTime; }
 	uint64_t getCurrentLateness() const;
 	uint64_t getFrequency() const { return m_frequency; }
@@ -53,13 +55,52 @@ protected:
 
 	std::map<std::pair<int, CIdentifier>, CSimulatedBox*> m_simulatedBoxes;
 	std::map<CIdentifier, System::CChrono> m_simulatedBoxChronos;
-	std::map<CIdentifier, std::map<size_t, std::list<CChunk>>> m_simulatedBoxInputs;
 
 private:
 
+	/// <summary> Link of the parallel mode, from the point of view of its target box. </summary>
+	typedef struct SChunkSource
+	{
+		size_t rank  = 0;	// Source box
+		size_t slot  = 0;	// Chunks of the source box kept for the target box input
+		size_t input = 0;
+	} chunk_source_t;
+
+	/// <summary> Box of the scenario, ranked in processing order, with everything its processing needs resolved once. </summary>
+	typedef struct SScheduledBox
+	{
+		CIdentifier id;
+		CSimulatedBox* simulatedBox = nullptr;
+		IBox* box                   = nullptr;
+		System::CChrono* chrono     = nullptr;
+		// Chunks received since the box was last processed, by input. Each queue is drained entirely and cleared
+		// on each step, keeping its capacity, so it is used as a ring that always restarts at its first element.
+		std::vector<std::vector<CChunk>> inputs;
+
+		// Parallel mode
+		std::vector<chunk_source_t> sources;						// In ascending source rank
+		std::array<std::vector<std::vector<CChunk>>, 2> sentChunks;	// Chunks sent on even and odd steps, by slot
+		bool succeeded = true;
+	} scheduled_box_t;
+
 	void handleException(const CSimulatedBox* box, const char* errorHint, const std::exception& exception);
-	bool processBox(CSimulatedBox* simulatedBox, const CIdentifier& boxID);
+	bool processBox(scheduled_box_t& scheduled);
+	void updateComputationTime(const scheduled_box_t& scheduled) const;
 	bool flattenScenario();
+
+	bool buildRoutes();
+	bool buildLevels();
+	bool loopLevels();
+	void gatherInputs(size_t rank, size_t parity);
+
+	std::vector<scheduled_box_t> m_scheduledBoxes;
+
+	// Parallel mode, boxes of a level have no link between them that the sequential order would follow in the same step
+	bool m_isParallel = false;
+	std::vector<std::vector<size_t>> m_levels;	// Ranks of the boxes of each level, the ones to run on the scheduler thread first
+	std::vector<size_t> m_nCallerBoxes;			// Number of boxes of each level to run on the scheduler thread
+	std::unique_ptr<CThreadPool> m_threadPool;
+
 	System::CChrono m_oBenchmarkChrono;
 };
 }  // namespace Kernel
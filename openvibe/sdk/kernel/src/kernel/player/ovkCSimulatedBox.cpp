@@ -51,6 +51,7 @@ bool CSimulatedBox::initialize()
 	m_Inputs.resize(m_box->getInputCount());
 	m_Outputs.resize(m_box->getOutputCount());
 	m_CurrentOutputs.resize(m_box->getOutputCount());
+	m_recycledBuffers.resize(m_box->getOutputCount());
 	m_LastOutputStartTimes.resize(m_box->getOutputCount(), 0);
 	m_LastOutputEndTimes.resize(m_box->getOutputCount(), 0);
 
@@ -171,22 +172,12 @@ bool CSimulatedBox::process()
 
 	// perform output sending
 	{
-		CIdentifier* listID = nullptr;
-		size_t nbElems      = 0;
-		m_scenario->getLinkIdentifierFromBoxList(m_box->getIdentifier(), &listID, &nbElems);
-		for (size_t i = 0; i < nbElems; ++i)
+		const size_t parity = m_scheduler.getStepCount() & 1;
+		for (const auto& route : m_Routes)
 		{
-			const ILink* link = m_scenario->getLinkDetails(listID[i]);
-			if (link)
-			{
-				CIdentifier dstBoxID        = link->getTargetBoxIdentifier();
-				const size_t dstBoxInputIdx = link->getTargetBoxInputIndex();
-
-				const size_t sourceOutputIdx = link->getSourceBoxOutputIndex();
-				for (auto& chunk : m_Outputs[sourceOutputIdx]) { m_scheduler.sendInput(chunk, dstBoxID, dstBoxInputIdx); }
-			}
+			std::vector<CChunk>& queue = *route.queues[parity];
+			for (auto& chunk : m_Outputs[route.output]) { queue.push_back(chunk); }
 		}
-		m_scenario->releaseIdentifierList(listID);
 	}
 
 	// perform input cleaning
@@ -415,11 +406,11 @@ bool CSimulatedBox::markOutputAsReadyToSend(const size_t outputIdx, const uint64
 	m_CurrentOutputs[outputIdx].setStartTime(std::min(startTime, endTime));
 	m_CurrentOutputs[outputIdx].setEndTime(std::max(startTime, endTime));
 
-	// copies chunk
+	// shares chunk with the links of the output
 	m_Outputs[outputIdx].push_back(m_CurrentOutputs[outputIdx]);
 
-	// resets chunk size
-	m_CurrentOutputs[outputIdx].getBuffer().setSize(0, true);
+	// continues with an empty buffer
+	m_CurrentOutputs[outputIdx].renewBuffer(m_recycledBuffers[outputIdx]);
 
 	return true;
 }
@@ -1,56 +1,25 @@
 #pragma once
 
 #include "../ovkTKernelObject.h"
-#include "ovkCBuffer.h"
+#include "ovkCChunk.h"
 
 #include <system/ovCChrono.h>
+#include <array>
 #include <vector>
 #include <string>
 #include <deque>
+#include <memory>
 
 namespace OpenViBE {
 namespace Kernel {
 class CScheduler;
 
-class CChunk
+/// <summary> Link of a box output, resolved by the scheduler to the queue its chunks are sent to. </summary>
+typedef struct SChunkRoute
 {
-public:
-
-	CChunk() { }
-
-	CChunk(const CChunk& chunk) : m_buffer(chunk.m_buffer), m_startTime(chunk.m_startTime), m_endTime(chunk.m_endTime) { }
-
-	const CBuffer& getBuffer() const { return m_buffer; }
-	uint64_t getStartTime() const { return m_startTime; }
-	uint64_t getEndTime() const { return m_endTime; }
-	bool isDeprecated() const { return m_isDeprecated; }
-	CBuffer& getBuffer() { return m_buffer; }
-
-	bool setStartTime(const uint64_t startTime)
-	{
-		m_startTime = startTime;
-		return true;
-	}
-
-	bool setEndTime(const uint64_t endTime)
-	{
-		m_endTime = endTime;
-		return true;
-	}
-
-	bool markAsDeprecated(const bool isDeprecated)
-	{
-		m_isDeprecated = isDeprecated;
-		return true;
-	}
-
-protected:
-
-	CBuffer m_buffer;
-	uint64_t m_startTime = 0;
-	uint64_t m_endTime   = 0;
-	bool m_isDeprecated  = false;
-};
+	size_t output = 0;
+	std::array<std::vector<CChunk>*, 2> queues { { nullptr, nullptr } };	// On even and odd steps
+} chunk_route_t;
 
 class CSimulatedBox final : public TKernelObject<IBoxIO>
 {
@@ -114,11 +83,14 @@ protected:
 	uint64_t m_clockFrequency          = 0;
 	uint64_t m_clockActivationStep     = 0;
 
+	std::vector<std::vector<std::shared_ptr<CBuffer>>> m_recycledBuffers;	// By output
+
 public:
 
 	std::vector<std::deque<CChunk>> m_Inputs;
 	std::vector<std::deque<CChunk>> m_Outputs;
 	std::vector<CChunk> m_CurrentOutputs;
+	std::vector<chunk_route_t> m_Routes;	// In link order, set by the scheduler
 	std::vector<uint64_t> m_LastOutputStartTimes;
 	std::vector<uint64_t> m_LastOutputEndTimes;
 };
@@ -0,0 +1,75 @@
+#include "ovkCThreadPool.h"
+
+namespace OpenViBE {
+namespace Kernel {
+
+CThreadPool::CThreadPool(const size_t nThread)
+{
+	for (size_t i = 1; i < nThread; ++i) { m_threads.emplace_back(&CThreadPool::work, this); }
+}
+
+CThreadPool::~CThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_startCondition.notify_all();
+	for (auto& thread : m_threads) { thread.join(); }
+}
+
+void CThreadPool::run(const size_t count, const task_t& task, const size_t nCallerTask)
+{
+	// Nothing to share, waking the workers up would cost more than the tasks themselves
+	if (m_threads.empty() || count <= nCallerTask + 1)
+	{
+		for (size_t i = 0; i < count; ++i) { task(i); }
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_task     = &task;
+		m_count    = count;
+		m_next     = nCallerTask;
+		m_nRunning = m_threads.size();
+		m_generation++;
+	}
+	m_startCondition.notify_all();
+
+	for (size_t i = 0; i < nCallerTask; ++i) { task(i); }
+	runTasks();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this]() { return m_nRunning == 0; });
+	m_task = nullptr;
+}
+
+void CThreadPool::work()
+{
+	size_t generation = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_startCondition.wait(lock, [&]() { return m_stop || m_generation != generation; });
+			if (m_stop) { return; }
+			generation = m_generation;
+		}
+
+		runTasks();
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (--m_nRunning == 0) { m_doneCondition.notify_one(); }
+		}
+	}
+}
+
+void CThreadPool::runTasks()
+{
+	for (size_t i = m_next++; i < m_count; i = m_next++) { (*m_task)(i); }
+}
+
+}  // namespace Kernel
+}  // namespace OpenViBE
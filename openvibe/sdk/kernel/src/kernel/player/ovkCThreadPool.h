@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenViBE {
+namespace Kernel {
+/// <summary> Fork-join pool used by the scheduler to process the independent boxes of a step concurrently. </summary>
+/// <remarks>
+/// Tasks are claimed one at a time from a shared cursor by the workers and the calling thread,
+/// so a long box does not hold back the boxes queued behind it on the same thread.
+/// </remarks>
+class CThreadPool final
+{
+public:
+	using task_t = std::function<void(size_t)>;
+
+	/// <param name="nThread"> Number of threads taking part in a run, including the calling thread. </param>
+	explicit CThreadPool(size_t nThread);
+	~CThreadPool();
+
+	size_t getThreadCount() const { return m_threads.size() + 1; }
+
+	/// <summary> Calls <c>task(i)</c> for every i in [0, count) and returns once all of them are done. </summary>
+	/// <param name="count"> Number of tasks. </param>
+	/// <param name="task"> Task to run, it must not throw. </param>
+	/// <param name="nCallerTask"> The first <c>nCallerTask</c> tasks are run on the calling thread only (e.g. boxes drawing in widgets). </param>
+	void run(size_t count, const task_t& task, size_t nCallerTask = 0);
+
+private:
+	void work();
+	void runTasks();
+
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_startCondition;
+	std::condition_variable m_doneCondition;
+
+	const task_t* m_task = nullptr;
+	size_t m_count       = 0;
+	std::atomic<size_t> m_next { 0 };
+	size_t m_nRunning    = 0;
+	size_t m_generation  = 0;
+	bool m_stop          = false;
+};
+}  // namespace Kernel
+}  // namespace OpenViBE
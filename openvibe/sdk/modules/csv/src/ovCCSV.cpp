@@ -36,10 +36,10 @@
 #include <numeric>
 #include <algorithm>
 #include <array>
+#include <charconv>
+#include <cstring>
 
-#include <boost/spirit/include/qi.hpp>
 #include <boost/algorithm/string.hpp>
-#include <boost/spirit/include/phoenix_operator.hpp>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/regex.hpp>
 
@@ -78,6 +78,70 @@ static const size_t CHAR_TO_READ = 511;
 
 static const char END_OF_LINE_CHAR('\n');
 
+static const size_t WRITE_BLOCK_SIZE = 1 << 20;  // Formatted lines are written to the file once they reach this size
+static const size_t READ_BLOCK_SIZE  = 1 << 20;  // Size of the blocks read from the file, lines are parsed in place
+
+// Same output as streaming the value with std::fixed and the precision, without the stream
+static void appendFixed(std::string& out, const double value, const size_t precision)
+{
+	char buffer[128];
+	const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, int(precision));
+	if (result.ec == std::errc()) {
+		out.append(buffer, result.ptr);
+		return;
+	}
+
+	// Huge values or precisions do not fit in the buffer
+	std::stringstream ss;
+	ss.precision(precision);
+	ss << std::fixed << value;
+	out += ss.str();
+}
+
+static void appendUInt(std::string& out, const uint64_t value)
+{
+	char buffer[24];
+	out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+}
+
+static bool isSpace(const char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f'; }
+
+// Parses a number as a spirit phrase parser would: spaces around it are skipped and a plus sign is accepted
+template <typename T>
+static bool parseNumber(const char*& it, const char* end, T& value)
+{
+	while (it != end && isSpace(*it)) { ++it; }
+	if (it != end && *it == '+') { ++it; }
+
+	const auto result = std::from_chars(it, end, value);
+	if (result.ec != std::errc()) { return false; }
+
+	it = result.ptr;
+	while (it != end && isSpace(*it)) { ++it; }
+	return true;
+}
+
+// Parses the separated numbers at the start of a range, the index and value of each one are given to the function
+template <typename T, typename TFunction>
+static size_t parseList(const char* it, const char* end, const char separator, TFunction function)
+{
+	size_t n = 0;
+	T value;
+	while (parseNumber(it, end, value)) {
+		function(n++, value);
+		if (it == end || *it != separator) { break; }
+		++it;
+	}
+	return n;
+}
+
+// Last occurrence of a character in a range, nullptr if there is none
+static const char* findLast(const char* begin, const char* end, const char c)
+{
+	for (const char* it = end; it != begin;) { if (*--it == c) { return it; } }
+	return nullptr;
+}
+
 bool CCSVHandler::streamReader(std::istream& in, std::string& out, const char delimiter, std::string& bufferHistory) const
 {
 	// To improve the performance of the reading, we read a bunch a chars rather one char by one char.
@@ -130,6 +194,36 @@ bool CCSVHandler::streamReader(std::istream& in, std::string& out, const char de
 	return true;
 }
 
+bool CCSVHandler::readLine(const char*& begin, const char*& end)
+{
+	while (true) {
+		const char* data      = m_readBuffer.data();
+		const char* delimiter = nullptr;
+		if (m_readPosition < m_readBuffer.size()) {
+			delimiter = static_cast<const char*>(std::memchr(data + m_readPosition, END_OF_LINE_CHAR, m_readBuffer.size() - m_readPosition));
+		}
+
+		if (delimiter) {
+			begin          = data + m_readPosition;
+			end            = delimiter;
+			m_readPosition = size_t(delimiter - data) + 1;
+#if defined TARGET_OS_Linux || defined TARGET_OS_MacOS
+			if (m_isCRLFEOL && end != begin) { --end; }  // Remove the carriage return char.
+#endif
+			return true;
+		}
+
+		// Keep the start of the incomplete line and read the next block after it, a last line without end of line is not read
+		m_readBuffer.erase(m_readBuffer.begin(), m_readBuffer.begin() + m_readPosition);
+		m_readPosition    = 0;
+		const size_t size = m_readBuffer.size();
+		m_readBuffer.resize(size + READ_BLOCK_SIZE);
+		m_fs.read(m_readBuffer.data() + size, READ_BLOCK_SIZE);
+		m_readBuffer.resize(size + size_t(m_fs.gcount()));
+		if (m_readBuffer.size() == size) { return false; }
+	}
+}
+
 void CCSVHandler::split(const std::string& in, const char delimiter, std::vector<std::string>& out) const
 {
 	std::stringstream stringStream(in);
@@ -398,6 +492,8 @@ bool CCSVHandler::openFile(const std::string& fileName, const EFileAccessMode mo
 	// Reset the read position
 	m_fs.clear();
 	m_fs.seekg(0);
+	m_readBuffer.clear();
+	m_readPosition = 0;
 
 	m_isHeaderRead       = false;
 	m_isFirstLineWritten = false;
@@ -416,8 +512,6 @@ bool CCSVHandler::readSamplesAndEventsFromFile(const size_t lineNb, std::vector<
 		return false;
 	}
 
-	chunks.clear();
-
 	// Calculate the size of the matrix depending of the stream type
 	size_t matrixSize = size_t(m_nSamplePerBuffer);
 
@@ -431,13 +525,19 @@ bool CCSVHandler::readSamplesAndEventsFromFile(const size_t lineNb, std::vector<
 	}
 	else { matrixSize = 0; }
 
-	SMatrixChunk chunk(0, 0, std::vector<double>(matrixSize), 0);
+	// The chunks already in the vector are reused, so that their matrices keep their storage from one call to the next
+	size_t nChunk = 0;
+	while (nChunk < lineNb && m_hasDataToRead) {
+		if (nChunk == chunks.size()) { chunks.emplace_back(0, 0, std::vector<double>(matrixSize), 0); }
+		SMatrixChunk& chunk = chunks[nChunk];
+		chunk.matrix.resize(matrixSize);
 
-	while (chunks.size() < lineNb && m_hasDataToRead) {
 		for (size_t lineIndex = 0; lineIndex < m_nSamplePerBuffer; lineIndex++) {
-			std::string lineValue;
+			const char* begin = nullptr;
+			const char* end   = nullptr;
 
-			if (!this->streamReader(m_fs, lineValue, END_OF_LINE_CHAR, m_bufferReadFileLine)) {
+			if (!this->readLine(begin, end)) {
+				chunks.erase(chunks.begin() + nChunk, chunks.end());
 				if (lineIndex != 0) {
 					m_lastStringError = "Chunk is not complete";
 					m_logError        = LogErrorCodes_MissingData;
@@ -448,9 +548,10 @@ bool CCSVHandler::readSamplesAndEventsFromFile(const size_t lineNb, std::vector<
 				return true;
 			}
 
-			const size_t columnCount = std::count(lineValue.cbegin(), lineValue.cend(), ',') + 1;
+			const size_t columnCount = std::count(begin, end, SEPARATOR) + 1;
 
 			if (columnCount != m_nCol) {
+				chunks.erase(chunks.begin() + nChunk, chunks.end());
 				m_lastStringError = "There is " + std::to_string(columnCount) + " columns in the Header instead of " + std::to_string(m_nCol) + " on line " +
 									std::to_string(lineIndex + 1);
 
@@ -459,15 +560,22 @@ bool CCSVHandler::readSamplesAndEventsFromFile(const size_t lineNb, std::vector<
 			}
 
 			// get Matrix chunk, LogError set in the function
-			if (!this->readSampleChunk(lineValue, chunk, lineIndex)) { return false; }
+			if (!this->readSampleChunk(begin, end, chunk, lineIndex)) {
+				chunks.erase(chunks.begin() + nChunk, chunks.end());
+				return false;
+			}
 
 			// get stimulations chunk, LogError set in the function
-			if (!this->readStimulationChunk(lineValue, stimulations, lineIndex + 1)) { return false; }
+			if (!this->readStimulationChunk(begin, end, stimulations, lineIndex + 1)) {
+				chunks.erase(chunks.begin() + nChunk, chunks.end());
+				return false;
+			}
 		}
 
-		chunks.push_back(chunk);
+		nChunk++;
 	}
 
+	chunks.erase(chunks.begin() + nChunk, chunks.end());
 	return true;
 }
 
@@ -487,14 +595,15 @@ bool CCSVHandler::readEventsFromFile(size_t stimsToRead, std::vector<SStimulatio
 
 	events.clear();
 
-	std::string lineValue;
+	const char* begin = nullptr;
+	const char* end   = nullptr;
 	while (events.size() < stimsToRead && m_hasDataToRead) {
-		if (!this->streamReader(m_fs, lineValue, END_OF_LINE_CHAR, m_bufferReadFileLine)) {
+		if (!this->readLine(begin, end)) {
 			// There is no more data to read
 			m_hasDataToRead = false;
 			break;
 		}
-		if (!readStimulationChunk(lineValue, events, 0)) { return false; }
+		if (!readStimulationChunk(begin, end, events, 0)) { return false; }
 	}
 
 	return true;
@@ -520,14 +629,7 @@ bool CCSVHandler::writeHeaderToFile()
 	if (header.empty()) { return false; }
 
 	m_isFirstLineWritten = true;
-	try { m_fs << header; }
-	catch (std::ios_base::failure& fail) {
-		m_lastStringError = "Error occured while writing: ";
-		m_lastStringError += fail.what();
-		m_logError = LogErrorCodes_ErrorWhileWriting;
-		return false;
-	}
-
+	m_writeBuffer += header;
 	return true;
 }
 
@@ -539,42 +641,49 @@ bool CCSVHandler::writeDataToFile()
 		return false;
 	}
 
-	std::string csv;
-
-	// set matrix (in case of error, logError set in the function)
-	if (!this->createCSVStringFromData(false, csv)) { return false; }
-
-	try { m_fs << csv; }
-	catch (std::ios_base::failure& fail) {
-		m_lastStringError = "Error occured while writing: ";
-		m_lastStringError += fail.what();
-		m_logError = LogErrorCodes_ErrorWhileWriting;
+	// set matrix (in case of error, logError set in the function), lines already formatted are written when the buffer is full
+	const size_t size = m_writeBuffer.size();
+	if (!this->createCSVStringFromData(false, m_writeBuffer)) {
+		m_writeBuffer.resize(size);
 		return false;
 	}
 
-	return true;
+	return m_writeBuffer.size() < WRITE_BLOCK_SIZE || flushWriteBuffer();
 }
 
 bool CCSVHandler::writeAllDataToFile()
 {
-	std::string csv;
-
 	// in case of error, logError set in the function
-	if (!createCSVStringFromData(true, csv)) { return false; }
+	const size_t size = m_writeBuffer.size();
+	if (!createCSVStringFromData(true, m_writeBuffer)) {
+		m_writeBuffer.resize(size);
+		return false;
+	}
+
+	return flushWriteBuffer();
+}
 
-	try { m_fs << csv; }
+bool CCSVHandler::flushWriteBuffer()
+{
+	if (m_writeBuffer.empty()) { return true; }
+
+	try { m_fs.write(m_writeBuffer.data(), std::streamsize(m_writeBuffer.size())); }
 	catch (std::ios_base::failure& fail) {
+		m_writeBuffer.clear();
 		m_lastStringError = "Error occured while writing: ";
 		m_lastStringError += fail.what();
 		m_logError = LogErrorCodes_ErrorWhileWriting;
 		return false;
 	}
 
+	m_writeBuffer.clear();
 	return true;
 }
 
 bool CCSVHandler::closeFile()
 {
+	const bool isFlushed = flushWriteBuffer();
+
 	m_stimulations.clear();
 	m_chunks.clear();
 	m_dimSizes.clear();
@@ -594,7 +703,7 @@ bool CCSVHandler::closeFile()
 		return false;
 	}
 
-	return true;
+	return isFlushed;
 }
 
 bool CCSVHandler::addSample(const SMatrixChunk& sample)
@@ -773,43 +882,23 @@ bool CCSVHandler::noEventsUntilDate(const double date)
 	return true;
 }
 
-std::string CCSVHandler::stimulationsToString(const std::vector<SStimulationChunk>& stimulationsToPrint) const
+void CCSVHandler::appendStimulations(const std::vector<SStimulationChunk>& stimulations, std::string& csv) const
 {
-	if (stimulationsToPrint.empty()) { return std::string(2, SEPARATOR); } // Empty columns
-
-	std::array<std::string, 3> stimulations;
-
-	const auto itBegin = stimulationsToPrint.cbegin();
-	const auto itEnd   = stimulationsToPrint.cend();
-
-	if (itBegin != itEnd) {
-		stimulations.at(0) = std::to_string(itBegin->id);
-
-		std::stringstream ss;
-		ss.str("");
-		ss.precision(m_oPrecision);
-		ss << std::fixed << itBegin->date;
-		stimulations.at(1) = ss.str();
-
-		ss.str("");
-		ss << std::fixed << itBegin->duration;
-		stimulations.at(2) = ss.str();
+	// One column for identifiers, one for dates and one for durations, empty columns if there is no stimulation
+	for (size_t i = 0; i < stimulations.size(); ++i) {
+		if (i != 0) { csv += DATA_SEPARATOR; }
+		appendUInt(csv, stimulations[i].id);
 	}
-
-	for (auto it = itBegin + 1; it != itEnd; ++it) {
-		stimulations.at(0) += std::string(1, DATA_SEPARATOR) + std::to_string(it->id);
-		std::stringstream ss;
-		ss.str("");
-		ss.precision(m_oPrecision);
-		ss << std::fixed << it->date;
-		stimulations.at(1) += std::string(1, DATA_SEPARATOR) + ss.str();
-
-		ss.str("");
-		ss << std::fixed << it->duration;
-		stimulations.at(2) += std::string(1, DATA_SEPARATOR) + ss.str();
+	csv += SEPARATOR;
+	for (size_t i = 0; i < stimulations.size(); ++i) {
+		if (i != 0) { csv += DATA_SEPARATOR; }
+		appendFixed(csv, stimulations[i].date, m_oPrecision);
+	}
+	csv += SEPARATOR;
+	for (size_t i = 0; i < stimulations.size(); ++i) {
+		if (i != 0) { csv += DATA_SEPARATOR; }
+		appendFixed(csv, stimulations[i].duration, m_oPrecision);
 	}
-
-	return boost::algorithm::join(stimulations, std::string(1, SEPARATOR));
 }
 
 std::string CCSVHandler::createHeaderString()
@@ -990,25 +1079,20 @@ bool CCSVHandler::createCSVStringFromData(const bool canWriteAll, std::string& c
 
 			// Time and Epoch
 			const std::pair<double, double> currentTime = { m_chunks.front().startTime, m_chunks.front().endTime };
-			std::stringstream ss;
-			ss.str("");
-			ss.precision(m_oPrecision);
-			ss << std::fixed << currentTime.first;
-
-			csv += ss.str();
+			appendFixed(csv, currentTime.first, m_oPrecision);
 
 			switch (m_inputTypeID) {
 				case EStreamType::Spectrum:
 				case EStreamType::StreamedMatrix:
 				case EStreamType::CovarianceMatrix:
 				case EStreamType::FeatureVector:
-					ss.str("");
-					ss << std::fixed << currentTime.second;
-					csv += std::string(1, SEPARATOR) + ss.str();
+					csv += SEPARATOR;
+					appendFixed(csv, currentTime.second, m_oPrecision);
 					break;
 
 				case EStreamType::Signal:
-					csv += std::string(1, SEPARATOR) + std::to_string(m_chunks.front().epoch);
+					csv += SEPARATOR;
+					appendUInt(csv, m_chunks.front().epoch);
 					break;
 
 				case EStreamType::Stimulations:
@@ -1024,9 +1108,7 @@ bool CCSVHandler::createCSVStringFromData(const bool canWriteAll, std::string& c
 			// Matrix
 			for (const double& value : m_chunks.front().matrix) {
 				csv += SEPARATOR;
-				ss.str("");
-				ss << std::fixed << value;
-				csv += ss.str();
+				appendFixed(csv, value, m_oPrecision);
 			}
 
 			m_chunks.pop_front();
@@ -1048,7 +1130,7 @@ bool CCSVHandler::createCSVStringFromData(const bool canWriteAll, std::string& c
 					stimulationTime = m_stimulations.front().date;
 				}
 
-				csv += stimulationsToString(stimulationsToWrite);
+				appendStimulations(stimulationsToWrite, csv);
 			}
 			else { csv += std::string(2, SEPARATOR); }
 
@@ -1058,8 +1140,10 @@ bool CCSVHandler::createCSVStringFromData(const bool canWriteAll, std::string& c
 	}
 	else if (!m_stimulations.empty()) {
 		if (m_inputTypeID == EStreamType::Stimulations) {
+			std::vector<SStimulationChunk> stimulation(1, m_stimulations.front());
 			for (auto stim = m_stimulations.cbegin(); stim != m_stimulations.end(); ++stim) {
-				csv += stimulationsToString(std::vector<SStimulationChunk>(1, *stim));
+				stimulation.front() = *stim;
+				appendStimulations(stimulation, csv);
 				csv += "\n";
 			}
 			m_stimulations.clear();
@@ -1117,6 +1201,8 @@ bool CCSVHandler::parseHeader()
 	}
 #endif
 	m_bufferReadFileLine.clear();
+	m_readBuffer.clear();
+	m_readPosition = 0;
 
 	switch (m_inputTypeID) {
 		case EStreamType::Signal:
@@ -1163,6 +1249,8 @@ bool CCSVHandler::parseHeader()
 	}
 #endif
 	m_bufferReadFileLine.clear();
+	m_readBuffer.clear();
+	m_readPosition = 0;
 
 	return true;
 }
@@ -1468,13 +1556,14 @@ bool CCSVHandler::parseMatrixHeader(const std::vector<std::string>& header)
 	return true;
 }
 
-bool CCSVHandler::readSampleChunk(const std::string& line, SMatrixChunk& sample, const size_t lineNb)
+bool CCSVHandler::readSampleChunk(const char* begin, const char* end, SMatrixChunk& sample, const size_t lineNb)
 {
-	const auto firstColumn  = std::find(line.cbegin(), line.cend(), SEPARATOR);
-	const auto secondColumn = std::find(firstColumn + 1, line.cend(), SEPARATOR);
+	const char* firstColumn  = std::find(begin, end, SEPARATOR);
+	const char* secondColumn = std::find(firstColumn + 1, end, SEPARATOR);
 
 	if (lineNb % m_nSamplePerBuffer == 0) {
-		if (!boost::spirit::qi::parse(line.cbegin(), firstColumn, boost::spirit::qi::double_, sample.startTime)) {
+		const char* it = begin;
+		if (!parseNumber(it, firstColumn, sample.startTime)) {
 			m_lastStringError = "Invalid value for the start time. Error on line " + std::to_string(lineNb);
 			m_logError        = LogErrorCodes_InvalidArgumentException;
 			return false;
@@ -1482,7 +1571,8 @@ bool CCSVHandler::readSampleChunk(const std::string& line, SMatrixChunk& sample,
 	}
 
 	if (m_inputTypeID == EStreamType::Signal) {
-		if (!boost::spirit::qi::parse(firstColumn + 1, secondColumn, boost::spirit::qi::ulong_long, sample.epoch)) {
+		const char* it = firstColumn + 1;
+		if (!parseNumber(it, secondColumn, sample.epoch)) {
 			m_lastStringError = "Invalid value for the epoch. Error on line " + std::to_string(lineNb);
 			m_logError        = LogErrorCodes_InvalidArgumentException;
 			return false;
@@ -1493,78 +1583,82 @@ bool CCSVHandler::readSampleChunk(const std::string& line, SMatrixChunk& sample,
 	else {
 		sample.epoch = std::numeric_limits<uint64_t>::max();
 
-		if (!boost::spirit::qi::parse(firstColumn + 1, secondColumn, boost::spirit::qi::double_, sample.endTime)) {
+		const char* it = firstColumn + 1;
+		if (!parseNumber(it, secondColumn, sample.endTime)) {
 			m_lastStringError = "Invalid value for the end time. Error on line " + std::to_string(lineNb);
 			m_logError        = LogErrorCodes_InvalidArgumentException;
 			return false;
 		}
 	}
 
-	const size_t eventDurationCol = line.find_last_of(SEPARATOR);
-	const size_t eventDateCol     = line.find_last_of(SEPARATOR, eventDurationCol - 1);
-	const size_t eventIdCol       = line.find_last_of(SEPARATOR, eventDateCol - 1);
+	// The line has all its columns, checked by the caller
+	const char* eventIdCol = findLast(begin, findLast(begin, findLast(begin, end, SEPARATOR), SEPARATOR), SEPARATOR);
+	const size_t nValue    = m_nCol - N_POST_DATA_COL - N_PRE_DATA_COL;
 
-	std::vector<double> colMatrix;
-
-	boost::spirit::qi::phrase_parse(secondColumn + 1, line.cbegin() + eventIdCol, boost::spirit::qi::double_ % SEPARATOR, boost::spirit::ascii::space,
-									colMatrix);
+	// Values are parsed straight into the matrix, samples of a signal or spectrum are interleaved by line
+	size_t nParsed = 0;
+	if (m_inputTypeID == EStreamType::Signal || m_inputTypeID == EStreamType::Spectrum) {
+		nParsed = parseList<double>(secondColumn + 1, eventIdCol, SEPARATOR, [&](const size_t index, const double value)
+		{
+			const size_t position = (index * m_nSamplePerBuffer) + lineNb;
+			if (index < nValue && position < sample.matrix.size()) { sample.matrix[position] = value; }
+		});
+	}
+	else {
+		sample.matrix.resize(nValue);
+		nParsed = parseList<double>(secondColumn + 1, eventIdCol, SEPARATOR, [&](const size_t index, const double value)
+		{
+			if (index < nValue) { sample.matrix[index] = value; }
+		});
+	}
 
-	if (colMatrix.size() != m_nCol - N_POST_DATA_COL - N_PRE_DATA_COL) {
+	if (nParsed != nValue) {
 		m_lastStringError = "Invalid number of channel. Error on line " + std::to_string(lineNb);
 		m_logError        = LogErrorCodes_InvalidArgumentException;
 		return false;
 	}
 
-	if (m_inputTypeID == EStreamType::Signal) {
-		for (size_t index = 0; index < m_dimLabels.size(); ++index) { sample.matrix[(index * m_nSamplePerBuffer) + lineNb] = colMatrix[index]; }
-	}
-	else if (m_inputTypeID == EStreamType::Spectrum) {
-		for (size_t index = 0; index < colMatrix.size(); ++index) { sample.matrix[(index * m_nSamplePerBuffer) + lineNb] = colMatrix[index]; }
-	}
-	else {
-		sample.matrix.clear();
-		std::move(colMatrix.begin(), colMatrix.end(), std::back_inserter(sample.matrix));
-	}
-
 	return true;
 }
 
-bool CCSVHandler::readStimulationChunk(const std::string& line, std::vector<SStimulationChunk>& stimulations, const size_t /*lineNb*/)
+bool CCSVHandler::readStimulationChunk(const char* begin, const char* end, std::vector<SStimulationChunk>& stimulations, const size_t /*lineNb*/)
 {
-	const size_t eventDurationCol = line.find_last_of(SEPARATOR);
-	const size_t eventDateCol     = line.find_last_of(SEPARATOR, eventDurationCol - 1);
-	const size_t eventIdCol       = line.find_last_of(SEPARATOR, eventDateCol - 1) + 1;
+	const char* eventDurationCol = findLast(begin, end, SEPARATOR);
+	const char* eventDateCol     = eventDurationCol ? findLast(begin, eventDurationCol, SEPARATOR) : nullptr;
 
-	if (eventDurationCol == eventDateCol && eventDurationCol == eventIdCol) {
+	if (!eventDateCol) {
 		m_lastStringError = "No separators found in line";
 		m_logError        = LogErrorCodes_StimulationSize;
 		return false;
 	}
 
-	std::vector<uint64_t> stimIDs;
-	// pick all time identifiers for the current time
-	boost::spirit::qi::phrase_parse(line.cbegin() + eventIdCol, line.cbegin() + eventDateCol, boost::spirit::qi::ulong_long % DATA_SEPARATOR,
-									boost::spirit::ascii::space, stimIDs);
+	// Stimulation only files have no column before the identifiers
+	const char* eventIdCol = findLast(begin, eventDateCol, SEPARATOR);
+	eventIdCol             = eventIdCol ? eventIdCol + 1 : begin;
 
-	std::vector<double> stimDates;
-	// pick all time identifiers for the current time
-	boost::spirit::qi::phrase_parse(line.cbegin() + eventDateCol + 1, line.cbegin() + eventDurationCol, boost::spirit::qi::double_ % DATA_SEPARATOR,
-									boost::spirit::ascii::space, stimDates);
-
-	std::vector<double> stimDurations;
-	// pick all time identifiers for the current time
-	boost::spirit::qi::phrase_parse(line.cbegin() + eventDurationCol + 1, line.cend(), boost::spirit::qi::double_ % DATA_SEPARATOR, boost::spirit::ascii::space,
-									stimDurations);
+	// pick all identifiers, dates and durations for the current time
+	const size_t first = stimulations.size();
+	const size_t nID   = parseList<uint64_t>(eventIdCol, eventDateCol, DATA_SEPARATOR, [&](const size_t /*index*/, const uint64_t id)
+	{
+		stimulations.emplace_back(id, 0.0, 0.0);
+	});
+	const size_t nDate = parseList<double>(eventDateCol + 1, eventDurationCol, DATA_SEPARATOR, [&](const size_t index, const double date)
+	{
+		if (index < nID) { stimulations[first + index].date = date; }
+	});
+	const size_t nDuration = parseList<double>(eventDurationCol + 1, end, DATA_SEPARATOR, [&](const size_t index, const double duration)
+	{
+		if (index < nID) { stimulations[first + index].duration = duration; }
+	});
 
-	if (stimIDs.size() != stimDates.size() || stimIDs.size() != stimDurations.size()) {
-		m_lastStringError = "There is " + std::to_string(stimIDs.size()) + " identifiers, " + std::to_string(stimDates.size()) + " dates, and " + std::
-							to_string(stimDurations.size()) + " durations";
+	if (nID != nDate || nID != nDuration) {
+		stimulations.erase(stimulations.begin() + first, stimulations.end());
+		m_lastStringError = "There is " + std::to_string(nID) + " identifiers, " + std::to_string(nDate) + " dates, and " + std::to_string(nDuration) +
+							" durations";
 		m_logError = LogErrorCodes_StimulationSize;
 		return false;
 	}
 
-	for (size_t index = 0; index < stimIDs.size(); ++index) { stimulations.emplace_back(stimIDs[index], stimDates[index], stimDurations[index]); }
-
 	return true;
 }
 
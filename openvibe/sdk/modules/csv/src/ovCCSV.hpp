@@ -213,13 +213,12 @@ private:
 	void split(const std::string& in, char delimiter, std::vector<std::string>& out) const;
 
 	/**
-	 * \brief Create a string with stimulations to add in the buffer.
+	 * \brief Append the stimulation columns of a line to the CSV string.
 	 *
-	 * \param stimulationsToPrint stimulations to put into the buffer
-	 *
-	 * \return string with stimulations to write
+	 * \param stimulations stimulations to put into the columns
+	 * \param csv [out] The CSV string.
 	 */
-	std::string stimulationsToString(const std::vector<SStimulationChunk>& stimulationsToPrint) const;
+	void appendStimulations(const std::vector<SStimulationChunk>& stimulations, std::string& csv) const;
 
 	/**
 	 * \brief Create a string representation of the header data.
@@ -230,16 +229,24 @@ private:
 	std::string createHeaderString();
 
 	/**
-	 * \brief Set the buffer in function of data saved.
+	 * \brief Append the lines of the data saved to the CSV string.
 	 *
 	 * \param canWriteAll true if it must write all lines, false if it write only the next buffer
-	 * \param csv The CSV string.
+	 * \param csv [out] The CSV string.
 	 *
 	 * \retval true in case of success
 	 * \retval false in case of wrong data sent
 	 */
 	bool createCSVStringFromData(bool canWriteAll, std::string& csv);
 
+	/**
+	 * \brief Write the lines formatted so far to the file.
+	 *
+	 * \retval true in case of success
+	 * \retval false in case of error while writing
+	 */
+	bool flushWriteBuffer();
+
 	/**
 	 * \brief Extracts file format from header
 	 * Sets member variable m_inputTypeID accordingly
@@ -282,25 +289,27 @@ private:
 	/**
 	 * \brief Read line data concerning time, epoch and matrix.
 	 *
-	 * \param line line to read
+	 * \param begin start of the line to read
+	 * \param end end of the line to read
 	 * \param sample [out] : reference to stock data in
 	 * \param lineNb index of the read line
 	 *
 	 * \retval true in case of success
 	 * \retval false in case of error (as letters instead of numbers)
 	 */
-	bool readSampleChunk(const std::string& line, SMatrixChunk& sample, size_t lineNb);
+	bool readSampleChunk(const char* begin, const char* end, SMatrixChunk& sample, size_t lineNb);
 
 	/**
 	 * \brief Read line data conerning stimulations.
-	 * \param line the line to read
+	 * \param begin start of the line to read
+	 * \param end end of the line to read
 	 * \param stimulations [out] : vector to stock stimulations in (identifier, date and duration)
 	 * \param lineNb the line actually reading
 	 *
 	 * \retval true in case of success
 	 * \retval false in case of error (as letters instead of numbers)
 	 */
-	bool readStimulationChunk(const std::string& line, std::vector<SStimulationChunk>& stimulations, size_t lineNb);
+	bool readStimulationChunk(const char* begin, const char* end, std::vector<SStimulationChunk>& stimulations, size_t lineNb);
 
 	/**
 	 * \brief Update position into the matrix while reading or writing.
@@ -329,6 +338,17 @@ private:
 	 */
 	bool streamReader(std::istream& in, std::string& out, char delimiter, std::string& bufferHistory) const;
 
+	/**
+	 * \brief Read the next line of the file from the read buffer, refilled by large blocks.
+	 *
+	 * \param begin [out] The start of the line.
+	 * \param end [out] The end of the line, without the end of line chars.
+	 *
+	 * \retval true in case of success, the line is valid until the next call
+	 * \retval false if there is no more complete line in the file
+	 */
+	bool readLine(const char*& begin, const char*& end);
+
 	std::fstream m_fs;
 	std::string m_filename;
 	std::deque<SMatrixChunk> m_chunks;
@@ -361,6 +381,9 @@ private:
 	bool m_lastMatrixOnly = false;
 
 	std::string m_bufferReadFileLine; // Buffer used to store unused read chars.
+	std::string m_writeBuffer;        // Lines formatted but not yet written to the file, kept allocated from one write to the next.
+	std::vector<char> m_readBuffer;   // Block of the file being parsed, starting with the rest of the previous block.
+	size_t m_readPosition = 0;        // Start of the next line in the read buffer.
 
 	bool m_hasDataToRead = true;
 
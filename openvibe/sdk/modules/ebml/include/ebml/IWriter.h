@@ -124,4 +124,17 @@ protected:
  * \return \c NULL when something went wrong.
  */
 extern EBML_API IWriter* createWriter(IWriterCallback& callback);
+
+/**
+ * \brief Instanciation function for EBML writer objects serializing nodes in place
+ * \param callback [in] : The callback object the writer should use
+ * \return a pointer to the created instance on success.
+ * \return \c NULL when something went wrong.
+ *
+ * Both writers serialize each top level node into a reusable buffer and give it to the callback in a single call.
+ * This one codes the size of master nodes on 8 bytes, patched when the node is closed, instead of the shortest
+ * coding, so that nothing written has to be moved afterwards. The stream is a few bytes longer per master node
+ * and remains valid EBML.
+ */
+extern EBML_API IWriter* createInPlaceWriter(IWriterCallback& callback);
 }  // namespace EBML
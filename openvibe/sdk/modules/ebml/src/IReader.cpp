@@ -1,24 +1,8 @@
 #include "ebml/IReader.h"
-#include <cstring>
 
-#include <cstdio>
+#include <algorithm>
 #include <cstring>
-#include <iostream>
-
-#if 0
-#define _Debug_ _is_in_debug_mode_(m_totalBytes)
-static bool _is_in_debug_mode_(uint64_t value)
-{
-	static int i=0;
-	// bool result=i++>5500000;
-	bool result=value>29605500;
-	if (result) std::cout << "Arround " << value << std::endl;
-	return result;
-
-}
-#else
-#define _Debug_ false
-#endif
+#include <vector>
 
 // ________________________________________________________________________________________________________________
 //
@@ -39,7 +23,7 @@ inline size_t getCodedSizeLength(const unsigned char* buffer)
 	return 10;
 }
 
-inline uint64_t getValue(unsigned char* buffer)
+inline uint64_t getValue(const unsigned char* buffer)
 {
 	uint64_t result     = 0;
 	const size_t length = getCodedSizeLength(buffer);
@@ -56,30 +40,6 @@ inline uint64_t getValue(unsigned char* buffer)
 // ________________________________________________________________________________________________________________
 //
 
-namespace EBML {
-namespace {
-class CReaderNode
-{
-public:
-	CReaderNode(const CIdentifier& identifier, CReaderNode* parentNode) : m_ParentNode(parentNode), m_Id(identifier) { }
-
-private:
-	CReaderNode() = delete;
-
-public:
-
-	CReaderNode* m_ParentNode = nullptr;
-	CIdentifier m_Id;
-	size_t m_ContentSize     = 0;
-	size_t m_ReadContentSize = 0;
-	unsigned char* m_Buffer  = nullptr;
-};
-}  // namespace
-}  // namespace EBML
-
-// ________________________________________________________________________________________________________________
-//
-
 namespace EBML {
 namespace {
 class CReader final : public IReader
@@ -87,7 +47,6 @@ class CReader final : public IReader
 public:
 
 	explicit CReader(IReaderCallback& callback) : m_readerCB(callback) { }
-	~CReader() override;
 	bool processData(const void* buffer, const size_t size) override;
 	CIdentifier getCurrentNodeID() const override;
 	size_t getCurrentNodeSize() const override;
@@ -102,250 +61,147 @@ protected:
 		FillingContent,
 	};
 
+	typedef struct SNode
+	{
+		CIdentifier id;
+		size_t contentSize = 0;
+		size_t end         = 0;	// Position of the end of the content in the stream
+	} node_t;
+
+	bool readCodedValue(const unsigned char*& buffer, const unsigned char* end, uint64_t& value);
+	void closeFinishedNodes();
+
 	IReaderCallback& m_readerCB;
-	CReaderNode* m_currentNode  = nullptr;
-	size_t m_pendingSize        = 0;
-	size_t m_nPending           = 0;
-	unsigned char* m_pending    = nullptr;
-	EStatus m_status            = FillingIdentifier;
-	EStatus m_lastStatus        = FillingIdentifier;
-	CIdentifier m_currentID     = 0;
-	size_t m_currentContentSize = 0;
-	size_t m_totalBytes         = 0;
+	EStatus m_status        = FillingIdentifier;
+	CIdentifier m_currentID = 0;
+	size_t m_position       = 0;	// Bytes of the stream processed so far
+
+	// Opened nodes, the current one last, their storage is kept from one node to the next
+	std::vector<node_t> m_nodes;
+
+	// Coded value or content split between calls, contents entirely in the given buffer are never copied
+	unsigned char m_coded[10];
+	size_t m_nCoded = 0;
+	std::vector<unsigned char> m_content;
+	size_t m_nContent = 0;
 };
 }  // namespace
 
 // ________________________________________________________________________________________________________________
 //
 
-CReader::~CReader()
+bool CReader::readCodedValue(const unsigned char*& buffer, const unsigned char* end, uint64_t& value)
 {
-	delete [] m_pending;
-	while (m_currentNode)
+	if (m_nCoded == 0)
 	{
-		CReaderNode* parentNode = m_currentNode->m_ParentNode;
-		delete m_currentNode;
-		m_currentNode = parentNode;
+		const size_t available = size_t(end - buffer);
+		if (available >= 2 || (available == 1 && !needsTwoBytesToGetCodedSizeLength(buffer)))
+		{
+			const size_t length = getCodedSizeLength(buffer);
+			if (length <= available)
+			{
+				value = getValue(buffer);
+				buffer += length;
+				m_position += length;
+				return true;
+			}
+		}
 	}
+
+	// At most 10 bytes, gathered one at a time until the length is known and reached
+	while (buffer != end)
+	{
+		m_coded[m_nCoded++] = *buffer++;
+		m_position++;
+		if (m_nCoded == 1 && needsTwoBytesToGetCodedSizeLength(m_coded)) { continue; }
+		if (m_nCoded == getCodedSizeLength(m_coded))
+		{
+			value    = getValue(m_coded);
+			m_nCoded = 0;
+			return true;
+		}
+	}
+	return false;
 }
 
-bool CReader::processData(const void* buffer, const size_t size)
+void CReader::closeFinishedNodes()
 {
-	m_totalBytes += size;
-
-	if (_Debug_)
+	while (!m_nodes.empty() && m_position >= m_nodes.back().end)
 	{
-		std::cout << "Received " << size << " byte(s) new buffer :";
-		for (int i = 0; i < int(size) /* && i<4*/; ++i) { printf("[%02X]", ((unsigned char*)buffer)[i]); }
-		std::cout << "...\n";
+		m_readerCB.closeChild();
+		m_nodes.pop_back();
 	}
+}
 
+bool CReader::processData(const void* buffer, const size_t size)
+{
 	if (!buffer || !size) { return true; }
 
-	unsigned char* tmpBuffer = (unsigned char*)buffer;
-	size_t currentSize       = size;
-	bool finished            = false;
-	while (!finished)
+	const unsigned char* data = static_cast<const unsigned char*>(buffer);
+	const unsigned char* end  = data + size;
+	while (true)
 	{
-		size_t processedPendingBytes = 0;
-		size_t processedBytes        = 0;
-		m_lastStatus                 = m_status;
-
-		if (_Debug_ && m_nPending)
+		if (m_status == FillingContent)
 		{
-			std::cout << m_nPending << " byte(s) pending : ";
-			for (int i = 0; i < int(m_nPending); ++i) { printf("[%02X]", m_pending[i]); }
-			std::cout << "\n";
-		}
-
-		// Processes data
-		switch (m_status)
-		{
-			case FillingIdentifier:
-			case FillingContentSize:
+			const node_t& node     = m_nodes.back();
+			const size_t available = size_t(end - data);
+			if (m_nContent == 0 && node.contentSize <= available)
 			{
-				if (needsTwoBytesToGetCodedSizeLength(m_nPending ? m_pending : tmpBuffer))
-				{
-					if (m_nPending + currentSize < 2)
-					{
-						finished = true;
-						break;
-					}
-
-					if (m_nPending == 1)
-					{
-						// assumes (currentSize != 0) because (m_nPending + currentSize >= 2) and (m_nPending == 1)
-						m_pending[1] = tmpBuffer[0];
-						tmpBuffer++;
-						m_nPending++;
-						currentSize--;
-					}
-				}
-
-				const size_t length = getCodedSizeLength(m_nPending ? m_pending : tmpBuffer);
-				if (length > currentSize + m_nPending) { finished = true; }
-				else
-				{
-					unsigned char* encodedBuffer    = new unsigned char[length];
-					const size_t pendingBytesToCopy = (length > m_nPending ? m_nPending : length);
-					memcpy(encodedBuffer, m_pending, size_t(pendingBytesToCopy));
-					memcpy(encodedBuffer + pendingBytesToCopy, tmpBuffer, size_t(length - pendingBytesToCopy));
-					const uint64_t value = getValue(encodedBuffer);
-					delete [] encodedBuffer;
-					processedPendingBytes = pendingBytesToCopy;
-					processedBytes        = length;
-
-					switch (m_status)
-					{
-						case FillingIdentifier:
-						{
-							m_currentID = value;
-							m_status    = FillingContentSize;
-							if (_Debug_)
-							{
-								printf("Found identifier 0x%llX - Changing status to FillingContentSize...\n", static_cast<unsigned long long>(m_currentID));
-							}
-						}
-						break;
-
-						case FillingContentSize:
-						{
-							m_currentContentSize = value;
-							if (m_readerCB.isMasterChild(m_currentID))
-							{
-								m_status = FillingIdentifier;
-								if (_Debug_)
-								{
-									std::cout << "Found content size " << m_currentContentSize << " of master node - Changing status to FillingIdentifier...\n";
-								}
-							}
-							else
-							{
-								m_status = FillingContent;
-								if (_Debug_)
-								{
-									std::cout << "Found content size " << m_currentContentSize <<
-											" of *non* master node - Changing status to FillingContent...\n";
-								}
-							}
-						}
-						break;
-
-						case FillingContent:
-							// Should never happen - avoids the warning
-							break;
-					}
-				}
+				m_readerCB.processChildData(node.contentSize ? data : nullptr, node.contentSize);
+				data += node.contentSize;
+				m_position += node.contentSize;
 			}
-			break;
-
-			case FillingContent:
+			else
 			{
-				if (m_currentNode->m_ContentSize == 0)
-				{
-					m_status = FillingIdentifier;
-					if (_Debug_)
-					{
-						std::cout << "Finished with " << m_currentNode->m_ContentSize << " byte(s) content - Changing status to FillingIdentifier...\n";
-					}
-					m_readerCB.processChildData(nullptr, 0);
-				}
-				else
-				{
-					if (m_currentNode->m_ReadContentSize == 0 && m_currentNode->m_ContentSize <= currentSize)
-					{
-						m_status = FillingIdentifier;
-
-						processedBytes = m_currentNode->m_ContentSize;
-						if (_Debug_)
-						{
-							std::cout << "Optimized processing of " << m_currentNode->m_ContentSize <<
-									" byte(s) content - Changing status to FillingIdentifier...\n";
-						}
-						m_readerCB.processChildData(tmpBuffer, m_currentNode->m_ContentSize);
-					}
-					else
-					{
-						if (m_currentNode->m_ContentSize - m_currentNode->m_ReadContentSize > currentSize)
-						{
-							memcpy(m_currentNode->m_Buffer + m_currentNode->m_ReadContentSize, tmpBuffer, size_t(currentSize));
-							processedBytes = currentSize;
-							finished       = true;
-						}
-						else
-						{
-							memcpy(m_currentNode->m_Buffer + m_currentNode->m_ReadContentSize, tmpBuffer,
-								   size_t(m_currentNode->m_ContentSize - m_currentNode->m_ReadContentSize));
-							processedBytes = m_currentNode->m_ContentSize - m_currentNode->m_ReadContentSize;
-
-							m_status = FillingIdentifier;
-							if (_Debug_)
-							{
-								std::cout << "Finished with " << m_currentNode->m_ContentSize << " byte(s) content - Changing status to FillingIdentifier...\n";
-							}
-							m_readerCB.processChildData(m_currentNode->m_Buffer, m_currentNode->m_ContentSize);
-						}
-					}
-				}
+				if (m_content.size() < node.contentSize) { m_content.resize(node.contentSize); }
+				const size_t n = std::min(available, node.contentSize - m_nContent);
+				memcpy(m_content.data() + m_nContent, data, n);
+				data += n;
+				m_position += n;
+				m_nContent += n;
+				if (m_nContent < node.contentSize) { return true; }
+
+				m_nContent = 0;
+				m_readerCB.processChildData(m_content.data(), node.contentSize);
 			}
-			break;
-		}
-
-		// Updates buffer pointer and size
-		const size_t processedBytesInBuffer = processedBytes - processedPendingBytes;
-		tmpBuffer += processedBytesInBuffer;
-		currentSize -= processedBytesInBuffer;
-		m_nPending -= processedPendingBytes;
-
-		// Updates read size
-		CReaderNode* node = m_currentNode;
-		while (node)
-		{
-			node->m_ReadContentSize += processedBytes;
-			node = node->m_ParentNode;
-		}
 
-		// Creates new node when needed
-		if (m_status != FillingContentSize && m_lastStatus == FillingContentSize)
-		{
-			m_currentNode                = new CReaderNode(m_currentID, m_currentNode);
-			m_currentNode->m_ContentSize = m_currentContentSize;
-			m_currentNode->m_Buffer      = new unsigned char[m_currentContentSize];
-			m_readerCB.openChild(m_currentNode->m_Id);
+			m_status = FillingIdentifier;
+			closeFinishedNodes();
 		}
 		else
 		{
-			// Closes finished nodes
-			while (m_currentNode && (m_currentNode->m_ContentSize == m_currentNode->m_ReadContentSize || m_currentNode->m_ContentSize == 0))
+			uint64_t value = 0;
+			if (!readCodedValue(data, end, value)) { return true; }
+
+			if (m_status == FillingIdentifier)
 			{
-				m_readerCB.closeChild();
-				CReaderNode* parent = m_currentNode->m_ParentNode;
-				delete [] m_currentNode->m_Buffer;
-				delete m_currentNode;
-				m_currentNode = parent;
+				m_currentID = value;
+				m_status    = FillingContentSize;
 			}
-		}
-	}
+			else
+			{
+				const bool isMaster = m_readerCB.isMasterChild(m_currentID);
 
-	// Updates pending data
-	if (m_nPending + currentSize > m_pendingSize)
-	{
-		unsigned char* pending = new unsigned char[m_nPending + currentSize + 1
-		]; // Ugly hack, reserve 1 more byte on pending data so we are sure we can insert this additional pending byte when only one byte is pending and two bytes are needed for decoding identifier and/or buffer size
-		memcpy(pending, m_pending, m_nPending);
-		delete [] m_pending;
-		m_pending     = pending;
-		m_pendingSize = m_nPending + currentSize;
-	}
-	memcpy(m_pending + m_nPending, tmpBuffer, currentSize);
-	m_nPending += currentSize;
+				node_t node;
+				node.id          = m_currentID;
+				node.contentSize = size_t(value);
+				node.end         = m_position + node.contentSize;
+				m_nodes.push_back(node);
+				m_readerCB.openChild(node.id);
 
-	if (_Debug_) { std::cout << "\n"; }
-	return true;
+				if (isMaster)
+				{
+					m_status = FillingIdentifier;
+					closeFinishedNodes();	// Empty master node
+				}
+				else { m_status = FillingContent; }
+			}
+		}
+	}
 }
 
-CIdentifier CReader::getCurrentNodeID() const { return m_currentNode ? m_currentNode->m_Id : CIdentifier(); }
-size_t CReader::getCurrentNodeSize() const { return m_currentNode ? m_currentNode->m_ContentSize : 0; }
+CIdentifier CReader::getCurrentNodeID() const { return m_nodes.empty() ? CIdentifier() : m_nodes.back().id; }
+size_t CReader::getCurrentNodeSize() const { return m_nodes.empty() ? 0 : m_nodes.back().contentSize; }
 
 void CReader::release() { delete this; }
 
@@ -1,5 +1,6 @@
 #include "ebml/IWriter.h"
 
+#include <algorithm>
 #include <vector>
 #include <cstring>
 
@@ -17,12 +18,8 @@ inline size_t getCodedSizeLength(const uint64_t value)
 	return 10;
 }
 
-inline bool getCodedBuffer(const uint64_t value, unsigned char* buffer, size_t* size)
+inline void setCodedBuffer(const uint64_t value, unsigned char* buffer, const size_t length)
 {
-	const size_t length = getCodedSizeLength(value);
-
-	if (length > *size) { return false; }
-
 	size_t bit = length;
 	for (size_t i = 0; i < length; ++i)
 	{
@@ -33,9 +30,6 @@ inline bool getCodedBuffer(const uint64_t value, unsigned char* buffer, size_t*
 
 		buffer[i] = static_cast<unsigned char>(byte);
 	}
-
-	*size = length;
-	return true;
 }
 
 // ________________________________________________________________________________________________________________
@@ -43,172 +37,181 @@ inline bool getCodedBuffer(const uint64_t value, unsigned char* buffer, size_t*
 
 namespace EBML {
 namespace {
-class CWriterNode final
+// Size field reserved for master nodes, their content size is only known once closed
+constexpr size_t MASTER_SIZE_LENGTH = 8;
+
+class CWriter final : public IWriter
 {
 public:
 
-	CWriterNode(const CIdentifier& identifier, CWriterNode* parentNode) : m_ID(identifier), m_ParentNode(parentNode) {}
-	~CWriterNode();
-	void process(IWriterCallback& callback);
+	CWriter(IWriterCallback& callback, const bool compactSizes) : m_callback(callback), m_compactSizes(compactSizes) {}
+	bool openChild(const CIdentifier& identifier) override;
+	bool setChildData(const void* buffer, const size_t size) override;
+	bool closeChild() override;
+	void release() override;
 
 protected:
 
-	size_t getTotalContentSize(bool identifierAndSize);
+	enum class ENodeType { Unknown, Master, Data };
 
-private:
+	typedef struct SNode
+	{
+		CIdentifier id;
+		ENodeType type = ENodeType::Unknown;
+		size_t offset  = 0;	// Of the node in the arena
+		size_t master  = 0;	// Index in m_masters, for master nodes
+		size_t slack   = 0;	// Bytes removed from the content once master sizes are compacted
+	} node_t;
+
+	typedef struct SMaster
+	{
+		size_t sizeOffset  = 0;
+		size_t contentSize = 0;
+	} master_t;
 
-	CWriterNode() = delete;
+	unsigned char* reserve(size_t size);
+	void beginMaster(node_t& node);
+	void writeData(node_t& node, const void* buffer, size_t size);
+	void flush();
 
-public:
+	IWriterCallback& m_callback;
+	const bool m_compactSizes;
 
-	CIdentifier m_ID;
-	CWriterNode* m_ParentNode = nullptr;
-	size_t m_BufferLength     = 0;
-	unsigned char* m_Buffer   = nullptr;
-	bool m_Buffered           = false;
-	std::vector<CWriterNode*> m_Childrens;
+	// The top level node being written is serialized in place in the arena, kept from one top level node to the next
+	std::vector<node_t> m_nodes;		// Opened nodes, the current one last
+	std::vector<master_t> m_masters;	// In stream order
+	std::vector<unsigned char> m_arena;
+	size_t m_size = 0;
+
+private:
+	CWriter() = delete;
 };
 }  // namespace
 
 // ________________________________________________________________________________________________________________
 //
 
-CWriterNode::~CWriterNode()
+unsigned char* CWriter::reserve(const size_t size)
 {
-	for (auto i = m_Childrens.begin(); i != m_Childrens.end(); ++i) { delete (*i); }
-
-	if (m_Buffer)
-	{
-		delete [] m_Buffer;
-		m_Buffer = nullptr;
-	}
+	if (m_size + size > m_arena.size()) { m_arena.resize(std::max(m_size + size, 2 * m_arena.size())); }
+	unsigned char* res = m_arena.data() + m_size;
+	m_size += size;
+	return res;
 }
 
-void CWriterNode::process(IWriterCallback& callback)
+void CWriter::beginMaster(node_t& node)
 {
-	unsigned char id[10];
-	unsigned char pContentSize[10];
-	size_t contentSizeLength = sizeof(pContentSize);
-	size_t identifierLength  = sizeof(id);
-	const size_t contentSize = getTotalContentSize(false);
-
-	if (!getCodedBuffer(contentSize, pContentSize, &contentSizeLength)) { }	// SHOULD NEVER HAPPEN
-	if (!getCodedBuffer(m_ID, id, &identifierLength)) { }	// SHOULD NEVER HAPPEN
-
-	callback.write(id, identifierLength);
-	callback.write(pContentSize, contentSizeLength);
-
-	if (m_Childrens.empty()) { callback.write(m_Buffer, m_BufferLength); }
-	else { for (auto i = m_Childrens.begin(); i != m_Childrens.end(); ++i) { (*i)->process(callback); } }
+	const size_t idLength = getCodedSizeLength(node.id);
+	setCodedBuffer(node.id, reserve(idLength + MASTER_SIZE_LENGTH), idLength);
+
+	master_t master;
+	master.sizeOffset = node.offset + idLength;
+	node.type         = ENodeType::Master;
+	node.master       = m_masters.size();
+	m_masters.push_back(master);
 }
 
-size_t CWriterNode::getTotalContentSize(const bool identifierAndSize)
+void CWriter::writeData(node_t& node, const void* buffer, const size_t size)
 {
-	size_t contentSize = 0;
-	if (m_Childrens.empty()) { contentSize = m_BufferLength; }
-	else { for (auto i = m_Childrens.begin(); i != m_Childrens.end(); ++i) { contentSize += (*i)->getTotalContentSize(true); } }
+	const size_t idLength   = getCodedSizeLength(node.id);
+	const size_t sizeLength = getCodedSizeLength(size);
+	unsigned char* data     = reserve(idLength + sizeLength + size);
+	setCodedBuffer(node.id, data, idLength);
+	setCodedBuffer(size, data + idLength, sizeLength);
+	if (size) { memcpy(data + idLength + sizeLength, buffer, size); }
+	node.type = ENodeType::Data;
+}
 
-	size_t res = contentSize;
-	if (identifierAndSize)
+void CWriter::flush()
+{
+	size_t size = m_size;
+	if (m_compactSizes && !m_masters.empty())
 	{
-		res += getCodedSizeLength(m_ID);
-		res += getCodedSizeLength(contentSize);
+		// Codes each master size on its actual length and moves what follows back over the unused bytes, in a single pass
+		unsigned char* data = m_arena.data();
+		size                = m_masters[0].sizeOffset;
+		for (size_t i = 0; i < m_masters.size(); ++i)
+		{
+			const size_t length = getCodedSizeLength(m_masters[i].contentSize);
+			setCodedBuffer(m_masters[i].contentSize, data + size, length);
+			size += length;
+
+			const size_t begin = m_masters[i].sizeOffset + MASTER_SIZE_LENGTH;
+			const size_t end   = (i + 1 < m_masters.size() ? m_masters[i + 1].sizeOffset : m_size);
+			if (size != begin) { memmove(data + size, data + begin, end - begin); }
+			size += end - begin;
+		}
 	}
 
-	return res;
+	m_callback.write(m_arena.data(), size);
+	m_size = 0;
+	m_masters.clear();
 }
 
 // ________________________________________________________________________________________________________________
 //
 
-namespace {
-class CWriter final : public IWriter
-{
-public:
-
-	explicit CWriter(IWriterCallback& callback) : m_callback(callback) {}
-	bool openChild(const CIdentifier& identifier) override;
-	bool setChildData(const void* buffer, const size_t size) override;
-	bool closeChild() override;
-	void release() override;
-
-protected:
-
-	CWriterNode* m_node = nullptr;
-	IWriterCallback& m_callback;
-
-private:
-	CWriter() = delete;
-};
-}  // namespace
-
-// ________________________________________________________________________________________________________________
-//
-
 bool CWriter::openChild(const CIdentifier& identifier)
 {
-	if (m_node) { if (m_node->m_Buffered) { return false; } }
+	if (!m_nodes.empty())
+	{
+		node_t& parent = m_nodes.back();
+		if (parent.type == ENodeType::Data) { return false; }
+		if (parent.type == ENodeType::Unknown) { beginMaster(parent); }
+	}
 
-	CWriterNode* pResult = new CWriterNode(identifier, m_node);
-	if (m_node) { m_node->m_Childrens.push_back(pResult); }
-	m_node = pResult;
+	node_t node;
+	node.id     = identifier;
+	node.offset = m_size;
+	m_nodes.push_back(node);
 	return true;
 }
 
 bool CWriter::setChildData(const void* buffer, const size_t size)
 {
-	if (!m_node) { return false; }
-
-	if (!m_node->m_Childrens.empty()) { return false; }
+	if (m_nodes.empty()) { return false; }
 
-	unsigned char* bufferCopy = nullptr;
-	if (size)
-	{
-		if (!buffer) { return false; }
-		bufferCopy = new unsigned char[size];
-		if (!bufferCopy) { return false; }
-		memcpy(bufferCopy, buffer, size);
-	}
+	node_t& node = m_nodes.back();
+	if (node.type == ENodeType::Master) { return false; }
+	if (size && !buffer) { return false; }
 
-	delete [] m_node->m_Buffer;
-
-	m_node->m_BufferLength = size;
-	m_node->m_Buffer       = bufferCopy;
-	m_node->m_Buffered     = true;
+	// Data set again replaces the previous one, which is the end of the arena
+	m_size = node.offset;
+	writeData(node, buffer, size);
 	return true;
 }
 
 bool CWriter::closeChild()
 {
-	if (!m_node) { return false; }
+	if (m_nodes.empty()) { return false; }
 
-	if ((!m_node->m_Buffered) && (m_node->m_Childrens.empty()))
-	{
-		m_node->m_BufferLength = 0;
-		m_node->m_Buffer       = nullptr;
-		m_node->m_Buffered     = true;
-	}
+	node_t node = m_nodes.back();
+	m_nodes.pop_back();
 
-	CWriterNode* parent = m_node->m_ParentNode;
-	if (!parent)
+	if (node.type == ENodeType::Unknown) { writeData(node, nullptr, 0); }
+	else if (node.type == ENodeType::Master)
 	{
-		m_node->process(m_callback);
-		delete m_node;
+		master_t& master   = m_masters[node.master];
+		master.contentSize = m_size - (master.sizeOffset + MASTER_SIZE_LENGTH) - node.slack;
+		if (m_compactSizes) { node.slack += MASTER_SIZE_LENGTH - getCodedSizeLength(master.contentSize); }
+		else { setCodedBuffer(master.contentSize, m_arena.data() + master.sizeOffset, MASTER_SIZE_LENGTH); }
 	}
 
-	m_node = parent;
+	if (m_nodes.empty()) { flush(); }
+	else { m_nodes.back().slack += node.slack; }
 	return true;
 }
 
 void CWriter::release()
 {
-	while (m_node) { closeChild(); }
+	while (!m_nodes.empty()) { closeChild(); }
 	delete this;
 }
 
 // ________________________________________________________________________________________________________________
 //
 
-EBML_API IWriter* createWriter(IWriterCallback& callback) { return new CWriter(callback); }
+EBML_API IWriter* createWriter(IWriterCallback& callback) { return new CWriter(callback, true); }
+EBML_API IWriter* createInPlaceWriter(IWriterCallback& callback) { return new CWriter(callback, false); }
 
 }  // namespace EBML
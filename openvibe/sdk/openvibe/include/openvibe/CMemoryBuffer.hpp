@@ -49,6 +49,18 @@ public:
 	/// <param name="buffer">The buffer.</param>
 	CMemoryBuffer(const CMemoryBuffer& buffer) { copy(buffer); }
 
+	/// <summary> Initializes a new instance of the <see cref="CMemoryBuffer"/> . </summary>
+	///
+	/// This constructor takes the storage of the actual parameter of the constructor, which is left empty.
+	/// <param name="buffer"> The buffer. </param>
+	CMemoryBuffer(CMemoryBuffer&& buffer) noexcept
+		: m_buffer(buffer.m_buffer), m_size(buffer.m_size), m_allocatedSize(buffer.m_allocatedSize), m_pooled(buffer.m_pooled)
+	{
+		buffer.m_buffer        = nullptr;
+		buffer.m_size          = 0;
+		buffer.m_allocatedSize = 0;
+	}
+
 	/// <summary> Initializes a new instance of the <see cref="CMemoryBuffer"/> . </summary>
 	///
 	/// This constructor builds the internal implementation of this memory buffer and initializes it with the actual parameter of the constructor as a copy.
@@ -80,9 +92,17 @@ public:
 	/// <param name="discard"> Tells the reallocation process whether it should presever currently stored data or not. </param>
 	/// <returns> <c>true</c> in case of success, <c>false</c> otherwise. </returns>
 	///	<remarks> On error, the buffer is left unchanged.
-	///	If the new size if lower than the current sizeand \c discard is true, the buffer is simply truncated to the \c size first bytes. </remarks>
+	///	If the new size if lower than the current sizeand \c discard is true, the buffer is simply truncated to the \c size first bytes.
+	/// When the buffer has to grow, at least twice the previous allocated size is allocated so that repeated appends stay linear. </remarks>
 	bool setSize(const size_t size, const bool discard);
 
+	/// <summary> Sets whether the storage of this memory buffer is drawn from a pool. </summary>
+	///
+	/// Pooled storage is allocated by power of two size classes and, once released, kept by the releasing thread
+	/// for the next pooled buffer of the same size class, which suits buffers continuously created and destroyed such as chunks.
+	/// <param name="pooled"> <c>true</c> to use the pool for the storage allocated from now on. </param>
+	void setPooled(const bool pooled) { m_pooled = pooled; }
+
 	/// <summary> Gets the current size of this memory buffer. </summary>
 	/// <returns> The current size of this memory buffer. </returns>
 	size_t getSize() const { return m_size; }
@@ -121,6 +141,11 @@ public:
 		return *this;
 	}
 
+	/// <summary> Move Assignment Operator. </summary>
+	/// <param name="buffer"> The buffer to take the storage of, left empty. </param>
+	/// <returns> Himself. </returns>
+	CMemoryBuffer& operator=(CMemoryBuffer&& buffer) noexcept;
+
 	/// <summary> Overload of const operator []. </summary>
 	/// <param name="index"> The index. </param>
 	/// <returns> Const Reference of the object. </returns>
@@ -147,6 +172,7 @@ protected:
 	uint8_t* m_buffer      = nullptr;	///< Buffer
 	size_t m_size          = 0;			///< Size of Buffer
 	size_t m_allocatedSize = 0;			///< Size allocated of Buffer
+	bool m_pooled          = false;		///< Storage drawn from the pool
 };
 
 /// \deprecated Use the CMemoryBuffer class instead
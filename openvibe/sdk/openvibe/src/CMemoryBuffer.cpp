@@ -21,30 +21,96 @@
 ///-------------------------------------------------------------------------------------------------
 #include "CMemoryBuffer.hpp"
 
+#include <array>
 #include <cstring> // memcpy
+#include <vector>
 
 namespace OpenViBE {
 
+namespace {
+constexpr size_t MIN_POOLED_SIZE  = 64;	// Size of the smallest size class
+constexpr size_t N_SIZE_CLASS     = 20;	// Up to 32 MiB, larger storage is not pooled
+constexpr size_t MAX_POOLED_BLOCK = 16;	// Free blocks kept by size class and thread
+
+/// <summary> Free blocks released by the thread, by size class. </summary>
+class CBlockPool final
+{
+public:
+	~CBlockPool()
+	{
+		for (auto& blocks : m_Blocks) { for (uint8_t* block : blocks) { delete [] block; } }
+		destroyed = true;
+	}
+
+	std::array<std::vector<uint8_t*>, N_SIZE_CLASS> m_Blocks;
+	static thread_local bool destroyed;	// Buffers released after the thread pool are simply freed
+};
+
+thread_local bool CBlockPool::destroyed = false;
+thread_local CBlockPool pool;
+
+size_t getSizeClass(const size_t size)
+{
+	size_t sizeClass = 0;
+	while (sizeClass < N_SIZE_CLASS && (MIN_POOLED_SIZE << sizeClass) < size) { sizeClass++; }
+	return sizeClass;
+}
+
+/// <summary> Allocates at least <c>size</c> bytes, plus the terminal byte, and updates <c>size</c> to the allocated size. </summary>
+uint8_t* allocate(size_t& size, const bool pooled)
+{
+	if (pooled)
+	{
+		const size_t sizeClass = getSizeClass(size);
+		if (sizeClass < N_SIZE_CLASS)
+		{
+			size = MIN_POOLED_SIZE << sizeClass;
+			if (!CBlockPool::destroyed && !pool.m_Blocks[sizeClass].empty())
+			{
+				uint8_t* block = pool.m_Blocks[sizeClass].back();
+				pool.m_Blocks[sizeClass].pop_back();
+				return block;
+			}
+		}
+	}
+	return new uint8_t[size_t(size + 1)]; // $$$
+}
+
+void release(uint8_t* buffer, const size_t size, const bool pooled)
+{
+	if (!buffer) { return; }
+	if (pooled && !CBlockPool::destroyed)
+	{
+		const size_t sizeClass = getSizeClass(size);
+		if (sizeClass < N_SIZE_CLASS && (MIN_POOLED_SIZE << sizeClass) == size && pool.m_Blocks[sizeClass].size() < MAX_POOLED_BLOCK)
+		{
+			pool.m_Blocks[sizeClass].push_back(buffer);
+			return;
+		}
+	}
+	delete [] buffer;
+}
+}  // namespace
+
 ///-------------------------------------------------------------------------------------------------
 CMemoryBuffer::~CMemoryBuffer()
 {
-	if (m_buffer) {
-		delete [] m_buffer;
-		m_buffer = nullptr;
-	}
+	release(m_buffer, m_allocatedSize, m_pooled);
+	m_buffer = nullptr;
 }
 
 ///-------------------------------------------------------------------------------------------------
 bool CMemoryBuffer::reserve(const size_t size)
 {
 	if (size > m_allocatedSize) {
-		uint8_t* buffer = m_buffer;
-		m_buffer        = new uint8_t[size_t(size + 1)]; // $$$
-		if (!m_buffer) { return false; }
-		memcpy(m_buffer, buffer, size_t(m_size)); // $$$
+		size_t allocatedSize = size;
+		uint8_t* buffer      = allocate(allocatedSize, m_pooled);
+		if (!buffer) { return false; }
+		memcpy(buffer, m_buffer, size_t(m_size)); // $$$
 
-		delete [] buffer;
-		m_allocatedSize           = size;
+		release(m_buffer, m_allocatedSize, m_pooled);
+		m_buffer                  = buffer;
+		m_allocatedSize           = allocatedSize;
 		m_buffer[m_allocatedSize] = 0;
 	}
 	return true;
@@ -54,12 +120,14 @@ bool CMemoryBuffer::reserve(const size_t size)
 bool CMemoryBuffer::setSize(const size_t size, const bool discard)
 {
 	if (size > m_allocatedSize) {
-		uint8_t* buffer = m_buffer;
-		m_buffer        = new uint8_t[size_t(size + 1)]; // $$$
-		if (!m_buffer) { return false; }
-		if (!discard) { memcpy(m_buffer, buffer, size_t(m_size)); }	// $$$
-		delete [] buffer;
-		m_allocatedSize           = size;
+		size_t allocatedSize = (size > 2 * m_allocatedSize ? size : 2 * m_allocatedSize);
+		uint8_t* buffer      = allocate(allocatedSize, m_pooled);
+		if (!buffer) { return false; }
+		if (!discard) { memcpy(buffer, m_buffer, size_t(m_size)); }	// $$$
+
+		release(m_buffer, m_allocatedSize, m_pooled);
+		m_buffer                  = buffer;
+		m_allocatedSize           = allocatedSize;
 		m_buffer[m_allocatedSize] = 0;
 	}
 	m_size = size;
@@ -77,17 +145,28 @@ bool CMemoryBuffer::append(const uint8_t* buffer, const size_t size)
 	return true;
 }
 
+///-------------------------------------------------------------------------------------------------
+CMemoryBuffer& CMemoryBuffer::operator=(CMemoryBuffer&& buffer) noexcept
+{
+	if (this == &buffer) { return *this; }
+	release(m_buffer, m_allocatedSize, m_pooled);
+	m_buffer               = buffer.m_buffer;
+	m_size                 = buffer.m_size;
+	m_allocatedSize        = buffer.m_allocatedSize;
+	m_pooled               = buffer.m_pooled;
+	buffer.m_buffer        = nullptr;
+	buffer.m_size          = 0;
+	buffer.m_allocatedSize = 0;
+	return *this;
+}
+
 ///-------------------------------------------------------------------------------------------------
 void CMemoryBuffer::copy(const uint8_t* buffer, const size_t size)
 {
-	m_buffer = new uint8_t[size_t(size + 1)]; // $$$
-	if (m_buffer) {
-		m_size          = size;
-		m_allocatedSize = size;
-		if (buffer) {
-			memcpy(m_buffer, buffer, size_t(m_size)); // $$$
-		}
-		m_buffer[m_allocatedSize] = 0;
+	// The storage is kept when large enough
+	if (!this->setSize(size, true)) { return; }
+	if (buffer && size) {
+		memcpy(m_buffer, buffer, size_t(m_size)); // $$$
 	}
 }
 
@@ -27,6 +27,7 @@
 #include <sstream>
 #include <map>
 #include <algorithm>
+#include <iterator>
 #include <regex>
 #include <utility>
 
@@ -207,7 +208,7 @@ bool CBoxAlgorithmOVCSVFileReader::processChunksAndStimulations()
 								(CSV::ICSVHandler::getLogError(m_readerLib->getLastLogError()) + (m_readerLib->getLastErrorString().empty()
 									? "" : ". Details: " + m_readerLib->getLastErrorString())).c_str(), Kernel::ErrorType::Internal);
 
-			m_savedChunks.insert(m_savedChunks.end(), matrixChunk.begin(), matrixChunk.end());
+			m_savedChunks.insert(m_savedChunks.end(), std::make_move_iterator(matrixChunk.begin()), std::make_move_iterator(matrixChunk.end()));
 			m_savedStims.insert(m_savedStims.end(), stimChunk.begin(), stimChunk.end());
 		} while (!m_savedChunks.empty() && m_savedChunks.back().startTime < currentTime && m_readerLib->hasDataToRead());
 	}
@@ -0,0 +1,93 @@
+#include "ovpCBlockCodec.h"
+#include "ovpEBMLNodes.h"
+#include "../../ovp_defines.h"
+
+#include <toolkit/ovtk_defines.h>
+
+#include <zlib.h>
+
+namespace OpenViBE {
+namespace Plugins {
+namespace FileIO {
+
+namespace {
+constexpr size_t WORD_SIZE = 8;
+
+// Byte i of word j goes to position i * nWord + j, the trailing bytes which do not fill a word are kept as is
+void shuffle(const uint8_t* src, const size_t size, uint8_t* dst)
+{
+	const size_t nWord = size / WORD_SIZE;
+	for (size_t j = 0; j < nWord; ++j) { for (size_t i = 0; i < WORD_SIZE; ++i) { dst[i * nWord + j] = src[j * WORD_SIZE + i]; } }
+	for (size_t k = nWord * WORD_SIZE; k < size; ++k) { dst[k] = src[k]; }
+}
+
+void unshuffle(const uint8_t* src, const size_t size, uint8_t* dst)
+{
+	const size_t nWord = size / WORD_SIZE;
+	for (size_t j = 0; j < nWord; ++j) { for (size_t i = 0; i < WORD_SIZE; ++i) { dst[j * WORD_SIZE + i] = src[i * nWord + j]; } }
+	for (size_t k = nWord * WORD_SIZE; k < size; ++k) { dst[k] = src[k]; }
+}
+}  // namespace
+
+void CBlockCodec::findRawBuffers(const uint8_t* buffer, const size_t size)
+{
+	// Only the headers of the nodes are read, so the raw buffers are found the same way whether they are shuffled or not
+	m_rawBuffers.clear();
+	auto find = [&](const EBML::CIdentifier& expectedId, const uint8_t* content, const size_t contentSize, auto next)
+	{
+		forEachNode(content, contentSize, [&](const EBML::CIdentifier& id, const uint8_t* child, const size_t childSize)
+		{
+			if (id == expectedId) { next(child, childSize); }
+			return true;
+		});
+	};
+
+	find(OVP_NodeId_OpenViBEStream_Buffer, buffer, size, [&](const uint8_t* node, const size_t nodeSize)
+	{
+		find(OVP_NodeId_OpenViBEStream_Buffer_Content, node, nodeSize, [&](const uint8_t* content, const size_t contentSize)
+		{
+			find(OVTK_NodeId_Buffer, content, contentSize, [&](const uint8_t* chunk, const size_t chunkSize)
+			{
+				find(OVTK_NodeId_Buffer_StreamedMatrix, chunk, chunkSize, [&](const uint8_t* matrix, const size_t matrixSize)
+				{
+					find(OVTK_NodeId_Buffer_StreamedMatrix_RawBuffer, matrix, matrixSize, [&](const uint8_t* raw, const size_t rawSize)
+					{
+						m_rawBuffers.emplace_back(size_t(raw - buffer), rawSize);
+					});
+				});
+			});
+		});
+	});
+}
+
+bool CBlockCodec::encode(const uint8_t* buffer, const size_t size, std::vector<uint8_t>& encoded)
+{
+	m_shuffled.assign(buffer, buffer + size);
+	findRawBuffers(buffer, size);
+	for (const auto& raw : m_rawBuffers) { shuffle(buffer + raw.first, raw.second, m_shuffled.data() + raw.first); }
+
+	uLongf encodedSize = compressBound(uLong(size));
+	encoded.resize(encodedSize);
+	if (compress2(encoded.data(), &encodedSize, m_shuffled.data(), uLong(size), Z_BEST_SPEED) != Z_OK) { return false; }
+	encoded.resize(encodedSize);
+	return true;
+}
+
+bool CBlockCodec::decode(const uint8_t* buffer, const size_t size, const size_t decodedSize, std::vector<uint8_t>& decoded)
+{
+	decoded.resize(decodedSize);
+	uLongf inflatedSize = uLongf(decodedSize);
+	if (uncompress(decoded.data(), &inflatedSize, buffer, uLong(size)) != Z_OK || inflatedSize != decodedSize) { return false; }
+
+	findRawBuffers(decoded.data(), decodedSize);
+	for (const auto& raw : m_rawBuffers)
+	{
+		m_shuffled.assign(decoded.begin() + raw.first, decoded.begin() + raw.first + raw.second);
+		unshuffle(m_shuffled.data(), raw.second, decoded.data() + raw.first);
+	}
+	return true;
+}
+
+}  // namespace FileIO
+}  // namespace Plugins
+}  // namespace OpenViBE
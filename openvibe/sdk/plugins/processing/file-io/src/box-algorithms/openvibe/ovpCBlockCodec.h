@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace OpenViBE {
+namespace Plugins {
+namespace FileIO {
+/// <summary> Compression of the blocks of chunks of .ov files. </summary>
+/// <remarks>
+/// The raw buffers of the matrix chunks of a block are first shuffled by the position of their bytes within their double
+/// precision samples, so that the bytes of same weight end up next to each other, then the block is deflated at the fastest level.
+/// The nodes around the raw buffers are kept as they are, they give the raw buffers back when the block is decompressed.
+/// The codec keeps its intermediate buffers from one block to the next, an instance must only be used by one thread at a time.
+/// </remarks>
+class CBlockCodec final
+{
+public:
+
+	/// <summary> Compresses a block, the result replaces the content of <c>encoded</c>. </summary>
+	bool encode(const uint8_t* buffer, size_t size, std::vector<uint8_t>& encoded);
+
+	/// <summary> Decompresses a block, the result replaces the content of <c>decoded</c>. </summary>
+	/// <param name="decodedSize"> Size of the block before compression, as stored along with it. </param>
+	/// <returns> <c>false</c> if the compressed data is corrupted or does not decompress to <c>decodedSize</c> bytes. </returns>
+	bool decode(const uint8_t* buffer, size_t size, size_t decodedSize, std::vector<uint8_t>& decoded);
+
+private:
+
+	/// <summary> Finds the raw buffers of the matrix chunks of a block, as offset and size pairs. </summary>
+	void findRawBuffers(const uint8_t* buffer, size_t size);
+
+	std::vector<uint8_t> m_shuffled;
+	std::vector<std::pair<size_t, size_t>> m_rawBuffers;
+};
+}  // namespace FileIO
+}  // namespace Plugins
+}  // namespace OpenViBE
@@ -1,44 +1,269 @@
 #include "ovpCBoxAlgorithmGenericStreamReader.h"
+#include "ovpEBMLNodes.h"
 
+#include <ebml/CWriter.h>
+
+#include <algorithm>
 #include <iostream>
 #include <limits>
-#include <fs/Files.h>
 
 namespace OpenViBE {
 namespace Plugins {
 namespace FileIO {
 
+namespace {
+// Longest header of a node: identifier and content size both coded on up to 10 bytes
+constexpr size_t MAX_NODE_HEADER_SIZE = 20;
+// Size of the content of the node ending indexed files, which holds the offset of the index
+constexpr size_t INDEX_OFFSET_SIZE = 8;
+// Minimal time between two entries of the index built for files without one, as in the generic stream writer
+constexpr uint64_t INDEX_PERIOD = 1LL << 32;
+// Larger decompressed blocks can only come from a corrupted file
+constexpr uint64_t MAX_BLOCK_SIZE = 1 << 30;
+
+/// <summary> Collects the bytes of the end node of a stream, the same for every stream type. </summary>
+class CEndChunkWriter final : public EBML::IWriterCallback
+{
+public:
+	explicit CEndChunkWriter(CMemoryBuffer& chunk) : m_chunk(chunk) { }
+	void write(const void* buffer, const size_t size) override { m_chunk.append(reinterpret_cast<const uint8_t*>(buffer), size); }
+
+private:
+	CMemoryBuffer& m_chunk;
+};
+
+/// <summary> Gets the compressed data and the decompressed size of a block from the content of its node. </summary>
+bool getBlockData(const uint8_t* buffer, const size_t size, const uint8_t*& data, size_t& dataSize, size_t& decodedSize)
+{
+	uint64_t blockSize = MAX_BLOCK_SIZE + 1;
+	data               = nullptr;
+	const bool valid   = forEachNode(buffer, size, [&](const EBML::CIdentifier& id, const uint8_t* content, const size_t contentSize)
+	{
+		if (id == OVP_NodeId_OpenViBEStream_Block_Size) { blockSize = getUInt(content, contentSize); }
+		if (id == OVP_NodeId_OpenViBEStream_Block_Data)
+		{
+			data     = content;
+			dataSize = contentSize;
+		}
+		return true;
+	});
+	decodedSize = size_t(blockSize);
+	return valid && data != nullptr && blockSize <= MAX_BLOCK_SIZE;
+}
+}  // namespace
+
 CBoxAlgorithmGenericStreamReader::CBoxAlgorithmGenericStreamReader() : m_reader(*this) {}
 uint64_t CBoxAlgorithmGenericStreamReader::getClockFrequency() { return 128LL << 32; } // the box clock frequency
 
 bool CBoxAlgorithmGenericStreamReader::initialize()
 {
+	const size_t nSetting = this->getStaticBoxContext().getSettingCount();
+
 	m_filename = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 0);
-	m_pending  = false;
+	// The time range settings were added after the first version of the box
+	m_readStartTime = nSetting > 1 ? CTime(double(FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 1))).time() : 0;
+	m_readEndTime   = nSetting > 2 ? CTime(double(FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 2))).time() : 0;
+	OV_ERROR_UNLESS_KRF(m_readEndTime == 0 || m_readEndTime > m_readStartTime, "End time must be after start time", Kernel::ErrorType::BadSetting);
+
+	m_pending     = false;
+	m_hasHeader   = false;
+	m_hasSentEnd  = false;
+	m_compression = OVP_OpenViBEStream_Compression_None;
 	m_streamIdxToOutputIdxs.clear();
 	m_streamIdxToTypeIDs.clear();
+	m_indexes.clear();
+	m_seeks.clear();
+	m_outputEndTimes.clear();
+	m_selector.setRange(m_readStartTime, m_readEndTime);
+
+	// Streams are closed with an empty end node once the end time is reached, as encoders do
+	m_endChunk.setSize(0, true);
+	CEndChunkWriter callback(m_endChunk);
+	EBML::CWriter writer(callback);
+	writer.openChild(OVTK_NodeId_End);
+	writer.closeChild();
 
 	return true;
 }
 
 bool CBoxAlgorithmGenericStreamReader::uninitialize()
 {
-	if (m_file)
+	clearBlocks();
+	m_file.close();
+	return true;
+}
+
+bool CBoxAlgorithmGenericStreamReader::initializeFile()
+{
+	OV_ERROR_UNLESS_KRF(m_file.open(m_filename.toASCIIString()), "Error opening file [" << m_filename << "] for reading", Kernel::ErrorType::BadFileRead);
+
+	if (m_readStartTime > 0 || m_readEndTime > 0)
 	{
-		fclose(m_file);
-		m_file = nullptr;
+		// Scanning the file is only worth it to skip its beginning, the end time is also reached without index
+		if (!loadIndex() && m_readStartTime > 0)
+		{
+			this->getLogManager() << Kernel::LogLevel_Trace << "No index in file " << m_filename << ", scanning it for the start time\n";
+			if (!buildIndex())
+			{
+				OV_WARNING_K("Could not scan file [" << m_filename << "], it is read from the beginning");
+				m_indexes.clear();
+			}
+		}
+		if (!m_indexes.empty())
+		{
+			uint64_t maxDuration = 0;
+			for (const auto& index : m_indexes) { maxDuration = std::max(maxDuration, index.second.maxDuration); }
+			m_selector.setMaxDuration(maxDuration);
+		}
+		if (m_readStartTime > 0) { planSeeks(); }
+		clearBlocks();
+		OV_ERROR_UNLESS_KRF(m_file.seek(0), "Error reading file [" << m_filename << "]", Kernel::ErrorType::BadFileRead);
 	}
 
 	return true;
 }
 
-bool CBoxAlgorithmGenericStreamReader::initializeFile()
+bool CBoxAlgorithmGenericStreamReader::loadIndex()
 {
-	m_file = FS::Files::open(m_filename.toASCIIString(), "rb");
+	// Indexed files end with a node holding the offset of the index node, which comes right before it
+	m_indexes.clear();
+	const uint64_t fileSize = m_file.getSize();
+	if (fileSize < INDEX_OFFSET_SIZE || !m_file.seek(fileSize - INDEX_OFFSET_SIZE)) { return false; }
+	if (m_file.request(INDEX_OFFSET_SIZE) < INDEX_OFFSET_SIZE) { return false; }
+	const uint64_t offset = getUInt(m_file.getData(), INDEX_OFFSET_SIZE);
+	if (offset >= fileSize || !m_file.seek(offset)) { return false; }
+
+	EBML::CIdentifier id;
+	size_t headerSize    = 0;
+	uint64_t contentSize = 0;
+	if (!readNodeHeader(m_file.getData(), m_file.request(MAX_NODE_HEADER_SIZE), id, headerSize, contentSize)) { return false; }
+	if (id != OVP_NodeId_OpenViBEStream_Index || contentSize > fileSize - offset) { return false; }
+
+	const size_t indexSize = headerSize + size_t(contentSize);
+	const size_t size      = m_file.request(size_t(fileSize - offset));
+	const uint8_t* data    = m_file.getData();
+	if (size < fileSize - offset) { return false; }
+
+	// The offset node must follow the index and end the file, or the last bytes of the file were not an offset
+	bool isEnd = false;
+	if (!forEachNode(data + indexSize, size - indexSize, [&](const EBML::CIdentifier& nodeId, const uint8_t* /*buffer*/, const size_t nodeSize)
+	{
+		isEnd = nodeId == OVP_NodeId_OpenViBEStream_IndexOffset && nodeSize == INDEX_OFFSET_SIZE;
+		return isEnd;
+	}) || !isEnd) { return false; }
 
-	OV_ERROR_UNLESS_KRF(m_file, "Error opening file [" << m_filename << "] for reading", Kernel::ErrorType::BadFileRead);
+	return forEachNode(data + headerSize, size_t(contentSize), [&](const EBML::CIdentifier& streamId, const uint8_t* streamBuffer, const size_t streamSize)
+	{
+		if (streamId != OVP_NodeId_OpenViBEStream_Index_Stream) { return true; }
 
-	return true;
+		size_t streamIdx = std::numeric_limits<size_t>::max();
+		stream_index_t index;
+		const bool valid = forEachNode(streamBuffer, streamSize, [&](const EBML::CIdentifier& nodeId, const uint8_t* buffer, const size_t nodeSize)
+		{
+			if (nodeId == OVP_NodeId_OpenViBEStream_Index_StreamIndex) { streamIdx = size_t(getUInt(buffer, nodeSize)); }
+			if (nodeId == OVP_NodeId_OpenViBEStream_Index_MaxDuration) { index.maxDuration = getUInt(buffer, nodeSize); }
+			if (nodeId == OVP_NodeId_OpenViBEStream_Index_Entries)
+			{
+				for (size_t i = 0; i + 16 <= nodeSize; i += 16) { index.entries.emplace_back(getUInt(buffer + i, 8), getUInt(buffer + i + 8, 8)); }
+			}
+			return true;
+		});
+		if (!valid || streamIdx == std::numeric_limits<size_t>::max()) { return false; }
+		m_indexes[streamIdx] = index;
+		return true;
+	});
+}
+
+bool CBoxAlgorithmGenericStreamReader::buildIndex()
+{
+	// Only the times of the chunks are read, their content is skipped without being decoded
+	m_indexes.clear();
+	if (!m_file.seek(0)) { return false; }
+
+	uint64_t offset   = 0;
+	auto indexBuffer = [&](const uint8_t* content, const size_t contentSize)
+	{
+		size_t streamIdx   = std::numeric_limits<size_t>::max();
+		uint64_t startTime = std::numeric_limits<uint64_t>::max();
+		uint64_t endTime   = std::numeric_limits<uint64_t>::max();
+		forEachNode(content, contentSize, [&](const EBML::CIdentifier& nodeId, const uint8_t* buffer, const size_t nodeSize)
+		{
+			if (nodeId == OVP_NodeId_OpenViBEStream_Buffer_StreamIndex) { streamIdx = size_t(getUInt(buffer, nodeSize)); }
+			if (nodeId == OVP_NodeId_OpenViBEStream_Buffer_StartTime) { startTime = getUInt(buffer, nodeSize); }
+			if (nodeId == OVP_NodeId_OpenViBEStream_Buffer_EndTime) { endTime = getUInt(buffer, nodeSize); }
+			return true;
+		});
+
+		if (streamIdx != std::numeric_limits<size_t>::max() && startTime != std::numeric_limits<uint64_t>::max() && endTime >= startTime)
+		{
+			stream_index_t& index = m_indexes[streamIdx];
+			if (startTime >= index.nextTime)
+			{
+				index.entries.emplace_back(startTime, offset);
+				index.nextTime = startTime + INDEX_PERIOD;
+			}
+			index.maxDuration = std::max(index.maxDuration, endTime - startTime);
+		}
+	};
+
+	while (!m_file.isEnd())
+	{
+		offset                 = m_file.getPosition();
+		const size_t available = m_file.request(MAX_NODE_HEADER_SIZE);
+		EBML::CIdentifier id;
+		size_t headerSize    = 0;
+		uint64_t contentSize = 0;
+		if (!readNodeHeader(m_file.getData(), available, id, headerSize, contentSize)) { return false; }
+
+		const size_t size = headerSize + size_t(contentSize);
+		if (m_file.request(size) < size) { return false; }
+
+		if (id == OVP_NodeId_OpenViBEStream_Buffer) { indexBuffer(m_file.getData() + headerSize, size_t(contentSize)); }
+		if (id == OVP_NodeId_OpenViBEStream_Block)
+		{
+			// The buffer nodes of a block are found from its start
+			const uint8_t* data = nullptr;
+			size_t dataSize     = 0;
+			size_t decodedSize  = 0;
+			if (!getBlockData(m_file.getData() + headerSize, size_t(contentSize), data, dataSize, decodedSize)) { return false; }
+			if (!m_codec.decode(data, dataSize, decodedSize, m_block)) { return false; }
+			forEachNode(m_block.data(), m_block.size(), [&](const EBML::CIdentifier& nodeId, const uint8_t* buffer, const size_t nodeSize)
+			{
+				if (nodeId == OVP_NodeId_OpenViBEStream_Buffer) { indexBuffer(buffer, nodeSize); }
+				return true;
+			});
+		}
+		m_file.skip(size);
+	}
+
+	return !m_file.hasFailed();
+}
+
+void CBoxAlgorithmGenericStreamReader::planSeeks()
+{
+	// The first chunk of each stream is read, then the file is read on from the first chunk that can overlap the start time
+	m_seeks.clear();
+	std::vector<uint64_t> headers;
+	uint64_t offset = std::numeric_limits<uint64_t>::max();
+	for (const auto& index : m_indexes)
+	{
+		const auto& entries = index.second.entries;
+		if (entries.empty()) { continue; }
+
+		const uint64_t time = m_readStartTime > index.second.maxDuration ? m_readStartTime - index.second.maxDuration : 0;
+		auto it             = std::upper_bound(entries.begin(), entries.end(), time,
+											   [](const uint64_t t, const std::pair<uint64_t, uint64_t>& entry) { return t < entry.first; });
+		if (it != entries.begin()) { --it; }
+
+		headers.push_back(entries.front().second);
+		offset = std::min(offset, it->second);
+	}
+	if (headers.empty()) { return; }
+
+	std::sort(headers.begin(), headers.end());
+	headers.erase(std::unique(headers.begin(), headers.end()), headers.end());
+	for (const uint64_t header : headers) { if (header < offset) { m_seeks.push_back(header); } }
+	m_seeks.push_back(offset);
 }
 
 bool CBoxAlgorithmGenericStreamReader::processClock(Kernel::CMessageClock& /*msg*/)
@@ -50,13 +275,13 @@ bool CBoxAlgorithmGenericStreamReader::processClock(Kernel::CMessageClock& /*msg
 
 bool CBoxAlgorithmGenericStreamReader::process()
 {
-	if (m_file == nullptr) { if (!initializeFile()) { return false; } }
+	if (!m_file.isOpen()) { if (!initializeFile()) { return false; } }
 	Kernel::IBoxIO& boxContext = this->getDynamicBoxContext();
 	const size_t nInput        = this->getStaticBoxContext().getOutputCount();
 	const uint64_t time        = this->getPlayerContext().getCurrentTime();
 	bool finished              = false;
 
-	while (!finished && (!feof(m_file) || m_pending))
+	while (!finished && (m_pending || (!m_selector.hasEnded() && (m_blockPosition < m_block.size() || !m_file.isEnd()))))
 	{
 		if (m_pending)
 		{
@@ -68,43 +293,144 @@ bool CBoxAlgorithmGenericStreamReader::process()
 
 				boxContext.getOutputChunk(m_outputIdx)->append(m_pendingChunk);
 				boxContext.markOutputAsReadyToSend(m_outputIdx, m_startTime, m_endTime);
-				m_pending = false;
+				m_outputEndTimes[m_outputIdx] = m_endTime;
+				m_pending                     = false;
 			}
 			else { finished = true; }
 		}
+		else if (m_blockPosition < m_block.size())
+		{
+			// The buffer nodes of a decompressed block are handed one at a time to the EBML reader, as the other nodes
+			const size_t available = m_block.size() - m_blockPosition;
+			size_t size            = 0;
+			OV_ERROR_UNLESS_KRF(getNodeSize(m_block.data() + m_blockPosition, available, size) && size <= available,
+								"Corrupted compressed block in " << m_filename, Kernel::ErrorType::BadParsing);
+
+			resetPendingChunk();
+			m_reader.processData(m_block.data() + m_blockPosition, size);
+			m_blockPosition += size;
+		}
 		else
 		{
-			bool justStarted = true;
-			while (!feof(m_file) && m_reader.getCurrentNodeID() == EBML::CIdentifier())
+			if (m_hasHeader && !m_seeks.empty())
 			{
-				uint8_t byte;
-				const size_t s = fread(&byte, sizeof(uint8_t), 1, m_file);
-
-				OV_ERROR_UNLESS_KRF(s == 1 || justStarted, "Unexpected EOF in " << m_filename, Kernel::ErrorType::BadParsing);
+				OV_ERROR_UNLESS_KRF(m_file.seek(m_seeks.front()), "Error reading file [" << m_filename << "]", Kernel::ErrorType::BadFileRead);
+				m_seeks.pop_front();
+			}
 
-				m_reader.processData(&byte, sizeof(byte));
-				justStarted = false;
+			// Each top level node is handed whole to the EBML reader, straight from the read ahead data
+			const uint64_t offset  = m_file.getPosition();
+			const size_t available = m_file.request(MAX_NODE_HEADER_SIZE);
+			EBML::CIdentifier id;
+			size_t headerSize    = 0;
+			uint64_t contentSize = 0;
+			OV_ERROR_UNLESS_KRF(readNodeHeader(m_file.getData(), available, id, headerSize, contentSize),
+								"Unexpected EOF in " << m_filename, Kernel::ErrorType::BadParsing);
+			const size_t size = headerSize + size_t(contentSize);
+			OV_ERROR_UNLESS_KRF(m_file.request(size) >= size, "Unexpected EOF in " << m_filename, Kernel::ErrorType::BadParsing);
+
+			if (id == OVP_NodeId_OpenViBEStream_Block)
+			{
+				OV_ERROR_UNLESS_KRF(m_compression == OVP_OpenViBEStream_Compression_ShuffleDeflate,
+									"Compressed block in " << m_filename << " which does not declare block compression", Kernel::ErrorType::BadParsing);
+				OV_ERROR_UNLESS_KRF(readBlock(offset, m_file.getData() + headerSize, size_t(contentSize)),
+									"Corrupted compressed block in " << m_filename, Kernel::ErrorType::BadParsing);
+				m_file.skip(size);
+				prefetchBlock();
 			}
-			if (!feof(m_file) && m_reader.getCurrentNodeSize() != 0)
+			else
 			{
-				m_swap.setSize(m_reader.getCurrentNodeSize(), true);
-				const size_t s = size_t(fread(m_swap.getDirectPointer(), sizeof(uint8_t), size_t(m_swap.getSize()), m_file));
-
-				OV_ERROR_UNLESS_KRF(s == m_swap.getSize(), "Unexpected EOF in " << m_filename, Kernel::ErrorType::BadParsing);
+				resetPendingChunk();
+				m_reader.processData(m_file.getData(), size);
+				m_file.skip(size);
+			}
+		}
+	}
 
-				m_pendingChunk.setSize(0, true);
-				m_startTime = std::numeric_limits<uint64_t>::max();
-				m_endTime   = std::numeric_limits<uint64_t>::max();
-				m_outputIdx = std::numeric_limits<size_t>::max();
+	OV_ERROR_UNLESS_KRF(!m_file.hasFailed(), "Error reading file [" << m_filename << "]", Kernel::ErrorType::BadFileRead);
 
-				m_reader.processData(m_swap.getDirectPointer(), m_swap.getSize());
-			}
+	// The chunks past the end time are not read, the end nodes they hold are replaced once the end time is reached or the whole file is read
+	const bool hasEnded = m_selector.hasEnded() || (m_readEndTime != 0 && m_blockPosition >= m_block.size() && m_file.isEnd());
+	if (hasEnded && !m_pending && !m_hasSentEnd)
+	{
+		// Each output fed by a stream of the file ends right after its last chunk
+		std::set<size_t> outputIdxs;
+		for (const auto& stream : m_streamIdxToOutputIdxs) { if (stream.second < nInput) { outputIdxs.insert(stream.second); } }
+		for (const size_t outputIdx : outputIdxs)
+		{
+			const uint64_t endTime = m_outputEndTimes[outputIdx];
+			boxContext.getOutputChunk(outputIdx)->append(m_endChunk);
+			boxContext.markOutputAsReadyToSend(outputIdx, endTime, endTime);
 		}
+		m_hasSentEnd = true;
 	}
 
 	return true;
 }
 
+bool CBoxAlgorithmGenericStreamReader::readBlock(const uint64_t offset, const uint8_t* buffer, const size_t size)
+{
+	m_blockPosition = 0;
+	if (m_nextBlockDecoded.valid())
+	{
+		const bool decoded = m_nextBlockDecoded.get();
+		if (m_nextBlockOffset == offset)
+		{
+			std::swap(m_block, m_nextBlock);
+			return decoded;
+		}
+	}
+
+	// The file was read from another position than the end of the previous block
+	const uint8_t* data = nullptr;
+	size_t dataSize     = 0;
+	size_t decodedSize  = 0;
+	return getBlockData(buffer, size, data, dataSize, decodedSize) && m_codec.decode(data, dataSize, decodedSize, m_block);
+}
+
+void CBoxAlgorithmGenericStreamReader::prefetchBlock()
+{
+	// The compressed data is copied as the read ahead window moves on before the worker is done
+	const uint64_t offset  = m_file.getPosition();
+	const size_t available = m_file.request(MAX_NODE_HEADER_SIZE);
+	EBML::CIdentifier id;
+	size_t headerSize    = 0;
+	uint64_t contentSize = 0;
+	if (!readNodeHeader(m_file.getData(), available, id, headerSize, contentSize) || id != OVP_NodeId_OpenViBEStream_Block) { return; }
+	const size_t size = headerSize + size_t(contentSize);
+	if (m_file.request(size) < size) { return; }
+
+	const uint8_t* data = nullptr;
+	size_t dataSize     = 0;
+	size_t decodedSize  = 0;
+	if (!getBlockData(m_file.getData() + headerSize, size_t(contentSize), data, dataSize, decodedSize)) { return; }
+
+	m_nextEncodedBlock.assign(data, data + dataSize);
+	m_nextBlockOffset  = offset;
+	m_nextBlockDecoded = std::async(std::launch::async, [this, decodedSize]()
+	{
+		return m_nextCodec.decode(m_nextEncodedBlock.data(), m_nextEncodedBlock.size(), decodedSize, m_nextBlock);
+	});
+}
+
+void CBoxAlgorithmGenericStreamReader::clearBlocks()
+{
+	if (m_nextBlockDecoded.valid()) { m_nextBlockDecoded.wait(); }
+	m_nextBlockDecoded = std::future<bool>();
+	m_block.clear();
+	m_blockPosition = 0;
+}
+
+void CBoxAlgorithmGenericStreamReader::resetPendingChunk()
+{
+	m_pendingChunk.setSize(0, true);
+	m_startTime = std::numeric_limits<uint64_t>::max();
+	m_endTime   = std::numeric_limits<uint64_t>::max();
+	m_outputIdx = std::numeric_limits<size_t>::max();
+	m_streamIdx = std::numeric_limits<size_t>::max();
+	m_selected  = false;
+}
+
 bool CBoxAlgorithmGenericStreamReader::isMasterChild(const EBML::CIdentifier& identifier)
 {
 	if (identifier == EBML_Identifier_Header) { return true; }
@@ -116,6 +442,8 @@ bool CBoxAlgorithmGenericStreamReader::isMasterChild(const EBML::CIdentifier& id
 	if (identifier == OVP_NodeId_OpenViBEStream_Buffer_StartTime) { return false; }
 	if (identifier == OVP_NodeId_OpenViBEStream_Buffer_EndTime) { return false; }
 	if (identifier == OVP_NodeId_OpenViBEStream_Buffer_Content) { return false; }
+	if (identifier == OVP_NodeId_OpenViBEStream_Block) { return false; }
+	if (identifier == OVP_NodeId_OpenViBEStream_Index) { return false; }
 	return false;
 }
 
@@ -149,21 +477,27 @@ void CBoxAlgorithmGenericStreamReader::processChildData(const void* buffer, cons
 
 	if (top == OVP_NodeId_OpenViBEStream_Header_Compression)
 	{
-		if (m_readerHelper.getUInt(buffer, size) != 0) { OV_WARNING_K("Impossible to use compression as it is not yet implemented"); }
+		m_compression = m_readerHelper.getUInt(buffer, size);
+		if (m_compression != OVP_OpenViBEStream_Compression_None && m_compression != OVP_OpenViBEStream_Compression_ShuffleDeflate)
+		{
+			OV_WARNING_K("Unknown compression mode " << m_compression << " in file " << m_filename);
+		}
 	}
 	if (top == OVP_NodeId_OpenViBEStream_Header_StreamType) { m_streamIdxToTypeIDs[m_streamIdxToTypeIDs.size()] = m_readerHelper.getUInt(buffer, size); }
 
 	if (top == OVP_NodeId_OpenViBEStream_Buffer_StreamIndex)
 	{
-		const size_t streamIdx = size_t(m_readerHelper.getUInt(buffer, size));
-		if (m_streamIdxToTypeIDs.find(streamIdx) != m_streamIdxToTypeIDs.end()) { m_outputIdx = m_streamIdxToOutputIdxs[streamIdx]; }
+		m_streamIdx = size_t(m_readerHelper.getUInt(buffer, size));
+		if (m_streamIdxToTypeIDs.find(m_streamIdx) != m_streamIdxToTypeIDs.end()) { m_outputIdx = m_streamIdxToOutputIdxs[m_streamIdx]; }
 	}
 	if (top == OVP_NodeId_OpenViBEStream_Buffer_StartTime) { m_startTime = m_readerHelper.getUInt(buffer, size); }
 	if (top == OVP_NodeId_OpenViBEStream_Buffer_EndTime) { m_endTime = m_readerHelper.getUInt(buffer, size); }
 	if (top == OVP_NodeId_OpenViBEStream_Buffer_Content)
 	{
+		// Chunks out of the time range are skipped without being copied
+		m_selected = m_selector.select(m_streamIdx, m_startTime, m_endTime);
 		m_pendingChunk.setSize(0, true);
-		m_pendingChunk.append(reinterpret_cast<const uint8_t*>(buffer), size);
+		if (m_selected) { m_pendingChunk.append(reinterpret_cast<const uint8_t*>(buffer), size); }
 	}
 }
 
@@ -173,6 +507,7 @@ void CBoxAlgorithmGenericStreamReader::closeChild()
 
 	if (top == OVP_NodeId_OpenViBEStream_Header)
 	{
+		m_selector.reset(m_streamIdxToTypeIDs.size());
 		const Kernel::IBox& boxContext = this->getStaticBoxContext();
 
 		std::map<size_t, size_t> outputIndexToStreamIdx;
@@ -251,11 +586,12 @@ void CBoxAlgorithmGenericStreamReader::closeChild()
 		// When both outputs and streams were lost, there most probably was a damn mistake
 		OV_ERROR_UNLESS_KRV(!lastOutputs || !lostStreams, "Invalid configuration: missing output for stream(s) and missing stream for output(s)",
 							Kernel::ErrorType::BadConfig);
+		m_hasHeader = true;
 	}
 
 	if (top == OVP_NodeId_OpenViBEStream_Buffer)
 	{
-		m_pending = ((m_outputIdx != std::numeric_limits<size_t>::max()) &&
+		m_pending = (m_selected && (m_outputIdx != std::numeric_limits<size_t>::max()) &&
 					 (m_startTime != std::numeric_limits<uint64_t>::max()) &&
 					 (m_endTime != std::numeric_limits<uint64_t>::max()));
 	}
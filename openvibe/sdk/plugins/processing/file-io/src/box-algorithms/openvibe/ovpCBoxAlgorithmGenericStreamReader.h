@@ -1,16 +1,21 @@
 #pragma once
 
 #include "../../ovp_defines.h"
+#include "ovpCBlockCodec.h"
+#include "ovpCChunkSelector.h"
+#include "ovpCReadAheadFile.h"
 #include <openvibe/ov_all.h>
 #include <toolkit/ovtk_all.h>
 
 #include <ebml/CReader.h>
 #include <ebml/CReaderHelper.h>
 
+#include <deque>
+#include <future>
 #include <stack>
 #include <map>
-
-#include <cstdio>
+#include <set>
+#include <vector>
 
 namespace OpenViBE {
 namespace Plugins {
@@ -30,26 +35,65 @@ public:
 
 
 protected:
+
+	/// <summary> Time to file offset index of a stream, as appended by the generic stream writer or built by scanning the file. </summary>
+	typedef struct SStreamIndex
+	{
+		uint64_t nextTime    = 0;
+		uint64_t maxDuration = 0;	// Longest chunk, a chunk overlapping a time starts at most that long before it
+		std::vector<std::pair<uint64_t, uint64_t>> entries;	// Start time and file offset of the indexed chunks
+	} stream_index_t;
+
 	CString m_filename;
+	uint64_t m_readStartTime = 0;	// Chunks ending before are skipped, except the first chunk of each stream, the others keep their time
+	uint64_t m_readEndTime   = 0;	// Chunks starting after are skipped, 0 to read up to the end
+	CChunkSelector m_selector;
 
 	EBML::CReader m_reader;
 	EBML::CReaderHelper m_readerHelper;
 
-	CMemoryBuffer m_swap;
 	CMemoryBuffer m_pendingChunk;
 	uint64_t m_startTime = 0;
 	uint64_t m_endTime   = 0;
 	size_t m_outputIdx   = 0;
+	size_t m_streamIdx   = 0;
 	bool m_pending       = false;
+	bool m_selected      = false;
 	bool m_hasEBMLHeader = false;
+	bool m_hasHeader     = false;
+	bool m_hasSentEnd    = false;
+	uint64_t m_compression = OVP_OpenViBEStream_Compression_None;
 
-	FILE* m_file = nullptr;
+	CReadAheadFile m_file;
 	std::stack<EBML::CIdentifier> m_nodes;
 	std::map<size_t, size_t> m_streamIdxToOutputIdxs;
 	std::map<size_t, CIdentifier> m_streamIdxToTypeIDs;
+	std::map<size_t, uint64_t> m_outputEndTimes;	// End time of the last chunk sent on each output
+	CMemoryBuffer m_endChunk;
+
+	// File offsets to go to once the header is read, the file is read on from the last one
+	std::map<size_t, stream_index_t> m_indexes;
+	std::deque<uint64_t> m_seeks;
+
+	// Decompressed block whose buffer nodes are being read, the next block of the file is decompressed meanwhile by a worker
+	CBlockCodec m_codec;
+	std::vector<uint8_t> m_block;
+	size_t m_blockPosition = 0;
+	CBlockCodec m_nextCodec;
+	std::vector<uint8_t> m_nextEncodedBlock;
+	std::vector<uint8_t> m_nextBlock;
+	uint64_t m_nextBlockOffset = 0;
+	std::future<bool> m_nextBlockDecoded;
 
 private:
 	bool initializeFile();
+	bool loadIndex();
+	bool buildIndex();
+	void planSeeks();
+	bool readBlock(uint64_t offset, const uint8_t* buffer, size_t size);
+	void prefetchBlock();
+	void clearBlocks();
+	void resetPendingChunk();
 	bool isMasterChild(const EBML::CIdentifier& identifier) override;
 	void openChild(const EBML::CIdentifier& identifier) override;
 	void processChildData(const void* buffer, const size_t size) override;
@@ -106,7 +150,7 @@ public:
 	CString getShortDescription() const override { return "Reads OpenViBE streams saved in the .ov format"; }
 	CString getDetailedDescription() const override { return "Generic Stream Writer box can be used to store data in the format read by this box"; }
 	CString getCategory() const override { return "File reading and writing/OpenViBE"; }
-	CString getVersion() const override { return "1.0"; }
+	CString getVersion() const override { return "1.1"; }
 
 	CIdentifier getCreatedClass() const override { return OVP_ClassId_BoxAlgorithm_GenericStreamReader; }
 	IPluginObject* create() override { return new CBoxAlgorithmGenericStreamReader; }
@@ -117,6 +161,8 @@ public:
 	{
 		prototype.addOutput("Output stream 1", OV_TypeId_EBMLStream);
 		prototype.addSetting("Filename", OV_TypeId_Filename, "");
+		prototype.addSetting("Start time (s)", OV_TypeId_Float, "0");
+		prototype.addSetting("End time (s)", OV_TypeId_Float, "0");
 		prototype.addFlag(Kernel::BoxFlag_CanAddOutput);
 		prototype.addFlag(Kernel::BoxFlag_CanModifyOutput);
 		return true;
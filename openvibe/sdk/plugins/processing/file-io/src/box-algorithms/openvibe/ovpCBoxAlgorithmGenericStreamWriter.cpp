@@ -2,10 +2,25 @@
 
 #include <fs/Files.h>
 
+#include <algorithm>
+
 namespace OpenViBE {
 namespace Plugins {
 namespace FileIO {
 
+namespace {
+// Minimal time between two index entries of a stream
+constexpr uint64_t INDEX_PERIOD = 1LL << 32;
+// Size from which the buffer nodes waiting for compression are written as a block,
+// large enough to compress well and small enough to be decompressed by the reader while it replays the previous block
+constexpr size_t BLOCK_SIZE = 1 << 20;
+
+void appendUInt64(std::vector<uint8_t>& buffer, const uint64_t value)
+{
+	for (int i = 56; i >= 0; i -= 8) { buffer.push_back(uint8_t(value >> i)); }
+}
+}  // namespace
+
 CBoxAlgorithmGenericStreamWriter::CBoxAlgorithmGenericStreamWriter() : m_writer(*this) {}
 
 bool CBoxAlgorithmGenericStreamWriter::initialize()
@@ -13,14 +28,25 @@ bool CBoxAlgorithmGenericStreamWriter::initialize()
 	m_filename             = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 0);
 	const bool compression = FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 1);
 
-	if (compression) { OV_WARNING_K("Impossible to use compression as it is not yet implemented"); }
+	m_compression = compression ? OVP_OpenViBEStream_Compression_ShuffleDeflate : OVP_OpenViBEStream_Compression_None;
+	m_block.clear();
+
+	// The index setting was added after the first version of the box
+	m_hasIndex = this->getStaticBoxContext().getSettingCount() > 2 && bool(FSettingValueAutoCast(*this->getBoxAlgorithmContext(), 2));
+	m_indexes.assign(this->getStaticBoxContext().getInputCount(), stream_index_t());
+	m_fileSize = 0;
 
 	return true;
 }
 
 bool CBoxAlgorithmGenericStreamWriter::uninitialize()
 {
-	if (m_file.is_open()) { m_file.close(); }
+	if (m_file.is_open())
+	{
+		if (!m_block.empty()) { writeBlock(); }
+		if (m_hasIndex) { writeIndex(); }
+		m_file.close();
+	}
 	return true;
 }
 
@@ -48,7 +74,7 @@ bool CBoxAlgorithmGenericStreamWriter::generateFileHeader()
 
 	m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Header);
 	m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Header_Compression);
-	m_writerHelper.setUInt(0 /* compression flag */);
+	m_writerHelper.setUInt(m_compression);
 	m_writerHelper.closeChild();
 	for (size_t i = 0; i < boxContext.getInputCount(); ++i)
 	{
@@ -67,6 +93,7 @@ bool CBoxAlgorithmGenericStreamWriter::generateFileHeader()
 	OV_ERROR_UNLESS_KRF(m_file.good(), "Error opening file [" << m_filename << "] for writing", Kernel::ErrorType::BadFileWrite);
 
 	m_file.write(reinterpret_cast<const char*>(m_swap.getDirectPointer()), std::streamsize(m_swap.getSize()));
+	m_fileSize += m_swap.getSize();
 
 	m_isHeaderGenerate = true;
 	return true;
@@ -91,6 +118,20 @@ bool CBoxAlgorithmGenericStreamWriter::process()
 	{
 		for (size_t j = 0; j < boxContext.getInputChunkCount(i); ++j)
 		{
+			if (m_hasIndex)
+			{
+				const uint64_t startTime = boxContext.getInputChunkStartTime(i, j);
+				stream_index_t& index    = m_indexes[i];
+				if (startTime >= index.nextTime)
+				{
+					index.entries.push_back(startTime);
+					// Chunks are written to the swap buffer as they are closed, compressed chunks are found from the start of their block
+					index.entries.push_back(m_compression == OVP_OpenViBEStream_Compression_None ? m_fileSize + m_swap.getSize() : m_fileSize);
+					index.nextTime = startTime + INDEX_PERIOD;
+				}
+				index.maxDuration = std::max(index.maxDuration, boxContext.getInputChunkEndTime(i, j) - startTime);
+			}
+
 			m_writerHelper.connect(&m_writer);
 			m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Buffer);
 			m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Buffer_StreamIndex);
@@ -111,12 +152,83 @@ bool CBoxAlgorithmGenericStreamWriter::process()
 		}
 	}
 
-	if (m_swap.getSize() != 0)
+	if (m_compression != OVP_OpenViBEStream_Compression_None)
+	{
+		m_block.insert(m_block.end(), m_swap.getDirectPointer(), m_swap.getDirectPointer() + m_swap.getSize());
+		if (m_block.size() >= BLOCK_SIZE) { return writeBlock(); }
+	}
+	else if (m_swap.getSize() != 0)
 	{
 		m_file.write(reinterpret_cast<const char*>(m_swap.getDirectPointer()), std::streamsize(m_swap.getSize()));
 		OV_ERROR_UNLESS_KRF(m_file.good(), "Error opening file [" << m_filename << "] for writing", Kernel::ErrorType::BadFileWrite);
+		m_fileSize += m_swap.getSize();
+	}
+
+	return true;
+}
+
+bool CBoxAlgorithmGenericStreamWriter::writeBlock()
+{
+	OV_ERROR_UNLESS_KRF(m_codec.encode(m_block.data(), m_block.size(), m_encodedBlock), "Error compressing data for file [" << m_filename << "]",
+						Kernel::ErrorType::Internal);
+
+	m_swap.setSize(0, true);
+	m_writerHelper.connect(&m_writer);
+	m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Block);
+	m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Block_Size);
+	m_writerHelper.setUInt(m_block.size());
+	m_writerHelper.closeChild();
+	m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Block_Data);
+	m_writerHelper.setBinary(m_encodedBlock.data(), m_encodedBlock.size());
+	m_writerHelper.closeChild();
+	m_writerHelper.closeChild();
+	m_writerHelper.disconnect();
+	m_block.clear();
+
+	m_file.write(reinterpret_cast<const char*>(m_swap.getDirectPointer()), std::streamsize(m_swap.getSize()));
+	OV_ERROR_UNLESS_KRF(m_file.good(), "Error writing to file [" << m_filename << "]", Kernel::ErrorType::BadFileWrite);
+	m_fileSize += m_swap.getSize();
+	return true;
+}
+
+bool CBoxAlgorithmGenericStreamWriter::writeIndex()
+{
+	// The index is followed by a fixed size node holding its offset, so that readers find it from the end of the file
+	const uint64_t offset = m_fileSize;
+	std::vector<uint8_t> entries;
+
+	m_swap.setSize(0, true);
+	m_writerHelper.connect(&m_writer);
+	m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Index);
+	for (size_t i = 0; i < m_indexes.size(); ++i)
+	{
+		entries.clear();
+		for (const uint64_t value : m_indexes[i].entries) { appendUInt64(entries, value); }
+
+		m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Index_Stream);
+		m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Index_StreamIndex);
+		m_writerHelper.setUInt(i);
+		m_writerHelper.closeChild();
+		m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Index_MaxDuration);
+		m_writerHelper.setUInt(m_indexes[i].maxDuration);
+		m_writerHelper.closeChild();
+		m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_Index_Entries);
+		m_writerHelper.setBinary(entries.data(), entries.size());
+		m_writerHelper.closeChild();
+		m_writerHelper.closeChild();
 	}
+	m_writerHelper.closeChild();
 
+	entries.clear();
+	appendUInt64(entries, offset);
+	m_writerHelper.openChild(OVP_NodeId_OpenViBEStream_IndexOffset);
+	m_writerHelper.setBinary(entries.data(), entries.size());
+	m_writerHelper.closeChild();
+	m_writerHelper.disconnect();
+
+	m_file.write(reinterpret_cast<const char*>(m_swap.getDirectPointer()), std::streamsize(m_swap.getSize()));
+	OV_ERROR_UNLESS_KRF(m_file.good(), "Error writing index to file [" << m_filename << "]", Kernel::ErrorType::BadFileWrite);
+	m_fileSize += m_swap.getSize();
 	return true;
 }
 
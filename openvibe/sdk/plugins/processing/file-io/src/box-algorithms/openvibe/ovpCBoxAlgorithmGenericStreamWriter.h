@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../ovp_defines.h"
+#include "ovpCBlockCodec.h"
 #include <openvibe/ov_all.h>
 #include <toolkit/ovtk_all.h>
 
@@ -10,6 +11,7 @@
 #include <cstdio>
 
 #include <fstream>
+#include <vector>
 
 namespace OpenViBE {
 namespace Plugins {
@@ -25,6 +27,8 @@ public:
 	bool process() override;
 
 	bool generateFileHeader();
+	bool writeBlock();
+	bool writeIndex();
 
 	_IsDerivedFromClass_Final_(Toolkit::TBoxAlgorithm<IBoxAlgorithm>, OVP_ClassId_BoxAlgorithm_GenericStreamWriter)
 
@@ -37,8 +41,25 @@ protected:
 private:
 	void write(const void* buffer, const size_t size) override;
 
+	/// <summary> Time to file offset index of a stream, with an entry every second of the stream at most. </summary>
+	typedef struct SStreamIndex
+	{
+		uint64_t nextTime    = 0;
+		uint64_t maxDuration = 0;	// Longest chunk, a chunk overlapping a time starts at most that long before it
+		std::vector<uint64_t> entries;	// Start time and file offset of the indexed chunks, in turn
+	} stream_index_t;
+
 	CMemoryBuffer m_swap;
 	std::ofstream m_file;
+	uint64_t m_fileSize    = 0;
+	uint64_t m_compression = OVP_OpenViBEStream_Compression_None;
+	bool m_hasIndex        = false;
+
+	// Buffer nodes waiting to be compressed together
+	CBlockCodec m_codec;
+	std::vector<uint8_t> m_block;
+	std::vector<uint8_t> m_encodedBlock;
+	std::vector<stream_index_t> m_indexes;	// By input
 };
 
 class CBoxAlgorithmGenericStreamWriterListener final : public Toolkit::TBoxListener<IBoxListener>
@@ -109,6 +130,7 @@ public:
 		prototype.addInput("Input stream 1", OV_TypeId_EBMLStream);
 		prototype.addSetting("Filename", OV_TypeId_Filename, "record-[$core{date}-$core{time}].ov");
 		prototype.addSetting("Use compression", OV_TypeId_Boolean, "false");
+		prototype.addSetting("Write index", OV_TypeId_Boolean, "false");
 		prototype.addFlag(Kernel::BoxFlag_CanAddInput);
 		prototype.addFlag(Kernel::BoxFlag_CanModifyInput);
 		return true;
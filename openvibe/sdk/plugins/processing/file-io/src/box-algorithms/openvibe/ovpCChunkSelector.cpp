@@ -0,0 +1,40 @@
+#include "ovpCChunkSelector.h"
+
+namespace OpenViBE {
+namespace Plugins {
+namespace FileIO {
+
+void CChunkSelector::setRange(const uint64_t startTime, const uint64_t endTime)
+{
+	m_startTime   = startTime;
+	m_endTime     = endTime;
+	m_maxDuration = std::numeric_limits<uint64_t>::max();
+	reset(0);
+}
+
+void CChunkSelector::reset(const size_t nStream)
+{
+	m_nStream = nStream;
+	m_startedStreams.clear();
+	m_endedStreams.clear();
+	m_hasEnded = false;
+}
+
+bool CChunkSelector::select(const size_t stream, const uint64_t startTime, const uint64_t endTime)
+{
+	const bool isFirst = m_startedStreams.insert(stream).second;
+
+	if (m_endTime != 0 && startTime >= m_endTime)
+	{
+		// The later chunks of this stream are past the end time too, those of the other streams start at most the longest chunk before this one
+		m_endedStreams.insert(stream);
+		m_hasEnded = m_endedStreams.size() >= m_nStream || startTime - m_endTime >= m_maxDuration;
+		return isFirst;
+	}
+	if (isFirst) { return true; }
+	return endTime > m_startTime || (endTime == m_startTime && startTime == endTime);
+}
+
+}  // namespace FileIO
+}  // namespace Plugins
+}  // namespace OpenViBE
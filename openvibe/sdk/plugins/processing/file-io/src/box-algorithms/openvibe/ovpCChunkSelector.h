@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <set>
+
+namespace OpenViBE {
+namespace Plugins {
+namespace FileIO {
+/// <summary> Selection of the chunks of a .ov file which overlap a time range. </summary>
+/// <remarks>
+/// The chunks of a stream are stored in time order, but the streams are interleaved by the time their chunks reached the writer,
+/// so a stream with long chunks can still have chunks before the end time stored after the first chunk of another stream past it.
+/// The reading ends once every stream has gone past the end time, or once a chunk starts later than the end time by more than
+/// the longest chunk of the file when it is known from its index.
+/// </remarks>
+class CChunkSelector final
+{
+public:
+
+	/// <summary> Sets the time range to read, an end time of 0 reads up to the end of the file. </summary>
+	void setRange(uint64_t startTime, uint64_t endTime);
+
+	/// <summary> Sets the duration of the longest chunk of the file, as given by its index. </summary>
+	void setMaxDuration(const uint64_t duration) { m_maxDuration = duration; }
+
+	/// <summary> Starts the selection over for a file header declaring <c>nStream</c> streams. </summary>
+	void reset(size_t nStream);
+
+	/// <summary> Tells if a chunk is to be read, the chunks are given in file order. </summary>
+	/// <remarks> The first chunk of each stream holds its header, which decoders need whatever the time range. </remarks>
+	bool select(size_t stream, uint64_t startTime, uint64_t endTime);
+
+	/// <summary> Tells if no chunk further in the file can be selected. </summary>
+	bool hasEnded() const { return m_hasEnded; }
+
+private:
+
+	uint64_t m_startTime   = 0;
+	uint64_t m_endTime     = 0;
+	uint64_t m_maxDuration = std::numeric_limits<uint64_t>::max();	// Unknown without an index
+	size_t m_nStream       = 0;
+	std::set<size_t> m_startedStreams;
+	std::set<size_t> m_endedStreams;
+	bool m_hasEnded = false;
+};
+}  // namespace FileIO
+}  // namespace Plugins
+}  // namespace OpenViBE
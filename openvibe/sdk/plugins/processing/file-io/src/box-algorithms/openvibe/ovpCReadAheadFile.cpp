@@ -0,0 +1,136 @@
+#include "ovpCReadAheadFile.h"
+
+#include <fs/Files.h>
+
+namespace OpenViBE {
+namespace Plugins {
+namespace FileIO {
+
+bool CReadAheadFile::open(const std::string& filename)
+{
+	close();
+	FS::Files::openIFStream(m_file, filename.c_str(), std::ios::binary);
+	if (!m_file.is_open()) { return false; }
+
+	m_file.seekg(0, std::ios::end);
+	m_size = uint64_t(m_file.tellg());
+	m_file.seekg(0, std::ios::beg);
+	start();
+	return true;
+}
+
+void CReadAheadFile::close()
+{
+	stop();
+	if (m_file.is_open()) { m_file.close(); }
+	m_file.clear();
+	m_freeBlocks.clear();
+	m_size         = 0;
+	m_windowOffset = 0;
+	m_failed       = false;
+}
+
+bool CReadAheadFile::seek(const uint64_t offset)
+{
+	if (!m_file.is_open() || offset > m_size) { return false; }
+
+	stop();
+	m_file.clear();
+	m_file.seekg(std::streamoff(offset), std::ios::beg);
+	m_windowOffset = offset;
+	start();
+	return true;
+}
+
+size_t CReadAheadFile::request(const size_t size)
+{
+	while (m_window.size() - m_position < size)
+	{
+		std::vector<uint8_t> block;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return !m_blocks.empty() || m_ended; });
+			if (m_blocks.empty())
+			{
+				m_failed = m_error;
+				break;
+			}
+			block = std::move(m_blocks.front());
+			m_blocks.pop_front();
+		}
+		m_condition.notify_all();
+
+		m_window.erase(m_window.begin(), m_window.begin() + std::ptrdiff_t(m_position));
+		m_window.insert(m_window.end(), block.begin(), block.end());
+		m_windowOffset += m_position;
+		m_position = 0;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_freeBlocks.push_back(std::move(block));
+	}
+	return m_window.size() - m_position;
+}
+
+void CReadAheadFile::start()
+{
+	m_window.clear();
+	m_position = 0;
+	m_failed   = false;
+	m_blocks.clear();
+	m_ended  = false;
+	m_stop   = false;
+	m_error  = false;
+	m_thread = std::thread(&CReadAheadFile::readBlocks, this);
+}
+
+void CReadAheadFile::stop()
+{
+	if (m_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+	}
+	m_window.clear();
+	m_position = 0;
+	m_blocks.clear();
+}
+
+void CReadAheadFile::readBlocks()
+{
+	while (true)
+	{
+		std::vector<uint8_t> block;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stop || m_blocks.size() < m_nBlock; });
+			if (m_stop) { return; }
+			if (!m_freeBlocks.empty())
+			{
+				block = std::move(m_freeBlocks.back());
+				m_freeBlocks.pop_back();
+			}
+		}
+
+		block.resize(m_blockSize);
+		m_file.read(reinterpret_cast<char*>(block.data()), std::streamsize(m_blockSize));
+		const size_t size = size_t(m_file.gcount());
+		block.resize(size);
+		const bool ended = size < m_blockSize;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (size != 0) { m_blocks.push_back(std::move(block)); }
+			m_ended = ended;
+			m_error = ended && m_file.bad();
+		}
+		m_condition.notify_all();
+		if (ended) { return; }
+	}
+}
+
+}  // namespace FileIO
+}  // namespace Plugins
+}  // namespace OpenViBE
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OpenViBE {
+namespace Plugins {
+namespace FileIO {
+/// <summary> Binary file read in large blocks by a background thread, ahead of the reading position. </summary>
+/// <remarks>
+/// The data is handed out as a contiguous window starting at the reading position,
+/// so records can be parsed in place and a box only waits for the disk if the background thread falls behind.
+/// </remarks>
+class CReadAheadFile final
+{
+public:
+
+	/// <param name="blockSize"> Size of the blocks read from the file. </param>
+	/// <param name="nBlock"> Number of blocks read ahead of the reading position. </param>
+	explicit CReadAheadFile(size_t blockSize = 1 << 20, size_t nBlock = 4) : m_blockSize(blockSize), m_nBlock(nBlock) { }
+	~CReadAheadFile() { close(); }
+
+	bool open(const std::string& filename);
+	void close();
+	bool isOpen() const { return m_file.is_open(); }
+
+	/// <summary> Moves the reading position to an offset of the file, the data read ahead is discarded. </summary>
+	bool seek(uint64_t offset);
+
+	uint64_t getSize() const { return m_size; }
+	uint64_t getPosition() const { return m_windowOffset + m_position; }
+
+	/// <summary> Makes at least <c>size</c> bytes readable from <see cref="getData"/>, waiting for the background thread if needed. </summary>
+	/// <returns> The number of readable bytes, which is less than <c>size</c> only if the file ends before. </returns>
+	size_t request(size_t size);
+
+	/// <summary> Gets the data at the reading position, valid until the next call to <see cref="request"/>. </summary>
+	const uint8_t* getData() const { return m_window.data() + m_position; }
+
+	/// <summary> Moves the reading position forward, over bytes made readable by <see cref="request"/>. </summary>
+	void skip(const size_t size) { m_position += size; }
+
+	/// <summary> Checks if the file is read up to its end. </summary>
+	bool isEnd() { return request(1) == 0; }
+
+	/// <summary> Checks if reading the file failed, rather than reaching its end. </summary>
+	bool hasFailed() const { return m_failed; }
+
+private:
+
+	void start();
+	void stop();
+	void readBlocks();
+
+	size_t m_blockSize = 0;
+	size_t m_nBlock    = 0;
+	std::ifstream m_file;
+	uint64_t m_size = 0;
+
+	// Data from the reading position on, the bytes before m_position are discarded when the window is refilled
+	std::vector<uint8_t> m_window;
+	uint64_t m_windowOffset = 0;
+	size_t m_position       = 0;
+	bool m_failed           = false;
+
+	// Blocks read by the background thread, the thread sets m_ended once it has read the last block of the file
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<std::vector<uint8_t>> m_blocks;
+	std::vector<std::vector<uint8_t>> m_freeBlocks;
+	bool m_ended = false;
+	bool m_stop  = false;
+	bool m_error = false;
+};
+}  // namespace FileIO
+}  // namespace Plugins
+}  // namespace OpenViBE
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <ebml/CIdentifier.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OpenViBE {
+namespace Plugins {
+namespace FileIO {
+/// <summary> Gets the length of the EBML coded number starting the buffer, 0 if the buffer ends within it. </summary>
+inline size_t getCodedLength(const uint8_t* buffer, const size_t size)
+{
+	if (size == 0) { return 0; }
+	for (size_t i = 0; i < 8; ++i) { if (buffer[0] & (0x80 >> i)) { return i + 1; } }
+	if (size == 1) { return 0; }
+	return (buffer[1] & 0x80) ? 9 : 10;
+}
+
+/// <summary> Reads the header of the node starting the buffer. </summary>
+/// <returns> <c>false</c> if the buffer ends within the node header. </returns>
+inline bool readNodeHeader(const uint8_t* buffer, const size_t size, EBML::CIdentifier& id, size_t& headerSize, uint64_t& contentSize)
+{
+	const size_t idLength = getCodedLength(buffer, size);
+	if (idLength == 0 || idLength >= size) { return false; }
+	const size_t sizeLength = getCodedLength(buffer + idLength, size - idLength);
+	if (sizeLength == 0 || sizeLength > 8 || idLength + sizeLength > size) { return false; }
+
+	// Identifiers keep their coded length, except for the marker bit, as decoded by the EBML reader
+	uint64_t value = 0;
+	for (size_t i = 0; i < idLength; ++i) { value = (value << 8) | buffer[i]; }
+	if (idLength <= 9) { value &= ~(uint64_t(1) << (7 * idLength)); }
+	id = value;
+
+	contentSize = buffer[idLength] & (0xFF >> sizeLength);
+	for (size_t i = 1; i < sizeLength; ++i) { contentSize = (contentSize << 8) | buffer[idLength + i]; }
+	headerSize = idLength + sizeLength;
+	return true;
+}
+
+/// <summary> Gets the size of the node starting the buffer, header included. </summary>
+/// <returns> <c>false</c> if the buffer ends within the node header. </returns>
+inline bool getNodeSize(const uint8_t* buffer, const size_t size, size_t& nodeSize)
+{
+	EBML::CIdentifier id;
+	size_t headerSize    = 0;
+	uint64_t contentSize = 0;
+	if (!readNodeHeader(buffer, size, id, headerSize, contentSize)) { return false; }
+	nodeSize = headerSize + size_t(contentSize);
+	return true;
+}
+
+/// <summary> Calls a function with the identifier, content and content size of each node of the buffer, until it returns <c>false</c>. </summary>
+/// <returns> <c>false</c> if a node is cut by the end of the buffer or the function returned <c>false</c>. </returns>
+template <typename TFunction>
+bool forEachNode(const uint8_t* buffer, const size_t size, TFunction function)
+{
+	size_t position = 0;
+	while (position < size)
+	{
+		EBML::CIdentifier id;
+		size_t headerSize    = 0;
+		uint64_t contentSize = 0;
+		if (!readNodeHeader(buffer + position, size - position, id, headerSize, contentSize)) { return false; }
+		if (contentSize > size - position - headerSize) { return false; }
+		if (!function(id, buffer + position + headerSize, size_t(contentSize))) { return false; }
+		position += headerSize + size_t(contentSize);
+	}
+	return true;
+}
+
+/// <summary> Reads an unsigned integer stored big endian on <c>size</c> bytes. </summary>
+inline uint64_t getUInt(const uint8_t* buffer, const size_t size)
+{
+	uint64_t value = 0;
+	for (size_t i = 0; i < size; ++i) { value = (value << 8) | buffer[i]; }
+	return value;
+}
+}  // namespace FileIO
+}  // namespace Plugins
+}  // namespace OpenViBE
@@ -27,6 +27,9 @@
 
 // Type definitions
 //---------------------------------------------------------------------------------------------------
+#define OVP_OpenViBEStream_Compression_None								0	// Buffer nodes are written as they are
+#define OVP_OpenViBEStream_Compression_ShuffleDeflate					1	// Buffer nodes are grouped in blocks, see CBlockCodec
+
 #define OVP_NodeId_OpenViBEStream_Header								EBML::CIdentifier(0xF59505AB, 0x3684C8D8)
 #define OVP_NodeId_OpenViBEStream_Header_Compression					EBML::CIdentifier(0x40358769, 0x166380D1)
 #define OVP_NodeId_OpenViBEStream_Header_StreamType						EBML::CIdentifier(0x732EC1D1, 0xFE904087)
@@ -37,6 +40,15 @@
 #define OVP_NodeId_OpenViBEStream_Buffer_StartTime						EBML::CIdentifier(0x093E6A0A, 0xC5A9467B)
 #define OVP_NodeId_OpenViBEStream_Buffer_EndTime						EBML::CIdentifier(0x8B5CCCD9, 0xC5024F29)
 #define OVP_NodeId_OpenViBEStream_Buffer_Content						EBML::CIdentifier(0x8D4B0BE8, 0x7051265C)
+#define OVP_NodeId_OpenViBEStream_Block									EBML::CIdentifier(0x4E1B93D6, 0x2A7C05F1)
+#define OVP_NodeId_OpenViBEStream_Block_Size							EBML::CIdentifier(0x19F6C2A8, 0x73D0B54E)
+#define OVP_NodeId_OpenViBEStream_Block_Data							EBML::CIdentifier(0x6A25E0C7, 0xB8431F9D)
+#define OVP_NodeId_OpenViBEStream_Index									EBML::CIdentifier(0x5C3A71E2, 0x0B96D4A7)
+#define OVP_NodeId_OpenViBEStream_Index_Stream							EBML::CIdentifier(0x1E8D42B9, 0x6F0A35C4)
+#define OVP_NodeId_OpenViBEStream_Index_StreamIndex						EBML::CIdentifier(0x37F29C05, 0xA2D1486B)
+#define OVP_NodeId_OpenViBEStream_Index_MaxDuration						EBML::CIdentifier(0x64B0E7D3, 0x19C8A25F)
+#define OVP_NodeId_OpenViBEStream_Index_Entries							EBML::CIdentifier(0x0D57A36C, 0xE4192BF8)
+#define OVP_NodeId_OpenViBEStream_IndexOffset							EBML::CIdentifier(0x7A1F0C94, 0x58E3B61D)
 
 // Global defines
 //---------------------------------------------------------------------------------------------------
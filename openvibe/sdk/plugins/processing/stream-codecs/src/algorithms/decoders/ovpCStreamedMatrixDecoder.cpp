@@ -18,6 +18,24 @@ void trim(char* dst, const char* src1, const char* src2)
 	strncpy(dst, src1, src2 - src1);
 	dst[src2 - src1] = '\0';
 }
+
+// Reads the identifier and the size of a node spanning to the end of the buffer, codings on more than 8 bytes are left to the EBML reader
+bool readNode(const uint8_t* buffer, const size_t size, size_t& offset, const EBML::CIdentifier& id)
+{
+	uint64_t values[2];
+	for (auto& value : values)
+	{
+		if (offset >= size) { return false; }
+		size_t length = 1;
+		while (length <= 8 && !(buffer[offset] & (0x80 >> (length - 1)))) { length++; }
+		if (length > 8 || offset + length > size) { return false; }
+
+		value = buffer[offset] & (0xff >> length);
+		for (size_t i = 1; i < length; ++i) { value = (value << 8) | buffer[offset + i]; }
+		offset += length;
+	}
+	return values[0] == uint64_t(id) && values[1] == size - offset;
+}
 }  // namespace
 
 // ________________________________________________________________________________________________________________
@@ -40,6 +58,36 @@ bool CStreamedMatrixDecoder::uninitialize()
 // ________________________________________________________________________________________________________________
 //
 
+bool CStreamedMatrixDecoder::process()
+{
+	// Between two chunks no node is opened, a buffer chunk is decoded without the EBML reader when it has the expected layout
+	if (m_nodes.empty() && decodeBuffer()) { return true; }
+	return CEBMLBaseDecoder::process();
+}
+
+bool CStreamedMatrixDecoder::decodeBuffer()
+{
+	const uint8_t* buffer = ip_bufferToDecode->getDirectPointer();
+	const size_t size     = ip_bufferToDecode->getSize();
+	const size_t rawSize  = m_size * sizeof(double);
+
+	// Once the header is known, buffer chunks only differ by their raw buffer
+	if (m_bufferPrefix.empty() || size != m_bufferPrefix.size() + rawSize || memcmp(buffer, m_bufferPrefix.data(), m_bufferPrefix.size()) != 0)
+	{
+		size_t offset = 0;
+		if (!readNode(buffer, size, offset, OVTK_NodeId_Buffer) || !readNode(buffer, size, offset, OVTK_NodeId_Buffer_StreamedMatrix)
+			|| !readNode(buffer, size, offset, OVTK_NodeId_Buffer_StreamedMatrix_RawBuffer) || size - offset != rawSize) { return false; }
+		m_bufferPrefix.assign(buffer, buffer + offset);
+	}
+
+	memcpy(op_pMatrix->getBuffer(), buffer + m_bufferPrefix.size(), rawSize);
+	activateOutputTrigger(OVP_Algorithm_EBMLDecoder_OutputTriggerId_ReceivedBuffer, true);
+	return true;
+}
+
+// ________________________________________________________________________________________________________________
+//
+
 bool CStreamedMatrixDecoder::isMasterChild(const EBML::CIdentifier& id)
 {
 	if (id == OVTK_NodeId_Header_StreamedMatrix) { return true; }
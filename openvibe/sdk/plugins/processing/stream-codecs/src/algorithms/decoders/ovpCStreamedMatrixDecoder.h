@@ -3,6 +3,7 @@
 #include "../../ovp_defines.h"
 #include "ovpCEBMLBaseDecoder.h"
 #include <stack>
+#include <vector>
 
 namespace OpenViBE {
 namespace Plugins {
@@ -14,6 +15,7 @@ public:
 	void release() override { delete this; }
 	bool initialize() override;
 	bool uninitialize() override;
+	bool process() override;
 
 	_IsDerivedFromClass_Final_(StreamCodecs::CEBMLBaseDecoder, OVP_ClassId_Algorithm_StreamedMatrixDecoder)
 
@@ -29,6 +31,8 @@ protected:
 private:
 	enum class EParsingStatus { Nothing, Header, Buffer, Dimension };
 
+	bool decodeBuffer();
+
 	std::stack<EBML::CIdentifier> m_nodes;
 
 	EParsingStatus m_status    = EParsingStatus::Nothing;
@@ -36,6 +40,8 @@ private:
 	size_t m_dimensionEntryIdx = 0;
 	// size_t mdimensionEntryIdxUnit = 0;
 	size_t m_size = 0;
+
+	std::vector<uint8_t> m_bufferPrefix;	// Bytes of the last buffer chunk before its raw buffer
 };
 
 class CStreamedMatrixDecoderDesc : public CEBMLBaseDecoderDesc
@@ -11,7 +11,7 @@ bool CEBMLBaseEncoder::initialize()
 {
 	op_buffer.initialize(getOutputParameter(OVP_Algorithm_EBMLEncoder_OutputParameterId_EncodedMemoryBuffer));
 
-	m_writer       = createWriter(m_callbackProxy);
+	m_writer       = createInPlaceWriter(m_callbackProxy);
 	m_writerHelper = EBML::createWriterHelper();
 	m_writerHelper->connect(m_writer);
 
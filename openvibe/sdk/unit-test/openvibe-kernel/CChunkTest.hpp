@@ -0,0 +1,169 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CChunkTest.hpp
+/// \brief Test Definitions for the chunks of the OpenViBE kernel player.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include "ovkCChunk.h"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+// Fills the current chunk of an output and sends it on a link, as the simulated box does on markOutputAsReadyToSend
+const OpenViBE::Kernel::CBuffer* sendChunk(OpenViBE::Kernel::CChunk& current, std::vector<std::shared_ptr<OpenViBE::Kernel::CBuffer>>& recycled,
+										   std::vector<OpenViBE::Kernel::CChunk>& link, const size_t size)
+{
+	OpenViBE::Kernel::CBuffer& buffer = current.getBuffer();
+	buffer.setSize(size, true);
+	std::fill_n(buffer.getDirectPointer(), size, uint8_t(size));
+	link.push_back(current);
+	current.renewBuffer(recycled);
+	return &buffer;
+}
+
+bool isRecycled(const OpenViBE::Kernel::CBuffer* buffer, const std::vector<std::shared_ptr<OpenViBE::Kernel::CBuffer>>& recycled)
+{
+	return std::any_of(recycled.begin(), recycled.end(), [&](const std::shared_ptr<OpenViBE::Kernel::CBuffer>& b) { return b.get() == buffer; });
+}
+}  // namespace
+
+//---------------------------------------------------------------------------------------------------
+TEST(CChunk_Tests, share)
+{
+	OpenViBE::Kernel::CChunk chunk;
+	chunk.getBuffer().setSize(4, true);
+	const OpenViBE::Kernel::CChunk copy(chunk);
+	EXPECT_EQ(&std::as_const(chunk).getBuffer(), &copy.getBuffer()) << "Read only copy doesn't share the buffer.";
+	EXPECT_EQ(4, copy.getBuffer().getSize());
+
+	chunk.getBuffer().setSize(8, true);
+	EXPECT_EQ(4, copy.getBuffer().getSize()) << "Writing a shared chunk changes its copies.";
+	EXPECT_EQ(8, std::as_const(chunk).getBuffer().getSize());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CChunk_Tests, shareRecycled)
+{
+	std::vector<std::shared_ptr<OpenViBE::Kernel::CBuffer>> recycled;
+	OpenViBE::Kernel::CChunk chunk;
+	chunk.renewBuffer(recycled);
+	ASSERT_EQ(1, recycled.size());
+
+	const OpenViBE::Kernel::CBuffer* buffer = &chunk.getBuffer();
+	EXPECT_EQ(recycled[0].get(), buffer) << "Writing a chunk only held by the pool copies its buffer.";
+
+	OpenViBE::Kernel::CChunk copy(chunk);
+	chunk.getBuffer().setSize(4, true);
+	EXPECT_NE(&std::as_const(chunk).getBuffer(), &std::as_const(copy).getBuffer()) << "Writing a recycled chunk shared with a copy doesn't copy its buffer.";
+	EXPECT_EQ(0, std::as_const(copy).getBuffer().getSize()) << "Writing a recycled chunk changes its copies.";
+
+	// The copy is not known to the pool, writing it while the pool holds the buffer must copy
+	OpenViBE::Kernel::CChunk other;
+	other = copy;
+	copy.getBuffer().setSize(2, true);
+	EXPECT_NE(&std::as_const(copy).getBuffer(), &std::as_const(other).getBuffer()) << "Writing a copy of a recycled chunk doesn't copy its buffer.";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CChunk_Tests, recycle)
+{
+	std::vector<std::shared_ptr<OpenViBE::Kernel::CBuffer>> recycled;
+	std::vector<OpenViBE::Kernel::CChunk> link;
+	OpenViBE::Kernel::CChunk current;
+
+	// The first chunk has its own buffer, the next ones are drawn from the pool
+	for (size_t i = 0; i < 4; ++i) {
+		sendChunk(current, recycled, link, 16);
+		link.clear();
+	}
+	const size_t nRecycled = recycled.size();
+
+	for (size_t i = 0; i < 100; ++i) {
+		const uint8_t* storage                  = current.getBuffer().getDirectPointer();
+		const OpenViBE::Kernel::CBuffer* buffer = sendChunk(current, recycled, link, 16);
+		EXPECT_TRUE(isRecycled(buffer, recycled)) << "Chunk " << i << " wasn't written to a recycled buffer.";
+		EXPECT_EQ(storage, buffer->getDirectPointer()) << "Chunk " << i << " didn't reuse the storage of its buffer.";
+		ASSERT_EQ(1, link.size());
+		EXPECT_EQ(buffer, &std::as_const(link[0]).getBuffer()) << "Chunk " << i << " was copied when sent.";
+		EXPECT_EQ(16, std::as_const(link[0]).getBuffer().getSize());
+		EXPECT_EQ(16, std::as_const(link[0]).getBuffer()[15]);
+		link.clear();
+	}
+	EXPECT_EQ(nRecycled, recycled.size()) << "Buffers are allocated although sent chunks are released.";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CChunk_Tests, recycleHeld)
+{
+	std::vector<std::shared_ptr<OpenViBE::Kernel::CBuffer>> recycled;
+	std::vector<OpenViBE::Kernel::CChunk> link;
+	OpenViBE::Kernel::CChunk current;
+
+	// Chunks held by a slow reader keep their buffers, which are not overwritten
+	for (size_t i = 1; i <= 8; ++i) { sendChunk(current, recycled, link, i); }
+	for (size_t i = 0; i < link.size(); ++i) {
+		ASSERT_EQ(i + 1, std::as_const(link[i]).getBuffer().getSize());
+		EXPECT_EQ(uint8_t(i + 1), std::as_const(link[i]).getBuffer()[0]) << "Held chunk " << i << " was overwritten.";
+	}
+
+	// Once released, they are reused
+	link.clear();
+	const size_t nRecycled = recycled.size();
+	for (size_t i = 0; i < 8; ++i) {
+		EXPECT_TRUE(isRecycled(sendChunk(current, recycled, link, 16), recycled));
+		link.clear();
+	}
+	EXPECT_EQ(nRecycled, recycled.size());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CChunk_Tests, steadyStateAllocation)
+{
+	std::vector<std::shared_ptr<OpenViBE::Kernel::CBuffer>> recycled;
+	std::vector<OpenViBE::Kernel::CChunk> link;
+	link.reserve(1);
+	OpenViBE::Kernel::CChunk current;
+
+	// Buffers, their storage and the pool are allocated while the stream starts
+	for (size_t i = 0; i < 4; ++i) {
+		sendChunk(current, recycled, link, 1024);
+		link.clear();
+	}
+
+	const size_t nAllocation = getAllocationCount();
+	for (size_t i = 0; i < 1000; ++i) {
+		sendChunk(current, recycled, link, 1024);
+		link.clear();
+	}
+	EXPECT_EQ(nAllocation, getAllocationCount()) << "Streaming chunks allocates memory once the buffers are recycled.";
+}
+//---------------------------------------------------------------------------------------------------
@@ -0,0 +1,158 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CLogManagerTest.hpp
+/// \brief Test Definitions for the messages written in background by the log manager of the OpenViBE kernel.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include "ovkCLogManager.h"
+#include "../common/ovtKernelContext.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/// <summary> Listener counting the strings it receives, written in background as it claims to be a console listener. </summary>
+/// <remarks> It can be held on its first string, so that the messages logged meanwhile stay in the queue of the manager. </remarks>
+class CTestLogListener final : public OpenViBE::Kernel::ILogListener
+{
+public:
+	bool isActive(const OpenViBE::Kernel::ELogLevel /*level*/) override { return m_active; }
+	bool activate(const OpenViBE::Kernel::ELogLevel /*level*/, const bool active) override { return activate(active); }
+	bool activate(const OpenViBE::Kernel::ELogLevel /*startLevel*/, const OpenViBE::Kernel::ELogLevel /*endLevel*/, const bool active) override
+	{
+		return activate(active);
+	}
+	bool activate(const bool active) override
+	{
+		m_active = active;
+		return true;
+	}
+
+	void log(const OpenViBE::CTime /*value*/) override { }
+#if defined __clang__
+	void log(const size_t /*value*/) override { }
+#endif
+	void log(const uint64_t /*value*/) override { }
+	void log(const uint32_t /*value*/) override { }
+	void log(const int64_t /*value*/) override { }
+	void log(const int /*value*/) override { }
+	void log(const double /*value*/) override { }
+	void log(const bool /*value*/) override { }
+	void log(const OpenViBE::CIdentifier& /*value*/) override { }
+	void log(const OpenViBE::CString& value) override { log(value.toASCIIString()); }
+	void log(const std::string& value) override { log(value.c_str()); }
+	void log(const char* value) override
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_condition.wait(lock, [this]() { return !m_held; });
+		m_counts[value]++;
+	}
+	void log(const OpenViBE::Kernel::ELogLevel /*level*/) override { }
+	void log(const OpenViBE::Kernel::ELogColor /*color*/) override { }
+
+	void hold()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_held = true;
+	}
+
+	void release()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_held = false;
+		}
+		m_condition.notify_all();
+	}
+
+	size_t getCount(const std::string& value)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_counts[value];
+	}
+
+	_IsDerivedFromClass_Final_(OpenViBE::Kernel::ILogListener, OVK_ClassId_Kernel_Log_LogListenerConsole)
+
+private:
+	std::atomic<bool> m_active { true };
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_held = false;
+	std::map<std::string, size_t> m_counts;
+};
+
+class CLogManagerTest : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		ASSERT_TRUE(m_ctx.initialize());
+		m_manager.reset(new OpenViBE::Kernel::CLogManager(*m_ctx.operator->()));
+		m_manager->activate(true);
+		m_manager->addListener(&m_listener);
+	}
+
+	void TearDown() override
+	{
+		m_manager.reset();
+		m_ctx.uninitialize();
+	}
+
+	OpenViBE::Test::ctx m_ctx;
+	std::unique_ptr<OpenViBE::Kernel::CLogManager> m_manager;
+	CTestLogListener m_listener;
+};
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(CLogManagerTest, drainOnDestruction)
+{
+	// The writer is held on the first message, the next ones wait in the queue
+	m_listener.hold();
+	for (size_t i = 0; i < 500; ++i) { *m_manager << OpenViBE::Kernel::LogLevel_Info << "queued" << "\n"; }
+	m_listener.release();
+
+	m_manager.reset();
+	EXPECT_EQ(500, m_listener.getCount("queued")) << "Messages still queued are lost when the manager is destroyed.";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(CLogManagerTest, activationWhenQueued)
+{
+	m_listener.hold();
+	for (size_t i = 0; i < 100; ++i) { *m_manager << OpenViBE::Kernel::LogLevel_Info << "active" << "\n"; }
+
+	// Messages queued before the change are written, the ones logged after are not
+	m_listener.activate(false);
+	for (size_t i = 0; i < 100; ++i) { *m_manager << OpenViBE::Kernel::LogLevel_Info << "inactive" << "\n"; }
+	m_listener.release();
+
+	m_manager->flush();
+	EXPECT_EQ(100, m_listener.getCount("active")) << "Queued messages are dropped by a listener deactivated after they were logged.";
+	EXPECT_EQ(0, m_listener.getCount("inactive")) << "Messages logged while the listener is inactive are written.";
+}
+//---------------------------------------------------------------------------------------------------
@@ -0,0 +1,136 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CLogQueueTest.hpp
+/// \brief Test Definitions for the queue of log messages of the OpenViBE kernel.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include "ovkCLogQueue.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+// The producer and the index of a message are stored in its only event
+OpenViBE::Kernel::log_message_t makeMessage(const size_t producer, const size_t index)
+{
+	OpenViBE::Kernel::log_message_t message;
+	OpenViBE::Kernel::log_event_t event;
+	event.type      = OpenViBE::Kernel::log_event_t::EType::UInteger64;
+	event.value.u64 = (uint64_t(producer) << 32) | index;
+	message.events.push_back(event);
+	return message;
+}
+}  // namespace
+
+//---------------------------------------------------------------------------------------------------
+TEST(CLogQueue_Tests, order)
+{
+	OpenViBE::Kernel::CLogQueue queue(8);
+	EXPECT_TRUE(queue.empty());
+	for (size_t i = 0; i < 5; ++i) {
+		OpenViBE::Kernel::log_message_t message = makeMessage(0, i);
+		ASSERT_TRUE(queue.push(message));
+	}
+	EXPECT_FALSE(queue.empty());
+	EXPECT_EQ(5, queue.getPushCount());
+
+	OpenViBE::Kernel::log_message_t message;
+	for (size_t i = 0; i < 5; ++i) {
+		ASSERT_TRUE(queue.pop(message));
+		ASSERT_EQ(1, message.events.size());
+		EXPECT_EQ(i, message.events[0].value.u64) << "Messages are not popped in the order they were pushed.";
+	}
+	EXPECT_FALSE(queue.pop(message));
+	EXPECT_TRUE(queue.empty());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CLogQueue_Tests, full)
+{
+	OpenViBE::Kernel::CLogQueue queue(3);	// Rounded up to 4
+
+	for (size_t i = 0; i < 4; ++i) {
+		OpenViBE::Kernel::log_message_t message = makeMessage(0, i);
+		ASSERT_TRUE(queue.push(message)) << "Message " << i << " is refused before the queue is full.";
+	}
+	OpenViBE::Kernel::log_message_t message = makeMessage(0, 4);
+	EXPECT_FALSE(queue.push(message)) << "Full queue accepts a message.";
+	ASSERT_EQ(1, message.events.size()) << "Refused message is changed.";
+	EXPECT_EQ(4, message.events[0].value.u64);
+	EXPECT_EQ(4, queue.getPushCount());
+
+	// Popping frees a cell for the refused message, which comes after the others
+	OpenViBE::Kernel::log_message_t popped;
+	ASSERT_TRUE(queue.pop(popped));
+	EXPECT_EQ(0, popped.events[0].value.u64);
+	EXPECT_TRUE(queue.push(message));
+	for (size_t i = 1; i < 5; ++i) {
+		ASSERT_TRUE(queue.pop(popped));
+		EXPECT_EQ(i, popped.events[0].value.u64);
+	}
+	EXPECT_TRUE(queue.empty());
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CLogQueue_Tests, multipleProducers)
+{
+	constexpr size_t N_PRODUCER = 4;
+	constexpr size_t N_MESSAGE  = 20000;
+
+	// A small queue, so that producers often find it full and wait for the consumer
+	OpenViBE::Kernel::CLogQueue queue(16);
+	std::vector<std::thread> producers;
+	for (size_t p = 0; p < N_PRODUCER; ++p) {
+		producers.emplace_back([&queue, p]()
+		{
+			for (size_t i = 0; i < N_MESSAGE; ++i) {
+				OpenViBE::Kernel::log_message_t message = makeMessage(p, i);
+				while (!queue.push(message)) { std::this_thread::yield(); }
+			}
+		});
+	}
+
+	std::vector<size_t> nextIndexes(N_PRODUCER, 0);
+	OpenViBE::Kernel::log_message_t message;
+	for (size_t n = 0; n < N_PRODUCER * N_MESSAGE;) {
+		if (!queue.pop(message)) {
+			std::this_thread::yield();
+			continue;
+		}
+		ASSERT_EQ(1, message.events.size());
+		const size_t producer = size_t(message.events[0].value.u64 >> 32);
+		const size_t index    = size_t(message.events[0].value.u64 & 0xFFFFFFFF);
+		ASSERT_LT(producer, N_PRODUCER);
+		ASSERT_EQ(nextIndexes[producer], index) << "Messages of producer " << producer << " are not popped in order.";
+		nextIndexes[producer]++;
+		n++;
+	}
+	for (auto& producer : producers) { producer.join(); }
+
+	EXPECT_TRUE(queue.empty());
+	EXPECT_EQ(N_PRODUCER * N_MESSAGE, queue.getPushCount());
+}
+//---------------------------------------------------------------------------------------------------
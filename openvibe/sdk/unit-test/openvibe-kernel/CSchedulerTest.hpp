@@ -0,0 +1,236 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CSchedulerTest.hpp
+/// \brief Test Definitions for the sequential and parallel modes of the OpenViBE kernel scheduler.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include "../common/ovtKernelContext.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SchedulerTest {
+// Chunks processed by each box, by box name, as they are stored when the boxes are uninitialized
+std::mutex recordMutex;
+std::map<std::string, std::vector<std::string>> records;
+
+/// <summary> Box forwarding the chunks of its inputs to some of its outputs, tagged with its name, the source box sends a chunk on each clock. </summary>
+class CRelayBox final : public OpenViBE::Plugins::IBoxAlgorithm
+{
+public:
+	CRelayBox(const bool isSource, const std::vector<std::vector<size_t>>& forwards) : m_isSource(isSource), m_forwards(forwards) { }
+	void release() override { delete this; }
+
+	uint64_t getClockFrequency(OpenViBE::Kernel::IBoxAlgorithmContext& /*ctx*/) override { return m_isSource ? 128LL << 32 : 0; }
+
+	bool uninitialize(OpenViBE::Kernel::IBoxAlgorithmContext& ctx) override
+	{
+		std::lock_guard<std::mutex> lock(recordMutex);
+		records[ctx.getStaticBoxContext()->getName().toASCIIString()] = m_records;
+		return true;
+	}
+
+	bool processClock(OpenViBE::Kernel::IBoxAlgorithmContext& ctx, OpenViBE::Kernel::CMessageClock& /*msg*/) override
+	{
+		m_hasClock = true;
+		return ctx.markAlgorithmAsReadyToProcess();
+	}
+
+	bool processInput(OpenViBE::Kernel::IBoxAlgorithmContext& ctx, const size_t /*index*/) override { return ctx.markAlgorithmAsReadyToProcess(); }
+
+	bool process(OpenViBE::Kernel::IBoxAlgorithmContext& ctx) override
+	{
+		OpenViBE::Kernel::IBoxIO& boxIO = *ctx.getDynamicBoxContext();
+		const uint64_t time             = ctx.getPlayerContext()->getCurrentTime();
+		const std::string name          = ctx.getStaticBoxContext()->getName().toASCIIString();
+
+		if (m_hasClock)
+		{
+			send(boxIO, 0, std::to_string(m_nSent++), time);
+			m_hasClock = false;
+		}
+
+		for (size_t input = 0; input < m_forwards.size(); ++input)
+		{
+			for (size_t i = 0; i < boxIO.getInputChunkCount(input); ++i)
+			{
+				const OpenViBE::CMemoryBuffer* chunk = boxIO.getInputChunk(input, i);
+				const std::string payload(reinterpret_cast<const char*>(chunk->getDirectPointer()), chunk->getSize());
+				m_records.push_back(std::to_string(time >> 22) + " " + std::to_string(input) + " " + payload);
+				for (const size_t output : m_forwards[input]) { send(boxIO, output, payload + ">" + name, time); }
+				boxIO.markInputAsDeprecated(input, i);
+			}
+		}
+		return true;
+	}
+
+	_IsDerivedFromClass_Final_(OpenViBE::Plugins::IBoxAlgorithm, OpenViBE::CIdentifier(0x5B1E0A47, 0x3C92D6F1))
+
+private:
+	static void send(OpenViBE::Kernel::IBoxIO& boxIO, const size_t output, const std::string& payload, const uint64_t time)
+	{
+		boxIO.appendOutputChunkData(output, reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+		boxIO.markOutputAsReadyToSend(output, time, time);
+	}
+
+	bool m_isSource = false;
+	bool m_hasClock = false;
+	size_t m_nSent  = 0;
+	std::vector<std::vector<size_t>> m_forwards;	// Outputs to which the chunks of each input are forwarded
+	std::vector<std::string> m_records;
+};
+
+class CRelayBoxDesc final : public OpenViBE::Plugins::IBoxAlgorithmDesc
+{
+public:
+	CRelayBoxDesc(const OpenViBE::CIdentifier& classID, const size_t nOutput, const std::vector<std::vector<size_t>>& forwards, const bool isSource = false)
+		: m_classID(classID), m_nOutput(nOutput), m_forwards(forwards), m_isSource(isSource) { }
+	void release() override { }
+
+	OpenViBE::CString getName() const override { return "Relay"; }
+	OpenViBE::CIdentifier getCreatedClass() const override { return m_classID; }
+	OpenViBE::Plugins::IPluginObject* create() override { return new CRelayBox(m_isSource, m_forwards); }
+
+	bool getBoxPrototype(OpenViBE::Kernel::IBoxProto& prototype) const override
+	{
+		for (size_t i = 0; i < m_forwards.size(); ++i) { prototype.addInput(("Input " + std::to_string(i)).c_str(), OV_TypeId_EBMLStream); }
+		for (size_t i = 0; i < m_nOutput; ++i) { prototype.addOutput(("Output " + std::to_string(i)).c_str(), OV_TypeId_EBMLStream); }
+		return true;
+	}
+
+	_IsDerivedFromClass_Final_(OpenViBE::Plugins::IBoxAlgorithmDesc, OpenViBE::CIdentifier(0x0D74B3E2, 0x6A18F95C))
+
+private:
+	OpenViBE::CIdentifier m_classID;
+	size_t m_nOutput = 0;
+	std::vector<std::vector<size_t>> m_forwards;
+	bool m_isSource = false;
+};
+}  // namespace SchedulerTest
+
+//---------------------------------------------------------------------------------------------------
+class CSchedulerTest : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		ASSERT_TRUE(m_ctx.initialize());
+		m_ctx->getPluginManager().registerPluginDesc(m_sourceDesc);
+		m_ctx->getPluginManager().registerPluginDesc(m_forwardDesc);
+		m_ctx->getPluginManager().registerPluginDesc(m_backDesc);
+		m_ctx->getPluginManager().registerPluginDesc(m_selfDesc);
+		SchedulerTest::records.clear();
+	}
+
+	void TearDown() override { m_ctx.uninitialize(); }
+
+	OpenViBE::CIdentifier addBox(OpenViBE::Kernel::IScenario& scenario, const OpenViBE::Plugins::IBoxAlgorithmDesc& desc, const std::string& name,
+								 const int priority) const
+	{
+		OpenViBE::CIdentifier boxID;
+		EXPECT_TRUE(scenario.addBox(boxID, desc, OpenViBE::CIdentifier::undefined()));
+		OpenViBE::Kernel::IBox* box = scenario.getBoxDetails(boxID);
+		box->setName(name.c_str());
+		box->addAttribute(OV_AttributeId_Box_Priority, std::to_string(priority).c_str());
+		return boxID;
+	}
+
+	// The source feeds the box A, linked to itself, and boxes C, also linked to themselves, which form a level of the parallel mode with A.
+	// A feeds B, processed after it, which links back to A.
+	std::map<std::string, std::vector<std::string>> run(const bool isParallel, const size_t nStep)
+	{
+		m_ctx->getConfigurationManager().addOrReplaceConfigurationToken("Kernel_ParallelScheduler", isParallel ? "true" : "false");
+		m_ctx->getConfigurationManager().addOrReplaceConfigurationToken("Kernel_ParallelSchedulerThreadCount", "4");
+
+		OpenViBE::CIdentifier scenarioID, linkID;
+		EXPECT_TRUE(m_ctx->getScenarioManager().createScenario(scenarioID));
+		OpenViBE::Kernel::IScenario& scenario = m_ctx->getScenarioManager().getScenario(scenarioID);
+		const OpenViBE::CIdentifier source = addBox(scenario, m_sourceDesc, "Source", 10);
+		const OpenViBE::CIdentifier a      = addBox(scenario, m_forwardDesc, "A", 8);
+		const OpenViBE::CIdentifier b      = addBox(scenario, m_backDesc, "B", 5);
+		scenario.connect(linkID, source, 0, a, 0, OpenViBE::CIdentifier::undefined());
+		scenario.connect(linkID, a, 0, b, 0, OpenViBE::CIdentifier::undefined());
+		scenario.connect(linkID, b, 0, a, 1, OpenViBE::CIdentifier::undefined());
+		scenario.connect(linkID, a, 1, a, 2, OpenViBE::CIdentifier::undefined());
+		for (int i = 0; i < 3; ++i)
+		{
+			const OpenViBE::CIdentifier c = addBox(scenario, m_selfDesc, "C" + std::to_string(i), 7 - i);
+			scenario.connect(linkID, source, 0, c, 0, OpenViBE::CIdentifier::undefined());
+			scenario.connect(linkID, c, 0, c, 1, OpenViBE::CIdentifier::undefined());
+		}
+
+		OpenViBE::CIdentifier playerID;
+		EXPECT_TRUE(m_ctx->getPlayerManager().createPlayer(playerID));
+		OpenViBE::Kernel::IPlayer& player = m_ctx->getPlayerManager().getPlayer(playerID);
+		EXPECT_TRUE(player.setScenario(scenarioID));
+		EXPECT_EQ(OpenViBE::Kernel::EPlayerReturnCodes::Success, player.initialize());
+		for (size_t i = 0; i < nStep; ++i)
+		{
+			player.step();
+			EXPECT_TRUE(player.loop(0));
+		}
+		player.stop();
+		EXPECT_TRUE(player.uninitialize());
+		m_ctx->getPlayerManager().releasePlayer(playerID);
+		m_ctx->getScenarioManager().releaseScenario(scenarioID);
+
+		std::lock_guard<std::mutex> lock(SchedulerTest::recordMutex);
+		return SchedulerTest::records;
+	}
+
+	OpenViBE::Test::ctx m_ctx;
+	SchedulerTest::CRelayBoxDesc m_sourceDesc { OpenViBE::CIdentifier(0x2F6B91C0, 0x1A7E4D53), 1, {}, true };
+	SchedulerTest::CRelayBoxDesc m_forwardDesc { OpenViBE::CIdentifier(0x4C08E2B7, 0x59D3A16F), 2, { { 0, 1 }, {}, {} } };
+	SchedulerTest::CRelayBoxDesc m_backDesc { OpenViBE::CIdentifier(0x71A5C3D9, 0x0E4B8F26), 1, { { 0 } } };
+	SchedulerTest::CRelayBoxDesc m_selfDesc { OpenViBE::CIdentifier(0x3E92F704, 0x6B1DC5A8), 1, { { 0 }, {} } };
+};
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(CSchedulerTest, parallelModeDeliversAsSequentialMode)
+{
+	const size_t nStep                                                = 16;
+	const std::map<std::string, std::vector<std::string>> sequential = run(false, nStep);
+	const std::map<std::string, std::vector<std::string>> parallel   = run(true, nStep);
+
+	ASSERT_EQ(6, sequential.size());
+	ASSERT_FALSE(sequential.at("A").empty());
+	for (const auto& box : sequential)
+	{
+		ASSERT_TRUE(parallel.find(box.first) != parallel.end()) << "Box " << box.first << " isn't run in parallel mode.";
+		EXPECT_EQ(box.second, parallel.at(box.first)) << "Box " << box.first << " doesn't receive the same chunks at the same steps in both modes.";
+	}
+
+	// A gets its own chunks on the step it sends them, and the chunks of B on the next step
+	const std::vector<std::string>& a = parallel.at("A");
+	EXPECT_TRUE(std::find(a.begin(), a.end(), "0 0 0") != a.end());
+	EXPECT_TRUE(std::find(a.begin(), a.end(), "0 2 0>A") != a.end()) << "Self link chunks are delayed.";
+	EXPECT_TRUE(std::find(a.begin(), a.end(), "0 1 0>A>B") == a.end());
+	const auto back = std::find_if(a.begin(), a.end(), [](const std::string& record) { return record.find(" 1 0>A>B") != std::string::npos; });
+	ASSERT_TRUE(back != a.end()) << "Back link chunks are lost.";
+	EXPECT_NE('0', back->front());
+}
+//---------------------------------------------------------------------------------------------------
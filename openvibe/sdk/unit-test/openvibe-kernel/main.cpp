@@ -0,0 +1,16 @@
+#include <gtest/gtest.h>
+
+// ReSharper disable CppUnusedIncludeDirective
+#include "CChunkTest.hpp"
+#include "CLogManagerTest.hpp"
+#include "CLogQueueTest.hpp"
+#include "CSchedulerTest.hpp"
+
+int main(int argc, char* argv[])
+{
+	try {
+		testing::InitGoogleTest(&argc, argv);
+		return RUN_ALL_TESTS();
+	}
+	catch (std::exception&) { return 1; }
+}
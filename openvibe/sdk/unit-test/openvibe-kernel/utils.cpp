@@ -0,0 +1,22 @@
+#include "utils.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<size_t> nAllocation { 0 };
+}  // namespace
+
+// Replaces the global allocation functions, to check that code expected not to allocate does not
+void* operator new(const size_t size)
+{
+	nAllocation++;
+	if (void* p = std::malloc(size == 0 ? 1 : size)) { return p; }
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t /*size*/) noexcept { std::free(p); }
+
+size_t getAllocationCount() { return nAllocation.load(); }
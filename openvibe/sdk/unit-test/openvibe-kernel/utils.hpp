@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstddef>
+
+/// <summary> Gets the number of heap allocations made by the test program so far. </summary>
+size_t getAllocationCount();
@@ -108,6 +108,34 @@ TEST(CSV_Reader_Test_Case, signalReaderWindowsEndlines)
 	releaseCSVHandler(csv);
 }
 
+TEST(CSV_Reader_Test_Case, signalReaderSpacedValues)
+{
+	OpenViBE::CSV::ICSVHandler* csv = OpenViBE::CSV::createCSVHandler();
+	const std::string filepath      = dataDirectory + "/testCSVSignalSpacedValues.csv";
+
+	ASSERT_TRUE(csv->openFile(filepath, OpenViBE::CSV::EFileAccessMode::Read));
+	std::vector<std::string> channelNames;
+	size_t sampling;
+	size_t nSamplePerBuffer;
+	std::vector<OpenViBE::CSV::SMatrixChunk> chunks;
+	std::vector<OpenViBE::CSV::SStimulationChunk> stimulations;
+
+	ASSERT_TRUE(csv->parseHeader());
+	ASSERT_TRUE(csv->getSignalInformation(channelNames, sampling, nSamplePerBuffer));
+	ASSERT_TRUE(csv->readSamplesAndEventsFromFile(3, chunks, stimulations));
+	ASSERT_EQ(3, chunks.size());
+	for (size_t i = 0; i < chunks.size(); ++i) { compareChunks(SIMPLE_SIGNAL_FILE.m_data[i], chunks[i]); }
+
+	ASSERT_EQ(2, stimulations.size());
+	ASSERT_EQ(33024, stimulations[0].id);
+	ASSERT_EQ(33025, stimulations[1].id);
+	ASSERT_EQ(0.125, stimulations[1].date);
+	ASSERT_EQ(0.0, stimulations[1].duration);
+
+	ASSERT_TRUE(csv->closeFile());
+	releaseCSVHandler(csv);
+}
+
 TEST(CSV_Reader_Test_Case, signalReaderNormalGoodSignal)
 {
 	OpenViBE::CSV::ICSVHandler* signalReaderTest = OpenViBE::CSV::createCSVHandler();
@@ -26,6 +26,8 @@
 #include <fstream>
 #include <streambuf>
 #include <numeric>
+#include <sstream>
+#include <limits>
 
 static std::string directoryPath = "";
 
@@ -622,6 +624,39 @@ TEST(CSV_Writer_Test_Case, stimulationsOnlyWriterGoodStims)
 	ifs.close();
 }
 
+TEST(CSV_Writer_Test_Case, matrixWriterValuesFormattedAsStreams)
+{
+	OpenViBE::CSV::ICSVHandler* handler = OpenViBE::CSV::createCSVHandler();
+	const std::string filename          = directoryPath + "testCSVMatrixWriter08.csv";
+	const std::vector<double> values    = { 0.0, -0.0, 1.0 / 3.0, -2.5e-7, 123456789.987654321, 1e300, -1e-300, 0.125, 5e-324 };
+
+	ASSERT_TRUE(handler->openFile(filename, OpenViBE::CSV::EFileAccessMode::Write));
+	handler->setFormatType(OpenViBE::CSV::EStreamType::FeatureVector);
+	handler->setOutputFloatPrecision(4);
+	ASSERT_TRUE(handler->setFeatureVectorInformation(std::vector<std::string>(values.size(), "")));
+	ASSERT_TRUE(handler->addSample({ 0.5, 0.75, values, 0 }));
+	ASSERT_TRUE(handler->addEvent(33025, 0.6, 0.05));
+	ASSERT_TRUE(handler->addEvent(33026, 0.7, 0.0));
+	ASSERT_TRUE(handler->writeHeaderToFile());
+	ASSERT_TRUE(handler->writeAllDataToFile());
+	ASSERT_TRUE(handler->closeFile());
+	releaseCSVHandler(handler);
+
+	std::stringstream expected;
+	expected.precision(4);
+	expected << std::fixed << 0.5 << "," << 0.75;
+	for (const double value : values) { expected << "," << value; }
+	expected << ",33025:33026," << 0.6 << ":" << 0.7 << "," << 0.05 << ":" << 0.0;
+
+	std::ifstream ifs(filename);
+	std::string line;
+	ifs.ignore(std::numeric_limits<std::streamsize>::max(), '\n');  // Ignore header
+	ASSERT_TRUE(std::getline(ifs, line));
+	ifs.close();
+
+	ASSERT_STREQ(line.c_str(), expected.str().c_str());
+}
+
 TEST(CSV_Writer_Test_Case, stimulationsOnlyWriterUnexpectedData)
 {
 	OpenViBE::CSV::ICSVHandler* handler = OpenViBE::CSV::createCSVHandler();
@@ -0,0 +1,127 @@
+///-------------------------------------------------------------------------------------------------
+/// 
+/// \file uoEBMLInPlaceWriterTest.cpp
+/// \copyright Copyright (C) 2022 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+/// 
+///-------------------------------------------------------------------------------------------------
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ebml/defines.h"
+#include "ebml/IWriter.h"
+#include "ebml/CWriterHelper.h"
+#include "ebml/CReader.h"
+
+#include "ovtAssert.h"
+
+#ifndef M_PI
+#define M_PI 3.1415926535897932384626433832795
+#endif
+
+namespace {
+class CWriterCallBack final : public EBML::IWriterCallBack
+{
+public:
+	void write(const void* buffer, const size_t size) override
+	{
+		m_Stream.insert(m_Stream.end(), static_cast<const char*>(buffer), static_cast<const char*>(buffer) + size);
+		m_NWrite++;
+	}
+
+	std::vector<char> m_Stream;
+	size_t m_NWrite = 0;
+};
+
+// Records the node tree with the raw data of each node
+class CReaderCallBack final : public EBML::IReaderCallBack
+{
+public:
+	bool isMasterChild(const EBML::CIdentifier& identifier) override { return identifier == EBML_Identifier_Header; }
+	void openChild(const EBML::CIdentifier& identifier) override { m_Tree << "<" << uint64_t(identifier) << ">"; }
+	void processChildData(const void* buffer, const size_t size) override { m_Tree << std::string(static_cast<const char*>(buffer), size); }
+	void closeChild() override { m_Tree << "</>"; }
+
+	std::stringstream m_Tree;
+};
+
+std::string parse(const std::vector<char>& stream)
+{
+	CReaderCallBack callback;
+	EBML::CReader reader(callback);
+	reader.processData(stream.data(), stream.size());
+	return callback.m_Tree.str();
+}
+}  // namespace
+
+int uoEBMLInPlaceWriterTest(int argc, char* argv[])
+{
+	OVT_ASSERT(argc == 3, "Failure to retrieve tests arguments. Expecting: data_dir output_dir");
+
+	// The test serializes the sequence of uoEBMLWriterTest with the in place writer
+	// and compares the parsed output to the parsed reference.
+	std::ifstream expectedStream(std::string(argv[1]) + "ref_data.ebml", std::ios::binary);
+	OVT_ASSERT(expectedStream.is_open(), "Failure to open reference stream for reading");
+	const std::vector<char> expected((std::istreambuf_iterator<char>(expectedStream)), std::istreambuf_iterator<char>());
+
+	CWriterCallBack callback;
+	EBML::IWriter* writer = EBML::createInPlaceWriter(callback);
+	EBML::CWriterHelper helper;
+
+	helper.connect(writer);
+
+	helper.openChild(EBML_Identifier_Header);
+
+	helper.openChild(EBML_Identifier_DocType);
+	helper.setStr("matroska");
+	helper.closeChild();
+
+	helper.openChild(EBML_Identifier_DocTypeVersion);
+	helper.setUInt(1);
+	helper.closeChild();
+
+	helper.openChild(EBML_Identifier_DocTypeReadVersion);
+	helper.setInt(655356);
+	helper.closeChild();
+
+	helper.closeChild();
+
+	helper.openChild(0x1234);
+	helper.setUInt(0);
+	helper.closeChild();
+
+	helper.openChild(0xffffffffffffffffLL);
+	helper.setUInt(0xff000000ff000000LL);
+	helper.closeChild();
+
+	helper.openChild(0x4321);
+	helper.setDouble(M_PI);
+	helper.closeChild();
+
+	helper.openChild(0x8765);
+	helper.setFloat(float(M_PI));
+	helper.closeChild();
+	writer->release();
+
+	OVT_ASSERT(callback.m_NWrite == 5, "Failure to write each top level node in a single call");
+	OVT_ASSERT(callback.m_Stream.size() > expected.size(), "Failure to code the size of master nodes in place");
+	OVT_ASSERT_STREQ(parse(expected), parse(callback.m_Stream), "Failure to match parsed reference to parsed in place stream");
+
+	return EXIT_SUCCESS;
+}
@@ -21,6 +21,8 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <iterator>
+#include <vector>
 
 #include "ebml/IReader.h"
 #include "ebml/CReader.h"
@@ -98,6 +100,32 @@ private:
 	EBML::CIdentifier m_CurrentID;
 };
 
+// Checks that the data of the nodes are handed out from the processed buffer itself
+class CSpanCallBack : public EBML::IReaderCallBack
+{
+public:
+	CSpanCallBack(const unsigned char* begin, const unsigned char* end) : m_begin(begin), m_end(end) { }
+
+	bool isMasterChild(const EBML::CIdentifier& identifier) override { return identifier == EBML_Identifier_Header; }
+	void openChild(const EBML::CIdentifier& /*identifier*/) override { m_NOpened++; }
+
+	void processChildData(const void* buffer, const size_t size) override
+	{
+		const unsigned char* data = static_cast<const unsigned char*>(buffer);
+		if (size && (data < m_begin || data + size > m_end)) { m_NCopied++; }
+	}
+
+	void closeChild() override { m_NClosed++; }
+
+	size_t m_NOpened = 0;
+	size_t m_NClosed = 0;
+	size_t m_NCopied = 0;
+
+private:
+	const unsigned char* m_begin = nullptr;
+	const unsigned char* m_end   = nullptr;
+};
+
 int uoEBMLReaderTest(int argc, char* argv[])
 {
 	OVT_ASSERT(argc == 3, "Failure to retrieve tests arguments. Expecting: data_dir output_dir");
@@ -153,6 +181,16 @@ int uoEBMLReaderTest(int argc, char* argv[])
 	// last check to verify the expected file has no additional line
 	OVT_ASSERT(!std::getline(generatedStream, generatedString), "Failure to match expected file size and generated file size");
 
+	// a stream processed at once is parsed in place
+	std::ifstream dataStream(dataFile, std::ios::binary);
+	const std::vector<unsigned char> data((std::istreambuf_iterator<char>(dataStream)), std::istreambuf_iterator<char>());
+	CSpanCallBack spanCallback(data.data(), data.data() + data.size());
+	EBML::CReader spanReader(spanCallback);
+	spanReader.processData(data.data(), data.size());
+
+	OVT_ASSERT(spanCallback.m_NOpened == 8 && spanCallback.m_NClosed == 8, "Failure to open and close every node of the stream");
+	OVT_ASSERT(spanCallback.m_NCopied == 0, "Failure to hand out node data from the processed buffer");
+
 
 	return EXIT_SUCCESS;
 }
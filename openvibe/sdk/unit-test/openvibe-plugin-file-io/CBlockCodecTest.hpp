@@ -0,0 +1,195 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CBlockCodecTest.hpp
+/// \brief Test Definitions for the compression of the blocks of chunks of .ov files.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include "ovpCBlockCodec.h"
+#include "../../ovp_defines.h"
+
+#include <ebml/CWriter.h>
+#include <ebml/CWriterHelper.h>
+#include <toolkit/ovtk_defines.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+class CByteWriter final : public EBML::IWriterCallback
+{
+public:
+	explicit CByteWriter(std::vector<uint8_t>& bytes) : m_bytes(bytes) { }
+	void write(const void* buffer, const size_t size) override
+	{
+		m_bytes.insert(m_bytes.end(), reinterpret_cast<const uint8_t*>(buffer), reinterpret_cast<const uint8_t*>(buffer) + size);
+	}
+
+private:
+	std::vector<uint8_t>& m_bytes;
+};
+
+// The buffer node of a file holding a stream chunk, as the generic stream writer groups them in blocks
+void appendBuffer(std::vector<uint8_t>& block, const size_t stream, const uint64_t time, const std::vector<uint8_t>& content)
+{
+	CByteWriter callback(block);
+	EBML::CWriter writer(callback);
+	EBML::CWriterHelper helper;
+	helper.connect(&writer);
+	helper.openChild(OVP_NodeId_OpenViBEStream_Buffer);
+	helper.openChild(OVP_NodeId_OpenViBEStream_Buffer_StreamIndex);
+	helper.setUInt(stream);
+	helper.closeChild();
+	helper.openChild(OVP_NodeId_OpenViBEStream_Buffer_StartTime);
+	helper.setUInt(time);
+	helper.closeChild();
+	helper.openChild(OVP_NodeId_OpenViBEStream_Buffer_EndTime);
+	helper.setUInt(time + 1);
+	helper.closeChild();
+	helper.openChild(OVP_NodeId_OpenViBEStream_Buffer_Content);
+	helper.setBinary(content.data(), content.size());
+	helper.closeChild();
+	helper.closeChild();
+	helper.disconnect();
+}
+
+// A streamed matrix chunk, its raw buffer is usually not aligned on 8 bytes within the block
+std::vector<uint8_t> matrixChunk(const std::vector<double>& values, const size_t rawSize)
+{
+	std::vector<uint8_t> chunk;
+	CByteWriter callback(chunk);
+	EBML::CWriter writer(callback);
+	EBML::CWriterHelper helper;
+	helper.connect(&writer);
+	helper.openChild(OVTK_NodeId_Buffer);
+	helper.openChild(OVTK_NodeId_Buffer_StreamedMatrix);
+	helper.openChild(OVTK_NodeId_Buffer_StreamedMatrix_RawBuffer);
+	helper.setBinary(values.data(), rawSize);
+	helper.closeChild();
+	helper.closeChild();
+	helper.closeChild();
+	helper.disconnect();
+	return chunk;
+}
+
+// Signal chunks, an odd sized chunk of another stream and a raw buffer whose size is not a multiple of 8 bytes
+std::vector<uint8_t> makeBlock(const size_t nChunk)
+{
+	std::vector<uint8_t> block;
+	std::vector<double> values(4 * 32);
+	for (size_t i = 0; i < nChunk; ++i)
+	{
+		for (size_t j = 0; j < values.size(); ++j) { values[j] = std::sin(double(i * values.size() + j) / 10.0) * 100.0; }
+		appendBuffer(block, 0, i, matrixChunk(values, values.size() * sizeof(double)));
+		if (i % 3 == 0) { appendBuffer(block, 1, i, { 1, 2, 3, 4, 5 }); }
+	}
+	appendBuffer(block, 2, nChunk, matrixChunk(values, 13));
+	return block;
+}
+}  // namespace
+
+//---------------------------------------------------------------------------------------------------
+TEST(CBlockCodec_Test, roundTrip)
+{
+	OpenViBE::Plugins::FileIO::CBlockCodec encoder, decoder;
+	std::vector<uint8_t> encoded, decoded;
+
+	// The codecs are used for several blocks in a row, as by the writer and the reader
+	for (const size_t nChunk : { 64, 5, 1 })
+	{
+		const std::vector<uint8_t> block = makeBlock(nChunk);
+		ASSERT_TRUE(encoder.encode(block.data(), block.size(), encoded));
+		EXPECT_LT(encoded.size(), block.size());
+		ASSERT_TRUE(decoder.decode(encoded.data(), encoded.size(), block.size(), decoded));
+		EXPECT_EQ(block, decoded) << "Block of " << nChunk << " chunks isn't decoded as encoded.";
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CBlockCodec_Test, onlyRawBuffersAreShuffled)
+{
+	const std::vector<uint8_t> block = makeBlock(1);
+	const std::vector<uint8_t> chunk = matrixChunk(std::vector<double>(4 * 32), 4 * 32 * sizeof(double));
+	OpenViBE::Plugins::FileIO::CBlockCodec codec;
+	std::vector<uint8_t> encoded;
+	ASSERT_TRUE(codec.encode(block.data(), block.size(), encoded));
+
+	std::vector<uint8_t> deflated(block.size());
+	uLongf size = uLongf(deflated.size());
+	ASSERT_EQ(Z_OK, uncompress(deflated.data(), &size, encoded.data(), uLong(encoded.size())));
+	ASSERT_EQ(block.size(), size);
+
+	// The block starts with the nodes of the first chunk up to its raw buffer, then come its samples grouped by byte weight
+	const size_t rawSize = 4 * 32 * sizeof(double);
+	const size_t header  = size_t(std::search(block.begin(), block.end(), chunk.begin(), chunk.end() - rawSize) - block.begin()) + chunk.size() - rawSize;
+	ASSERT_LT(header, block.size());
+	EXPECT_TRUE(std::equal(block.begin(), block.begin() + header, deflated.begin())) << "The nodes around the raw buffers are changed.";
+	for (size_t i = 0; i < rawSize / sizeof(double); ++i) { EXPECT_EQ(block[header + i * sizeof(double)], deflated[header + i]) << "Sample " << i << " isn't shuffled."; }
+	const size_t end = header + rawSize;
+	EXPECT_TRUE(std::equal(block.begin() + end, block.end(), deflated.begin() + end)) << "The nodes after the raw buffer are changed.";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CBlockCodec_Test, oddSizedBlocks)
+{
+	// Bytes which are not nodes are compressed as they are, whatever their size
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<int> distribution(0, 255);
+	OpenViBE::Plugins::FileIO::CBlockCodec codec;
+	std::vector<uint8_t> encoded, decoded;
+
+	for (const size_t size : { 0, 1, 7, 9, 1001, 65537 })
+	{
+		std::vector<uint8_t> block(size);
+		for (auto& byte : block) { byte = uint8_t(distribution(generator)); }
+		ASSERT_TRUE(codec.encode(block.data(), block.size(), encoded));
+		ASSERT_TRUE(codec.decode(encoded.data(), encoded.size(), block.size(), decoded));
+		EXPECT_EQ(block, decoded) << "Block of " << size << " bytes isn't decoded as encoded.";
+	}
+
+	// A block cut within a node keeps the raw buffers of its whole nodes shuffled
+	std::vector<uint8_t> block = makeBlock(3);
+	block.resize(block.size() - 3);
+	ASSERT_TRUE(codec.encode(block.data(), block.size(), encoded));
+	ASSERT_TRUE(codec.decode(encoded.data(), encoded.size(), block.size(), decoded));
+	EXPECT_EQ(block, decoded);
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CBlockCodec_Test, corruptedBlock)
+{
+	const std::vector<uint8_t> block = makeBlock(8);
+	OpenViBE::Plugins::FileIO::CBlockCodec codec;
+	std::vector<uint8_t> encoded, decoded;
+	ASSERT_TRUE(codec.encode(block.data(), block.size(), encoded));
+
+	EXPECT_FALSE(codec.decode(encoded.data(), encoded.size(), block.size() + 1, decoded)) << "Wrong decoded size isn't detected.";
+	EXPECT_FALSE(codec.decode(encoded.data(), encoded.size() / 2, block.size(), decoded)) << "Truncated block isn't detected.";
+}
+//---------------------------------------------------------------------------------------------------
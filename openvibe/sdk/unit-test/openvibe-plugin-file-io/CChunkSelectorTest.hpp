@@ -0,0 +1,136 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CChunkSelectorTest.hpp
+/// \brief Test Definitions for the selection of the chunks of .ov files in a time range.
+/// \author Inria.
+/// \version 1.0.
+/// \date Sat October 17 2026.
+/// \copyright Copyright (C) 2026 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include "ovpCChunkSelector.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+struct SChunk
+{
+	size_t stream;
+	uint64_t startTime;
+	uint64_t endTime;
+};
+
+// Stream 0 has chunks of 1 second and stream 1 of 4 seconds, interleaved by end time as the writer stores them
+std::vector<SChunk> interleavedChunks(const uint64_t duration)
+{
+	std::vector<SChunk> chunks;
+	for (uint64_t t = 0; t < duration; ++t) { chunks.push_back({ 0, t, t + 1 }); }
+	for (uint64_t t = 0; t < duration; t += 4) { chunks.push_back({ 1, t, t + 4 }); }
+	std::stable_sort(chunks.begin(), chunks.end(), [](const SChunk& a, const SChunk& b) { return a.endTime < b.endTime; });
+	return chunks;
+}
+
+// Selects the chunks in file order until the selector tells the reading ends
+std::vector<SChunk> read(OpenViBE::Plugins::FileIO::CChunkSelector& selector, const std::vector<SChunk>& chunks, size_t& nRead)
+{
+	std::vector<SChunk> selected;
+	for (nRead = 0; nRead < chunks.size() && !selector.hasEnded(); ++nRead)
+	{
+		const SChunk& chunk = chunks[nRead];
+		if (selector.select(chunk.stream, chunk.startTime, chunk.endTime)) { selected.push_back(chunk); }
+	}
+	return selected;
+}
+
+bool contains(const std::vector<SChunk>& chunks, const size_t stream, const uint64_t startTime)
+{
+	return std::any_of(chunks.begin(), chunks.end(), [&](const SChunk& chunk) { return chunk.stream == stream && chunk.startTime == startTime; });
+}
+}  // namespace
+
+//---------------------------------------------------------------------------------------------------
+TEST(CChunkSelector_Test, endTimeWithInterleavedStreams)
+{
+	// Stream 0 goes past the end time with its chunk [10, 11], stored before the chunk [8, 12] of stream 1
+	const std::vector<SChunk> chunks = interleavedChunks(20);
+	OpenViBE::Plugins::FileIO::CChunkSelector selector;
+	selector.setRange(0, 10);
+	selector.reset(2);
+
+	size_t nRead                        = 0;
+	const std::vector<SChunk> selected = read(selector, chunks, nRead);
+	EXPECT_TRUE(contains(selected, 1, 8)) << "The last chunk of the stream with longer chunks is lost.";
+	for (uint64_t t = 0; t < 10; ++t) { EXPECT_TRUE(contains(selected, 0, t)); }
+	EXPECT_FALSE(contains(selected, 0, 10));
+	EXPECT_FALSE(contains(selected, 1, 12));
+	EXPECT_EQ(13, selected.size());
+
+	// Without index, the reading ends once both streams have gone past the end time
+	EXPECT_TRUE(selector.hasEnded());
+	EXPECT_EQ(chunks[nRead - 1].stream, 1);
+	EXPECT_EQ(chunks[nRead - 1].startTime, 12);
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CChunkSelector_Test, endTimeWithMaxDuration)
+{
+	// A stream without chunk past the end time does not keep the whole file from being read when the longest chunk is known
+	std::vector<SChunk> chunks = interleavedChunks(40);
+	chunks.insert(chunks.begin(), { 2, 0, 0 });
+	OpenViBE::Plugins::FileIO::CChunkSelector selector;
+	selector.setRange(0, 10);
+	selector.setMaxDuration(4);
+	selector.reset(3);
+
+	size_t nRead                        = 0;
+	const std::vector<SChunk> selected = read(selector, chunks, nRead);
+	EXPECT_TRUE(contains(selected, 1, 8));
+	EXPECT_TRUE(contains(selected, 2, 0));
+	EXPECT_EQ(14, selected.size());
+	EXPECT_TRUE(selector.hasEnded());
+	EXPECT_LT(nRead, chunks.size());
+	EXPECT_GE(chunks[nRead - 1].startTime, 14) << "The reading ends before a chunk overlapping the end time can be stored.";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CChunkSelector_Test, startTime)
+{
+	const std::vector<SChunk> chunks = interleavedChunks(20);
+	OpenViBE::Plugins::FileIO::CChunkSelector selector;
+	selector.setRange(10, 0);
+	selector.reset(2);
+
+	size_t nRead                        = 0;
+	const std::vector<SChunk> selected = read(selector, chunks, nRead);
+	EXPECT_EQ(chunks.size(), nRead);
+	EXPECT_FALSE(selector.hasEnded());
+
+	// The first chunk of each stream holds its header, the chunk [8, 12] overlaps the start time
+	EXPECT_TRUE(contains(selected, 0, 0));
+	EXPECT_TRUE(contains(selected, 1, 0));
+	EXPECT_TRUE(contains(selected, 1, 8));
+	EXPECT_FALSE(contains(selected, 0, 9));
+	EXPECT_TRUE(contains(selected, 0, 10));
+	EXPECT_EQ(2 + 10 + 3, selected.size());
+}
+//---------------------------------------------------------------------------------------------------
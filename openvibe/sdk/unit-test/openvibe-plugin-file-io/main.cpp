@@ -0,0 +1,14 @@
+#include <gtest/gtest.h>
+
+// ReSharper disable CppUnusedIncludeDirective
+#include "CBlockCodecTest.hpp"
+#include "CChunkSelectorTest.hpp"
+
+int main(int argc, char* argv[])
+{
+	try {
+		testing::InitGoogleTest(&argc, argv);
+		return RUN_ALL_TESTS();
+	}
+	catch (std::exception&) { return 1; }
+}
@@ -8,10 +8,54 @@
 #include <openvibe/ov_all.h>
 
 #include <ovp_global_defines.h>
+#include <toolkit/ovtk_defines.h>
+
+#include <ebml/CWriter.h>
+#include <ebml/CWriterHelper.h>
 
 namespace {
 const char* kernelConfig = nullptr;
 
+class CMemoryBufferWriter final : public EBML::IWriterCallback
+{
+public:
+	explicit CMemoryBufferWriter(OpenViBE::CMemoryBuffer& buffer) : m_buffer(buffer) { }
+	void write(const void* buffer, const size_t size) override { m_buffer.append(reinterpret_cast<const uint8_t*>(buffer), size); }
+
+private:
+	OpenViBE::CMemoryBuffer& m_buffer;
+};
+
+// A buffer chunk as the encoder writes it, with an unknown node before the matrix and after the raw buffer when asked
+void writeBufferChunk(OpenViBE::CMemoryBuffer& chunk, const OpenViBE::CMatrix& matrix, const bool extraNodes)
+{
+	chunk.setSize(0, true);
+	CMemoryBufferWriter callback(chunk);
+	EBML::CWriter writer(callback);
+	EBML::CWriterHelper helper;
+	helper.connect(&writer);
+	helper.openChild(OVTK_NodeId_Buffer);
+	if (extraNodes)
+	{
+		helper.openChild(EBML::CIdentifier(0x00123456, 0x789ABCDE));
+		helper.setUInt(42);
+		helper.closeChild();
+	}
+	helper.openChild(OVTK_NodeId_Buffer_StreamedMatrix);
+	helper.openChild(OVTK_NodeId_Buffer_StreamedMatrix_RawBuffer);
+	helper.setBinary(matrix.getBuffer(), matrix.getBufferElementCount() * sizeof(double));
+	helper.closeChild();
+	if (extraNodes)
+	{
+		helper.openChild(EBML::CIdentifier(0x00654321, 0x0EDCBA98));
+		helper.setBinary("extra", 5);
+		helper.closeChild();
+	}
+	helper.closeChild();
+	helper.closeChild();
+	helper.disconnect();
+}
+
 class StreamedMatrixTest : public testing::Test
 {
 protected:
@@ -127,6 +171,100 @@ TEST_F(StreamedMatrixTest, matrix_encoded_and_then_decoded_is_identical_to_origi
 	EXPECT_TRUE(encoder.uninitialize());
 	EXPECT_TRUE(decoder.uninitialize());
 }
+TEST_F(StreamedMatrixTest, buffer_chunks_with_the_encoder_layout_are_decoded)
+{
+	auto& encoder = m_kernelCtx->getAlgorithmManager().getAlgorithm(m_encoderId);
+	auto& decoder = m_kernelCtx->getAlgorithmManager().getAlgorithm(m_decoderId);
+	EXPECT_TRUE(encoder.initialize());
+	EXPECT_TRUE(decoder.initialize());
+	OpenViBE::CMatrix mat(4, 16);
+	OpenViBE::CMemoryBuffer encoded;
+
+	OpenViBE::Kernel::TParameterHandler<const OpenViBE::CMatrix*> iMatrix(
+		encoder.getInputParameter(OVP_GD_Algorithm_StreamedMatrixEncoder_InputParameterId_Matrix));
+	OpenViBE::Kernel::TParameterHandler<const OpenViBE::CMemoryBuffer*> oBuffer(
+		encoder.getOutputParameter(OVP_GD_Algorithm_StreamedMatrixEncoder_OutputParameterId_EncodedMemoryBuffer));
+	OpenViBE::Kernel::TParameterHandler<const OpenViBE::CMemoryBuffer*> iBuffer(
+		decoder.getInputParameter(OVP_GD_Algorithm_StreamedMatrixDecoder_InputParameterId_MemoryBufferToDecode));
+	OpenViBE::Kernel::TParameterHandler<const OpenViBE::CMatrix*> oMatrix(
+		decoder.getOutputParameter(OVP_GD_Algorithm_StreamedMatrixDecoder_OutputParameterId_Matrix));
+
+	// The encoder appends to its output, which is emptied before each chunk as when it is sent by a box
+	iMatrix = &mat;
+	oBuffer = &encoded;
+	iBuffer = &encoded;
+
+	encoder.process(OVP_GD_Algorithm_StreamedMatrixEncoder_InputTriggerId_EncodeHeader);
+	decoder.process();
+	EXPECT_TRUE(decoder.isOutputTriggerActive(OVP_GD_Algorithm_StreamedMatrixDecoder_OutputTriggerId_ReceivedHeader));
+
+	// The first buffer chunk gives the layout of the next ones, which are copied straight from it
+	for (size_t chunk = 0; chunk < 3; ++chunk) {
+		for (size_t i = 0; i < mat.getBufferElementCount(); ++i) { mat.getBuffer()[i] = double(chunk * 1000 + i); }
+		encoded.setSize(0, true);
+		encoder.process(OVP_GD_Algorithm_StreamedMatrixEncoder_InputTriggerId_EncodeBuffer);
+		decoder.process();
+		EXPECT_TRUE(decoder.isOutputTriggerActive(OVP_GD_Algorithm_StreamedMatrixDecoder_OutputTriggerId_ReceivedBuffer));
+		EXPECT_FALSE(decoder.isOutputTriggerActive(OVP_GD_Algorithm_StreamedMatrixDecoder_OutputTriggerId_ReceivedHeader));
+		ASSERT_EQ(mat.getBufferElementCount(), oMatrix->getBufferElementCount());
+		for (size_t i = 0; i < mat.getBufferElementCount(); ++i) {
+			EXPECT_EQ(mat.getBuffer()[i], oMatrix->getBuffer()[i]) << "Sample " << i << " of chunk " << chunk << " isn't decoded.";
+		}
+	}
+
+	encoded.setSize(0, true);
+	encoder.process(OVP_GD_Algorithm_StreamedMatrixEncoder_InputTriggerId_EncodeEnd);
+	decoder.process();
+	EXPECT_TRUE(decoder.isOutputTriggerActive(OVP_GD_Algorithm_StreamedMatrixDecoder_OutputTriggerId_ReceivedEnd));
+	EXPECT_FALSE(decoder.isOutputTriggerActive(OVP_GD_Algorithm_StreamedMatrixDecoder_OutputTriggerId_ReceivedBuffer));
+
+	EXPECT_TRUE(encoder.uninitialize());
+	EXPECT_TRUE(decoder.uninitialize());
+}
+
+TEST_F(StreamedMatrixTest, buffer_chunks_with_unexpected_nodes_are_decoded_by_the_ebml_reader)
+{
+	auto& encoder = m_kernelCtx->getAlgorithmManager().getAlgorithm(m_encoderId);
+	auto& decoder = m_kernelCtx->getAlgorithmManager().getAlgorithm(m_decoderId);
+	EXPECT_TRUE(encoder.initialize());
+	EXPECT_TRUE(decoder.initialize());
+	OpenViBE::CMatrix mat(2, 8);
+	OpenViBE::CMemoryBuffer chunk;
+
+	OpenViBE::Kernel::TParameterHandler<const OpenViBE::CMatrix*> iMatrix(
+		encoder.getInputParameter(OVP_GD_Algorithm_StreamedMatrixEncoder_InputParameterId_Matrix));
+	OpenViBE::Kernel::TParameterHandler<const OpenViBE::CMemoryBuffer*> oBuffer(
+		encoder.getOutputParameter(OVP_GD_Algorithm_StreamedMatrixEncoder_OutputParameterId_EncodedMemoryBuffer));
+	OpenViBE::Kernel::TParameterHandler<const OpenViBE::CMemoryBuffer*> iBuffer(
+		decoder.getInputParameter(OVP_GD_Algorithm_StreamedMatrixDecoder_InputParameterId_MemoryBufferToDecode));
+	OpenViBE::Kernel::TParameterHandler<const OpenViBE::CMatrix*> oMatrix(
+		decoder.getOutputParameter(OVP_GD_Algorithm_StreamedMatrixDecoder_OutputParameterId_Matrix));
+
+	iMatrix = &mat;
+	iBuffer.setReferenceTarget(oBuffer);
+	encoder.process(OVP_GD_Algorithm_StreamedMatrixEncoder_InputTriggerId_EncodeHeader);
+	decoder.process();
+	EXPECT_TRUE(decoder.isOutputTriggerActive(OVP_GD_Algorithm_StreamedMatrixDecoder_OutputTriggerId_ReceivedHeader));
+	iBuffer.clearReferenceTarget();
+	iBuffer = &chunk;
+
+	// Chunks with and without extra nodes alternate, so that the layout known from the previous chunk never matches twice in a row
+	for (size_t n = 0; n < 4; ++n) {
+		const bool extraNodes = n % 2 == 0;
+		for (size_t i = 0; i < mat.getBufferElementCount(); ++i) { mat.getBuffer()[i] = double(n * 100 + i) + 0.5; }
+		writeBufferChunk(chunk, mat, extraNodes);
+		decoder.process();
+		EXPECT_TRUE(decoder.isOutputTriggerActive(OVP_GD_Algorithm_StreamedMatrixDecoder_OutputTriggerId_ReceivedBuffer))
+			<< "Chunk " << n << (extraNodes ? " with" : " without") << " extra nodes isn't decoded.";
+		ASSERT_EQ(mat.getBufferElementCount(), oMatrix->getBufferElementCount());
+		for (size_t i = 0; i < mat.getBufferElementCount(); ++i) {
+			EXPECT_EQ(mat.getBuffer()[i], oMatrix->getBuffer()[i]) << "Sample " << i << " of chunk " << n << " isn't decoded.";
+		}
+	}
+
+	EXPECT_TRUE(encoder.uninitialize());
+	EXPECT_TRUE(decoder.uninitialize());
+}
 }	// namespace
 
 int uoStreamedMatrixTest(int argc, char* argv[])
@@ -0,0 +1,93 @@
+///-------------------------------------------------------------------------------------------------
+/// 
+/// \file CMemoryBufferTest.hpp
+/// \brief Test Definitions for OpenViBE CMemoryBuffer Class.
+/// \copyright Copyright (C) 2022 Inria
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+///
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+/// 
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include <openvibe/CMemoryBuffer.hpp>
+
+#include <memory>
+#include <utility>
+
+//---------------------------------------------------------------------------------------------------
+TEST(CMemoryBuffer_Tests, append)
+{
+	OpenViBE::CMemoryBuffer res;
+	for (size_t i = 0; i < 1000; ++i) {
+		const uint8_t value = uint8_t(i);
+		ASSERT_TRUE(res.append(&value, 1)) << "Append failed.";
+	}
+	ASSERT_EQ(1000, res.getSize()) << "Appended buffer doesn't have 1000 bytes.";
+	for (size_t i = 0; i < 1000; ++i) { ASSERT_EQ(uint8_t(i), res[i]) << "Appended byte " << i << " is wrong."; }
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CMemoryBuffer_Tests, copy)
+{
+	const uint8_t values[] = { 1, 2, 3, 4 };
+	OpenViBE::CMemoryBuffer ref(values, 4);
+	OpenViBE::CMemoryBuffer res(values, 2);
+	res = ref;
+	ASSERT_EQ(4, res.getSize()) << "Copy doesn't have the size of the copied buffer.";
+	EXPECT_NE(ref.getDirectPointer(), res.getDirectPointer()) << "Copy shares the storage of the copied buffer.";
+	for (size_t i = 0; i < 4; ++i) { EXPECT_EQ(values[i], res[i]) << "Copied byte " << i << " is wrong."; }
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CMemoryBuffer_Tests, move)
+{
+	const uint8_t values[] = { 1, 2, 3, 4 };
+	OpenViBE::CMemoryBuffer ref(values, 4);
+	const uint8_t* storage = ref.getDirectPointer();
+
+	OpenViBE::CMemoryBuffer res(std::move(ref));
+	EXPECT_EQ(storage, res.getDirectPointer()) << "Move constructor doesn't take the storage.";
+	EXPECT_EQ(4, res.getSize()) << "Move constructor doesn't take the size.";
+	EXPECT_EQ(0, ref.getSize()) << "Move constructor doesn't leave the moved buffer empty.";
+
+	OpenViBE::CMemoryBuffer other;
+	other = std::move(res);
+	EXPECT_EQ(storage, other.getDirectPointer()) << "Move assignment doesn't take the storage.";
+	EXPECT_EQ(0, res.getSize()) << "Move assignment doesn't leave the moved buffer empty.";
+	for (size_t i = 0; i < 4; ++i) { EXPECT_EQ(values[i], other[i]) << "Moved byte " << i << " is wrong."; }
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST(CMemoryBuffer_Tests, pool)
+{
+	const uint8_t* storage = nullptr;
+	{
+		OpenViBE::CMemoryBuffer res;
+		res.setPooled(true);
+		ASSERT_TRUE(res.setSize(1000, true)) << "Pooled buffer can't be resized.";
+		storage = res.getDirectPointer();
+	}
+
+	// Same size class, the storage released by the previous buffer is reused
+	auto res = std::make_unique<OpenViBE::CMemoryBuffer>();
+	res->setPooled(true);
+	ASSERT_TRUE(res->setSize(600, true)) << "Pooled buffer can't be resized.";
+	EXPECT_EQ(storage, res->getDirectPointer()) << "Pooled buffer doesn't reuse the released storage.";
+}
+//---------------------------------------------------------------------------------------------------